@@ -85,6 +85,33 @@ struct NavStruct {
 	float accel_bias[3];
 } Nav;
 
+//  Complete state of one 13 state INS/GPS filter, several can be run side by side
+struct INSGPSFilter {
+	float F[13][13], G[13][9], H[10][13];	// linearized system matrices, unset elements must stay zero
+	float Be[3];		// local magnetic unit vector in NED frame
+	float P[13][13], X[13];	// covariance matrix and state vector
+	float Q[9], R[10];	// input noise and measurement noise variances
+	float K[13][10];	// feedback gain matrix
+	struct NavStruct Nav;	// current solution of this filter
+};
+
+//  Instance Function Prototypes, the functions above operate on a default instance
+void INSGPSFilterInit(struct INSGPSFilter *ins);
+void INSGPSFilterStatePrediction(struct INSGPSFilter *ins, float gyro_data[3], float accel_data[3], float dT);
+void INSGPSFilterCovariancePrediction(struct INSGPSFilter *ins, float dT);
+void INSGPSFilterCorrection(struct INSGPSFilter *ins, float mag_data[3], float Pos[3],
+			     float Vel[3], float BaroAlt, uint16_t SensorsUsed);
+
+void INSGPSFilterResetP(struct INSGPSFilter *ins, float PDiag[13]);
+void INSGPSFilterSetState(struct INSGPSFilter *ins, float pos[3], float vel[3], float q[4], float gyro_bias[3], float accel_bias[3]);
+void INSGPSFilterSetPosVelVar(struct INSGPSFilter *ins, float PosVar, float VelVar);
+void INSGPSFilterSetGyroBias(struct INSGPSFilter *ins, float gyro_bias[3]);
+void INSGPSFilterSetAccelVar(struct INSGPSFilter *ins, float accel_var[3]);
+void INSGPSFilterSetGyroVar(struct INSGPSFilter *ins, float gyro_var[3]);
+void INSGPSFilterSetMagNorth(struct INSGPSFilter *ins, float B[3]);
+void INSGPSFilterSetMagVar(struct INSGPSFilter *ins, float scaled_mag_var[3]);
+void INSGPSFilterPosVelReset(struct INSGPSFilter *ins, float pos[3], float vel[3]);
+
 /**
  * @}
  * @}
@@ -40,8 +40,8 @@
 #define NUMU 6			// number of deterministic inputs, U is the input vector
 
 #if defined(GENERAL_COV)
-// This might trick people so I have a note here.  There is a slower but bigger version of the 
-// code here but won't fit when debugging disabled (requires -Os)
+// This might trick people so I have a note here.  There is a generic, smaller but slower
+// version of the covariance prediction here, mostly useful for host side experiments
 #define COVARIANCE_PREDICTION_GENERAL
 #endif
 
@@ -50,7 +50,7 @@ void CovariancePrediction(float F[NUMX][NUMX], float G[NUMX][NUMW],
 			  float Q[NUMW], float dT, float P[NUMX][NUMX]);
 void SerialUpdate(float H[NUMV][NUMX], float R[NUMV], float Z[NUMV],
 		  float Y[NUMV], float P[NUMX][NUMX], float X[NUMX],
-		  uint16_t SensorsUsed);
+		  float K[NUMX][NUMV], uint16_t SensorsUsed);
 void RungeKutta(float X[NUMX], float U[NUMU], float dT);
 void StateEq(float X[NUMX], float U[NUMU], float Xdot[NUMX]);
 void LinearizeFG(float X[NUMX], float U[NUMU], float F[NUMX][NUMX],
@@ -59,12 +59,7 @@ void MeasurementEq(float X[NUMX], float Be[3], float Y[NUMV]);
 void LinearizeH(float X[NUMX], float Be[3], float H[NUMV][NUMX]);
 
 // Private variables
-float F[NUMX][NUMX], G[NUMX][NUMW], H[NUMV][NUMX];	// linearized system matrices
-													// global to init to zero and maintain zero elements
-float Be[3];			// local magnetic unit vector in NED frame
-float P[NUMX][NUMX], X[NUMX];	// covariance matrix and state vector
-float Q[NUMW], R[NUMV];		// input noise and measurement noise variances
-float K[NUMX][NUMV];		// feedback gain matrix
+static struct INSGPSFilter defaultFilter;	// filter behind the single instance API (INSGPSInit() etc)
 
 //  *************  Exposed Functions ****************
 //  *************************************************
@@ -74,57 +69,57 @@ uint16_t ins_get_num_states()
 	return NUMX;
 }
 
-void INSGPSInit()		//pretty much just a place holder for now
+void INSGPSFilterInit(struct INSGPSFilter *ins)
 {
-	Be[0] = 1.0f;
-	Be[1] = 0.0f;
-	Be[2] = 0.0f;		// local magnetic unit vector
+	ins->Be[0] = 1.0f;
+	ins->Be[1] = 0.0f;
+	ins->Be[2] = 0.0f;		// local magnetic unit vector
 
 	for (int i = 0; i < NUMX; i++) {
 		for (int j = 0; j < NUMX; j++) {
-			P[i][j] = 0.0f; // zero all terms
-			F[i][j] = 0.0f;
+			ins->P[i][j] = 0.0f; // zero all terms
+			ins->F[i][j] = 0.0f;
 		}
 		
 		for (int j = 0; j < NUMW; j++)
-			G[i][j] = 0.0f;
+			ins->G[i][j] = 0.0f;
 			
 		for (int j = 0; j < NUMV; j++) {
-			H[j][i] = 0.0f;
-			K[i][j] = 0.0f;
+			ins->H[j][i] = 0.0f;
+			ins->K[i][j] = 0.0f;
 		}
 			
-		X[i] = 0.0f;
+		ins->X[i] = 0.0f;
 	}
 	for (int i = 0; i < NUMW; i++)
-		Q[i] = 0.0f;
+		ins->Q[i] = 0.0f;
 	for (int i = 0; i < NUMV; i++) 
-		R[i] = 0.0f;
+		ins->R[i] = 0.0f;
 
 	
-	P[0][0] = P[1][1] = P[2][2] = 25.0f;            // initial position variance (m^2)
-	P[3][3] = P[4][4] = P[5][5] = 5.0f;             // initial velocity variance (m/s)^2
-	P[6][6] = P[7][7] = P[8][8] = P[9][9] = 1e-5f;  // initial quaternion variance
-	P[10][10] = P[11][11] = P[12][12] = 1e-9f;      // initial gyro bias variance (rad/s)^2
-
-	X[0] = X[1] = X[2] = X[3] = X[4] = X[5] = 0.0f;	// initial pos and vel (m)
-	X[6] = 1.0f;
-	X[7] = X[8] = X[9] = 0.0f;	    // initial quaternion (level and North) (m/s)
-	X[10] = X[11] = X[12] = 0.0f;	// initial gyro bias (rad/s)
-
-	Q[0] = Q[1] = Q[2] = 50e-4f;	// gyro noise variance (rad/s)^2
-	Q[3] = Q[4] = Q[5] = 0.00001f;	// accelerometer noise variance (m/s^2)^2
-	Q[6] = Q[7] = Q[8] = 2e-8f;	    // gyro bias random walk variance (rad/s^2)^2
-
-	R[0] = R[1] = 0.004f;	// High freq GPS horizontal position noise variance (m^2)
-	R[2] = 0.036f;          // High freq GPS vertical position noise variance (m^2)
-	R[3] = R[4] = 0.004f;   // High freq GPS horizontal velocity noise variance (m/s)^2
-	R[5] = 100.0f;          // High freq GPS vertical velocity noise variance (m/s)^2
-	R[6] = R[7] = R[8] = 0.005f;    // magnetometer unit vector noise variance
-	R[9] = .05f;                    // High freq altimeter noise variance (m^2)
+	ins->P[0][0] = ins->P[1][1] = ins->P[2][2] = 25.0f;            // initial position variance (m^2)
+	ins->P[3][3] = ins->P[4][4] = ins->P[5][5] = 5.0f;             // initial velocity variance (m/s)^2
+	ins->P[6][6] = ins->P[7][7] = ins->P[8][8] = ins->P[9][9] = 1e-5f;  // initial quaternion variance
+	ins->P[10][10] = ins->P[11][11] = ins->P[12][12] = 1e-9f;      // initial gyro bias variance (rad/s)^2
+
+	ins->X[0] = ins->X[1] = ins->X[2] = ins->X[3] = ins->X[4] = ins->X[5] = 0.0f;	// initial pos and vel (m)
+	ins->X[6] = 1.0f;
+	ins->X[7] = ins->X[8] = ins->X[9] = 0.0f;	    // initial quaternion (level and North) (m/s)
+	ins->X[10] = ins->X[11] = ins->X[12] = 0.0f;	// initial gyro bias (rad/s)
+
+	ins->Q[0] = ins->Q[1] = ins->Q[2] = 50e-4f;	// gyro noise variance (rad/s)^2
+	ins->Q[3] = ins->Q[4] = ins->Q[5] = 0.00001f;	// accelerometer noise variance (m/s^2)^2
+	ins->Q[6] = ins->Q[7] = ins->Q[8] = 2e-8f;	    // gyro bias random walk variance (rad/s^2)^2
+
+	ins->R[0] = ins->R[1] = 0.004f;	// High freq GPS horizontal position noise variance (m^2)
+	ins->R[2] = 0.036f;          // High freq GPS vertical position noise variance (m^2)
+	ins->R[3] = ins->R[4] = 0.004f;   // High freq GPS horizontal velocity noise variance (m/s)^2
+	ins->R[5] = 100.0f;          // High freq GPS vertical velocity noise variance (m/s)^2
+	ins->R[6] = ins->R[7] = ins->R[8] = 0.005f;    // magnetometer unit vector noise variance
+	ins->R[9] = .05f;                    // High freq altimeter noise variance (m^2)
 }
 
-void INSResetP(float PDiag[NUMX])
+void INSGPSFilterResetP(struct INSGPSFilter *ins, float PDiag[NUMX])
 {
 	uint8_t i,j;
 
@@ -132,96 +127,96 @@ void INSResetP(float PDiag[NUMX])
 	for (i=0;i<NUMX;i++){
 		if (PDiag != 0){
 			for (j=0;j<NUMX;j++)
-				P[i][j]=P[j][i]=0.0f;
-			P[i][i]=PDiag[i];
+				ins->P[i][j]=ins->P[j][i]=0.0f;
+			ins->P[i][i]=PDiag[i];
 		}
 	}
 }
 
-void INSSetState(float pos[3], float vel[3], float q[4], float gyro_bias[3], float accel_bias[3])
+void INSGPSFilterSetState(struct INSGPSFilter *ins, float pos[3], float vel[3], float q[4], float gyro_bias[3], float accel_bias[3])
 {
 	/* Note: accel_bias not used in 13 state INS */
-	X[0] = pos[0];
-	X[1] = pos[1];
-	X[2] = pos[2];
-	X[3] = vel[0];
-	X[4] = vel[1];
-	X[5] = vel[2];
-	X[6] = q[0];
-	X[7] = q[1];
-	X[8] = q[2];
-	X[9] = q[3];
-	X[10] = gyro_bias[0];
-	X[11] = gyro_bias[1];
-	X[12] = gyro_bias[2];
+	ins->X[0] = pos[0];
+	ins->X[1] = pos[1];
+	ins->X[2] = pos[2];
+	ins->X[3] = vel[0];
+	ins->X[4] = vel[1];
+	ins->X[5] = vel[2];
+	ins->X[6] = q[0];
+	ins->X[7] = q[1];
+	ins->X[8] = q[2];
+	ins->X[9] = q[3];
+	ins->X[10] = gyro_bias[0];
+	ins->X[11] = gyro_bias[1];
+	ins->X[12] = gyro_bias[2];
 }
 
-void INSPosVelReset(float pos[3], float vel[3]) 
+void INSGPSFilterPosVelReset(struct INSGPSFilter *ins, float pos[3], float vel[3])
 {
 	for (int i = 0; i < 6; i++) {
 		for(int j = i; j < NUMX; j++) {
-			P[i][j] = 0;  // zero the first 6 rows and columns
-			P[j][i] = 0; 
+			ins->P[i][j] = 0;  // zero the first 6 rows and columns
+			ins->P[j][i] = 0; 
 		}
 	}
 	
-	P[0][0] = P[1][1] = P[2][2] = 25;	// initial position variance (m^2)
-	P[3][3] = P[4][4] = P[5][5] = 5;	// initial velocity variance (m/s)^2
+	ins->P[0][0] = ins->P[1][1] = ins->P[2][2] = 25;	// initial position variance (m^2)
+	ins->P[3][3] = ins->P[4][4] = ins->P[5][5] = 5;	// initial velocity variance (m/s)^2
 	
-	X[0] = pos[0];
-	X[1] = pos[1];
-	X[2] = pos[2];
-	X[3] = vel[0];
-	X[4] = vel[1];
-	X[5] = vel[2];	
+	ins->X[0] = pos[0];
+	ins->X[1] = pos[1];
+	ins->X[2] = pos[2];
+	ins->X[3] = vel[0];
+	ins->X[4] = vel[1];
+	ins->X[5] = vel[2];	
 }
 
-void INSSetPosVelVar(float PosVar, float VelVar)
+void INSGPSFilterSetPosVelVar(struct INSGPSFilter *ins, float PosVar, float VelVar)
 {
-	R[0] = PosVar;
-	R[1] = PosVar;
-	R[2] = PosVar;
-	R[3] = VelVar;
-	R[4] = VelVar;
-//    R[5] = PosVar;  // Don't change vertical velocity, not measured
+	ins->R[0] = PosVar;
+	ins->R[1] = PosVar;
+	ins->R[2] = PosVar;
+	ins->R[3] = VelVar;
+	ins->R[4] = VelVar;
+//    ins->R[5] = PosVar;  // Don't change vertical velocity, not measured
 }
 
-void INSSetGyroBias(float gyro_bias[3])
+void INSGPSFilterSetGyroBias(struct INSGPSFilter *ins, float gyro_bias[3])
 {
-	X[10] = gyro_bias[0];
-	X[11] = gyro_bias[1];
-	X[12] = gyro_bias[2];
+	ins->X[10] = gyro_bias[0];
+	ins->X[11] = gyro_bias[1];
+	ins->X[12] = gyro_bias[2];
 }
 
-void INSSetAccelVar(float accel_var[3])
+void INSGPSFilterSetAccelVar(struct INSGPSFilter *ins, float accel_var[3])
 {
-	Q[3] = accel_var[0];
-	Q[4] = accel_var[1];
-	Q[5] = accel_var[2];
+	ins->Q[3] = accel_var[0];
+	ins->Q[4] = accel_var[1];
+	ins->Q[5] = accel_var[2];
 }
 
-void INSSetGyroVar(float gyro_var[3])
+void INSGPSFilterSetGyroVar(struct INSGPSFilter *ins, float gyro_var[3])
 {
-	Q[0] = gyro_var[0];
-	Q[1] = gyro_var[1];
-	Q[2] = gyro_var[2];
+	ins->Q[0] = gyro_var[0];
+	ins->Q[1] = gyro_var[1];
+	ins->Q[2] = gyro_var[2];
 }
 
-void INSSetMagVar(float scaled_mag_var[3])
+void INSGPSFilterSetMagVar(struct INSGPSFilter *ins, float scaled_mag_var[3])
 {
-	R[6] = scaled_mag_var[0];
-	R[7] = scaled_mag_var[1];
-	R[8] = scaled_mag_var[2];
+	ins->R[6] = scaled_mag_var[0];
+	ins->R[7] = scaled_mag_var[1];
+	ins->R[8] = scaled_mag_var[2];
 }
 
-void INSSetMagNorth(float B[3])
+void INSGPSFilterSetMagNorth(struct INSGPSFilter *ins, float B[3])
 {
-	Be[0] = B[0];
-	Be[1] = B[1];
-	Be[2] = B[2];
+	ins->Be[0] = B[0];
+	ins->Be[1] = B[1];
+	ins->Be[2] = B[2];
 }
 
-void INSStatePrediction(float gyro_data[3], float accel_data[3], float dT)
+void INSGPSFilterStatePrediction(struct INSGPSFilter *ins, float gyro_data[3], float accel_data[3], float dT)
 {
 	float U[6];
 	float qmag;
@@ -237,34 +232,34 @@ void INSStatePrediction(float gyro_data[3], float accel_data[3], float dT)
 	U[5] = accel_data[2];
 
 	// EKF prediction step
-	LinearizeFG(X, U, F, G);
-	RungeKutta(X, U, dT);
-	qmag = sqrtf(X[6] * X[6] + X[7] * X[7] + X[8] * X[8] + X[9] * X[9]);
-	X[6] /= qmag;
-	X[7] /= qmag;
-	X[8] /= qmag;
-	X[9] /= qmag;
+	LinearizeFG(ins->X, U, ins->F, ins->G);
+	RungeKutta(ins->X, U, dT);
+	qmag = sqrtf(ins->X[6] * ins->X[6] + ins->X[7] * ins->X[7] + ins->X[8] * ins->X[8] + ins->X[9] * ins->X[9]);
+	ins->X[6] /= qmag;
+	ins->X[7] /= qmag;
+	ins->X[8] /= qmag;
+	ins->X[9] /= qmag;
 	//CovariancePrediction(F,G,Q,dT,P);
 
 	// Update Nav solution structure
-	Nav.Pos[0] = X[0];
-	Nav.Pos[1] = X[1];
-	Nav.Pos[2] = X[2];
-	Nav.Vel[0] = X[3];
-	Nav.Vel[1] = X[4];
-	Nav.Vel[2] = X[5];
-	Nav.q[0] = X[6];
-	Nav.q[1] = X[7];
-	Nav.q[2] = X[8];
-	Nav.q[3] = X[9];
-	Nav.gyro_bias[0] = X[10];
-	Nav.gyro_bias[1] = X[11];
-	Nav.gyro_bias[2] = X[12];	
+	ins->Nav.Pos[0] = ins->X[0];
+	ins->Nav.Pos[1] = ins->X[1];
+	ins->Nav.Pos[2] = ins->X[2];
+	ins->Nav.Vel[0] = ins->X[3];
+	ins->Nav.Vel[1] = ins->X[4];
+	ins->Nav.Vel[2] = ins->X[5];
+	ins->Nav.q[0] = ins->X[6];
+	ins->Nav.q[1] = ins->X[7];
+	ins->Nav.q[2] = ins->X[8];
+	ins->Nav.q[3] = ins->X[9];
+	ins->Nav.gyro_bias[0] = ins->X[10];
+	ins->Nav.gyro_bias[1] = ins->X[11];
+	ins->Nav.gyro_bias[2] = ins->X[12];	
 }
 
-void INSCovariancePrediction(float dT)
+void INSGPSFilterCovariancePrediction(struct INSGPSFilter *ins, float dT)
 {
-	CovariancePrediction(F, G, Q, dT, P);
+	CovariancePrediction(ins->F, ins->G, ins->Q, dT, ins->P);
 }
 
 float zeros[3] = { 0, 0, 0 };
@@ -305,8 +300,8 @@ void VelBaroCorrection(float Vel[3], float BaroAlt)
 		      HORIZ_SENSORS | VERT_SENSORS | BARO_SENSOR);
 }
 
-void INSCorrection(float mag_data[3], float Pos[3], float Vel[3],
-		   float BaroAlt, uint16_t SensorsUsed)
+void INSGPSFilterCorrection(struct INSGPSFilter *ins, float mag_data[3], float Pos[3],
+			     float Vel[3], float BaroAlt, uint16_t SensorsUsed)
 {
 	float Z[10], Y[10];
 	float Bmag, qmag;
@@ -333,26 +328,99 @@ void INSCorrection(float mag_data[3], float Pos[3], float Vel[3],
 	Z[9] = BaroAlt;
 
 	// EKF correction step
-	LinearizeH(X, Be, H);
-	MeasurementEq(X, Be, Y);
-	SerialUpdate(H, R, Z, Y, P, X, SensorsUsed);
-	qmag = sqrtf(X[6] * X[6] + X[7] * X[7] + X[8] * X[8] + X[9] * X[9]);
-	X[6] /= qmag;
-	X[7] /= qmag;
-	X[8] /= qmag;
-	X[9] /= qmag;
+	LinearizeH(ins->X, ins->Be, ins->H);
+	MeasurementEq(ins->X, ins->Be, Y);
+	SerialUpdate(ins->H, ins->R, Z, Y, ins->P, ins->X, ins->K, SensorsUsed);
+	qmag = sqrtf(ins->X[6] * ins->X[6] + ins->X[7] * ins->X[7] + ins->X[8] * ins->X[8] + ins->X[9] * ins->X[9]);
+	ins->X[6] /= qmag;
+	ins->X[7] /= qmag;
+	ins->X[8] /= qmag;
+	ins->X[9] /= qmag;
 
 	// Update Nav solution structure
-	Nav.Pos[0] = X[0];
-	Nav.Pos[1] = X[1];
-	Nav.Pos[2] = X[2];
-	Nav.Vel[0] = X[3];
-	Nav.Vel[1] = X[4];
-	Nav.Vel[2] = X[5];
-	Nav.q[0] = X[6];
-	Nav.q[1] = X[7];
-	Nav.q[2] = X[8];
-	Nav.q[3] = X[9];
+	ins->Nav.Pos[0] = ins->X[0];
+	ins->Nav.Pos[1] = ins->X[1];
+	ins->Nav.Pos[2] = ins->X[2];
+	ins->Nav.Vel[0] = ins->X[3];
+	ins->Nav.Vel[1] = ins->X[4];
+	ins->Nav.Vel[2] = ins->X[5];
+	ins->Nav.q[0] = ins->X[6];
+	ins->Nav.q[1] = ins->X[7];
+	ins->Nav.q[2] = ins->X[8];
+	ins->Nav.q[3] = ins->X[9];
+}
+
+//  *************  Single Instance Functions ********
+//  The original API, operating on a default filter whose solution is
+//  published in the global Nav structure
+//  *************************************************
+
+void INSGPSInit()
+{
+	INSGPSFilterInit(&defaultFilter);
+}
+
+void INSResetP(float PDiag[NUMX])
+{
+	INSGPSFilterResetP(&defaultFilter, PDiag);
+}
+
+void INSSetState(float pos[3], float vel[3], float q[4], float gyro_bias[3], float accel_bias[3])
+{
+	INSGPSFilterSetState(&defaultFilter, pos, vel, q, gyro_bias, accel_bias);
+}
+
+void INSPosVelReset(float pos[3], float vel[3])
+{
+	INSGPSFilterPosVelReset(&defaultFilter, pos, vel);
+}
+
+void INSSetPosVelVar(float PosVar, float VelVar)
+{
+	INSGPSFilterSetPosVelVar(&defaultFilter, PosVar, VelVar);
+}
+
+void INSSetGyroBias(float gyro_bias[3])
+{
+	INSGPSFilterSetGyroBias(&defaultFilter, gyro_bias);
+}
+
+void INSSetAccelVar(float accel_var[3])
+{
+	INSGPSFilterSetAccelVar(&defaultFilter, accel_var);
+}
+
+void INSSetGyroVar(float gyro_var[3])
+{
+	INSGPSFilterSetGyroVar(&defaultFilter, gyro_var);
+}
+
+void INSSetMagVar(float scaled_mag_var[3])
+{
+	INSGPSFilterSetMagVar(&defaultFilter, scaled_mag_var);
+}
+
+void INSSetMagNorth(float B[3])
+{
+	INSGPSFilterSetMagNorth(&defaultFilter, B);
+}
+
+void INSStatePrediction(float gyro_data[3], float accel_data[3], float dT)
+{
+	INSGPSFilterStatePrediction(&defaultFilter, gyro_data, accel_data, dT);
+	Nav = defaultFilter.Nav;
+}
+
+void INSCovariancePrediction(float dT)
+{
+	INSGPSFilterCovariancePrediction(&defaultFilter, dT);
+}
+
+void INSCorrection(float mag_data[3], float Pos[3], float Vel[3],
+		   float BaroAlt, uint16_t SensorsUsed)
+{
+	INSGPSFilterCorrection(&defaultFilter, mag_data, Pos, Vel, BaroAlt, SensorsUsed);
+	Nav = defaultFilter.Nav;
 }
 
 //  *************  CovariancePrediction *************
@@ -362,8 +430,8 @@ void INSCorrection(float mag_data[3], float Pos[3], float Vel[3],
 //  Q is the discrete time covariance of process noise
 //  Q is vector of the diagonal for a square matrix with
 //    dimensions equal to the number of disturbance noise variables
-//  The General Method is very inefficient,not taking advantage of the sparse F and G
-//  The first Method is very specific to this implementation
+//  The General Method works for any F and G, skipping their zero elements at run time
+//  The first Method is very specific to this implementation and is the faster one
 //  ************************************************
 
 #ifdef COVARIANCE_PREDICTION_GENERAL
@@ -371,28 +439,53 @@ void INSCorrection(float mag_data[3], float Pos[3], float Vel[3],
 void CovariancePrediction(float F[NUMX][NUMX], float G[NUMX][NUMW],
 			  float Q[NUMW], float dT, float P[NUMX][NUMX])
 {
-	float Dummy[NUMX][NUMX], dTsq;
+	float A[NUMX][NUMX], At[NUMX][NUMX], Tsq, f, qg;
 	uint8_t i, j, k;
 
-	//  Pnew = (I+F*T)*P*(I+F*T)' + T^2*G*Q*G' = T^2[(P/T + F*P)*(I/T + F') + G*Q*G')]
+	//  Pnew = (I+F*T)*P*(I+F*T)' + T^2*G*Q*G'
+	//  Computed as A = (I+F*T)*P, Pnew = (I+F*T)*A' + T^2*G*Q*G', where both
+	//  products are row updates over contiguous memory that skip the zeros of F
+	//  and G, and only the upper triangular of the symmetric Pnew is formed.
 
-	dTsq = dT * dT;
+	Tsq = dT * dT;
 
-	for (i = 0; i < NUMX; i++)	// Calculate Dummy = (P/T +F*P)
-		for (j = 0; j < NUMX; j++) {
-			Dummy[i][j] = P[i][j] / dT;
-			for (k = 0; k < NUMX; k++)
-				Dummy[i][j] += F[i][k] * P[k][j];
+	for (i = 0; i < NUMX; i++) {	// Calculate A = P + T*F*P
+		for (j = 0; j < NUMX; j++)
+			A[i][j] = P[i][j];
+		for (k = 0; k < NUMX; k++) {
+			f = F[i][k] * dT;
+			if (f != 0) {
+				for (j = 0; j < NUMX; j++)
+					A[i][j] += f * P[k][j];
+			}
 		}
-	for (i = 0; i < NUMX; i++)	// Calculate Pnew = Dummy/T + Dummy*F' + G*Qw*G'
-		for (j = i; j < NUMX; j++) {	// Use symmetry, ie only find upper triangular
-			P[i][j] = Dummy[i][j] / dT;
-			for (k = 0; k < NUMX; k++)
-				P[i][j] += Dummy[i][k] * F[j][k];	// P = Dummy/T + Dummy*F'
-			for (k = 0; k < NUMW; k++)
-				P[i][j] += Q[k] * G[i][k] * G[j][k];	// P = Dummy/T + Dummy*F' + G*Q*G'
-			P[j][i] = P[i][j] = P[i][j] * dTsq;	// Pnew = T^2*P and fill in lower triangular;
+	}
+	for (i = 0; i < NUMX; i++)	// Transpose A
+		for (j = 0; j < NUMX; j++)
+			At[i][j] = A[j][i];
+	for (i = 0; i < NUMX; i++) {	// Calculate the upper triangular of Pnew = A' + T*F*A'
+		for (j = i; j < NUMX; j++)
+			P[i][j] = At[i][j];
+		for (k = 0; k < NUMX; k++) {
+			f = F[i][k] * dT;
+			if (f != 0) {
+				for (j = i; j < NUMX; j++)
+					P[i][j] += f * At[k][j];
+			}
 		}
+	}
+	for (k = 0; k < NUMW; k++) {	// Pnew += T^2*G*Q*G'
+		for (i = 0; i < NUMX; i++) {
+			qg = Tsq * Q[k] * G[i][k];
+			if (qg != 0) {
+				for (j = i; j < NUMX; j++)
+					P[i][j] += qg * G[j][k];
+			}
+		}
+	}
+	for (i = 0; i < NUMX; i++)	// fill in lower triangular
+		for (j = i + 1; j < NUMX; j++)
+			P[j][i] = P[i][j];
 }
 
 #else
@@ -1351,7 +1444,7 @@ void CovariancePrediction(float F[NUMX][NUMX], float G[NUMX][NUMW],
 
 void SerialUpdate(float H[NUMV][NUMX], float R[NUMV], float Z[NUMV],
 		  float Y[NUMV], float P[NUMX][NUMX], float X[NUMX],
-		  uint16_t SensorsUsed)
+		  float K[NUMX][NUMV], uint16_t SensorsUsed)
 {
 	float HP[NUMX], HPHR, Error;
 	uint8_t i, j, k, m;
@@ -1360,10 +1453,13 @@ void SerialUpdate(float H[NUMV][NUMX], float R[NUMV], float Z[NUMV],
 
 		if (SensorsUsed & (0x01 << m)) {	// use this sensor for update
 
-			for (j = 0; j < NUMX; j++) {	// Find Hp = H*P
+			for (j = 0; j < NUMX; j++)	// Find Hp = H*P
 				HP[j] = 0;
-				for (k = 0; k < NUMX; k++)
-					HP[j] += H[m][k] * P[k][j];
+			for (k = 0; k < NUMX; k++) {	// as rows of P, skipping the zeros of H
+				if (H[m][k] != 0) {
+					for (j = 0; j < NUMX; j++)
+						HP[j] += H[m][k] * P[k][j];
+				}
 			}
 			HPHR = R[m];	// Find  HPHR = H*P*H' + R
 			for (k = 0; k < NUMX; k++)
@@ -0,0 +1,271 @@
+/**
+ ******************************************************************************
+ * @addtogroup AHRS
+ * @{
+ * @addtogroup INSGPS
+ * @{
+ *
+ * @file       insgpsreplay.c
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      Host tool replaying recorded sensor logs through the INS/GPS EKF.
+ *
+ * Log format, one record per line:
+ *   P dT gx gy gz ax ay az                      state and covariance prediction
+ *   C mask mx my mz pn pe pd vn ve vd baro      correction, mask as SensorsUsed
+ * Lines starting with # are ignored.
+ *
+ * Several filters can be run side by side on the same log (-n), the gyro noise
+ * variance is then swept by a factor of two per filter to compare settings.
+ * Reports the time per predict and per correction in microseconds.
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "insgps.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+
+#define MAX_FILTERS 64
+
+enum RecordType { RECORD_PREDICT, RECORD_CORRECT };
+
+struct Record {
+	enum RecordType type;
+	uint16_t mask;
+	float dT;
+	float gyro[3], accel[3];
+	float mag[3], pos[3], vel[3], baro;
+};
+
+static struct Record *records;
+static size_t numRecords;
+static size_t allocRecords;
+
+static double now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static struct Record *newRecord(void)
+{
+	if (numRecords == allocRecords) {
+		allocRecords = allocRecords ? allocRecords * 2 : 4096;
+		records = realloc(records, allocRecords * sizeof(struct Record));
+		if (records == NULL) {
+			fprintf(stderr, "Out of memory\n");
+			exit(1);
+		}
+	}
+	return &records[numRecords++];
+}
+
+/**
+ * Load a recorded log, the whole log is parsed before replay so that parsing
+ * is not part of the timing.
+ */
+static int loadLog(const char *fileName)
+{
+	FILE *f = strcmp(fileName, "-") ? fopen(fileName, "r") : stdin;
+	char line[512];
+	unsigned int lineNo = 0;
+	unsigned int mask;
+	struct Record *r;
+
+	if (f == NULL) {
+		perror(fileName);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), f)) {
+		++lineNo;
+		if (line[0] == '#' || line[0] == '\n')
+			continue;
+		if (line[0] == 'P') {
+			r = newRecord();
+			r->type = RECORD_PREDICT;
+			if (sscanf(line + 1, "%f %f %f %f %f %f %f", &r->dT,
+				   &r->gyro[0], &r->gyro[1], &r->gyro[2],
+				   &r->accel[0], &r->accel[1], &r->accel[2]) == 7)
+				continue;
+		} else if (line[0] == 'C') {
+			r = newRecord();
+			r->type = RECORD_CORRECT;
+			if (sscanf(line + 1, "%i %f %f %f %f %f %f %f %f %f %f", &mask,
+				   &r->mag[0], &r->mag[1], &r->mag[2],
+				   &r->pos[0], &r->pos[1], &r->pos[2],
+				   &r->vel[0], &r->vel[1], &r->vel[2], &r->baro) == 11) {
+				r->mask = mask;
+				continue;
+			}
+		}
+		fprintf(stderr, "%s:%u: malformed record\n", fileName, lineNo);
+		if (f != stdin)
+			fclose(f);
+		return -1;
+	}
+	if (f != stdin)
+		fclose(f);
+	return 0;
+}
+
+/**
+ * Create a synthetic log of a vehicle sitting level, 500Hz prediction with
+ * magnetometer updates at 50Hz and GPS/baro updates at 5Hz.
+ */
+static void synthesizeLog(unsigned int seconds)
+{
+	unsigned int n;
+	struct Record *r;
+
+	for (n = 0; n < seconds * 500; ++n) {
+		r = newRecord();
+		memset(r, 0, sizeof(*r));
+		r->type = RECORD_PREDICT;
+		r->dT = 0.002f;
+		r->gyro[0] = 0.001f * (rand() / (float)RAND_MAX - 0.5f);
+		r->gyro[1] = 0.001f * (rand() / (float)RAND_MAX - 0.5f);
+		r->gyro[2] = 0.001f * (rand() / (float)RAND_MAX - 0.5f);
+		r->accel[2] = -9.81f + 0.05f * (rand() / (float)RAND_MAX - 0.5f);
+		if (n % 10 == 0) {
+			r = newRecord();
+			memset(r, 0, sizeof(*r));
+			r->type = RECORD_CORRECT;
+			r->mag[0] = 1.0f;
+			r->mask = MAG_SENSORS;
+			if (n % 100 == 0)
+				r->mask |= FULL_SENSORS;
+		}
+	}
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr, "Usage: %s [-n filters] [-g gyro_var] [-a accel_var] [-m mag_var] [-s seconds] [log|-]\n"
+		"  -n  number of filters run side by side, gyro variance is swept x2 per filter\n"
+		"  -s  replay a synthetic log of the given length instead of a recorded one\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+	static struct INSGPSFilter filters[MAX_FILTERS];
+	unsigned int numFilters = 1;
+	unsigned int synthetic = 0;
+	float gyroVar = 50e-4f;
+	float accelVar = 0.00001f;
+	float magVar = 0.005f;
+	float var[3];
+	float q[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+	float zeros[3] = { 0.0f, 0.0f, 0.0f };
+	double predictUs = 0, correctUs = 0, t0;
+	unsigned long predictions = 0, corrections = 0;
+	size_t n;
+	unsigned int i;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:g:a:m:s:h")) != -1) {
+		switch (opt) {
+		case 'n':
+			numFilters = atoi(optarg);
+			break;
+		case 'g':
+			gyroVar = atof(optarg);
+			break;
+		case 'a':
+			accelVar = atof(optarg);
+			break;
+		case 'm':
+			magVar = atof(optarg);
+			break;
+		case 's':
+			synthetic = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (numFilters < 1 || numFilters > MAX_FILTERS) {
+		fprintf(stderr, "Number of filters must be between 1 and %d\n", MAX_FILTERS);
+		return 1;
+	}
+	if (synthetic) {
+		synthesizeLog(synthetic);
+	} else if (optind < argc) {
+		if (loadLog(argv[optind]) != 0)
+			return 1;
+	} else {
+		usage(argv[0]);
+		return 1;
+	}
+
+	for (i = 0; i < numFilters; ++i) {
+		INSGPSFilterInit(&filters[i]);
+		INSGPSFilterSetState(&filters[i], zeros, zeros, q, zeros, zeros);
+		var[0] = var[1] = var[2] = gyroVar * (float)(1u << i % 31);
+		INSGPSFilterSetGyroVar(&filters[i], var);
+		var[0] = var[1] = var[2] = accelVar;
+		INSGPSFilterSetAccelVar(&filters[i], var);
+		var[0] = var[1] = var[2] = magVar;
+		INSGPSFilterSetMagVar(&filters[i], var);
+	}
+
+	for (n = 0; n < numRecords; ++n) {
+		struct Record *r = &records[n];
+		t0 = now_us();
+		for (i = 0; i < numFilters; ++i) {
+			if (r->type == RECORD_PREDICT) {
+				INSGPSFilterStatePrediction(&filters[i], r->gyro, r->accel, r->dT);
+				INSGPSFilterCovariancePrediction(&filters[i], r->dT);
+			} else {
+				INSGPSFilterCorrection(&filters[i], r->mag, r->pos, r->vel, r->baro, r->mask);
+			}
+		}
+		if (r->type == RECORD_PREDICT) {
+			predictUs += now_us() - t0;
+			predictions += numFilters;
+		} else {
+			correctUs += now_us() - t0;
+			corrections += numFilters;
+		}
+	}
+
+	printf("records %lu, filters %u\n", (unsigned long)numRecords, numFilters);
+	printf("predict %.3f us (%lu), correct %.3f us (%lu)\n",
+	       predictions ? predictUs / predictions : 0.0, predictions,
+	       corrections ? correctUs / corrections : 0.0, corrections);
+	for (i = 0; i < numFilters; ++i) {
+		struct NavStruct *nav = &filters[i].Nav;
+		printf("filter %u gyro_var %g: pos %f %f %f vel %f %f %f q %f %f %f %f bias %f %f %f\n",
+		       i, filters[i].Q[0], nav->Pos[0], nav->Pos[1], nav->Pos[2],
+		       nav->Vel[0], nav->Vel[1], nav->Vel[2],
+		       nav->q[0], nav->q[1], nav->q[2], nav->q[3],
+		       nav->gyro_bias[0], nav->gyro_bias[1], nav->gyro_bias[2]);
+	}
+	return 0;
+}
+
+/**
+ * @}
+ * @}
+ */
@@ -499,6 +499,9 @@ void vApplicationIdleHook(void)
 		idleCounter = 0;
 		idleCounterClear = 0;
 	}
+#if defined(PIOS_INCLUDE_SIM)
+	PIOS_SIM_IdleHook();
+#endif
 }
 
 /**
@@ -0,0 +1,96 @@
+/**
+ ******************************************************************************
+ *
+ * @file       pios_sim.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      Simulation bus shared with an external physics process.
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef PIOS_SIM_H
+#define PIOS_SIM_H
+
+/*
+ * Each simulated vehicle owns one POSIX shared memory region named
+ * PIOS_SIM_SHM_PREFIX<instance>, the instance is taken from the
+ * OP_SIM_INSTANCE environment variable (default 0). The region holds two
+ * single producer / single consumer rings, sensor samples written by the
+ * physics process and actuator samples written by the firmware, and the
+ * lockstep clock counters. UDP ports are offset by the instance times
+ * PIOS_SIM_PORT_STRIDE so that many vehicles can share one host.
+ *
+ * With OP_SIM_LOCKSTEP=1 the FreeRTOS tick is no longer taken from the wall
+ * clock, the firmware runs exactly one tick for each tick granted by the
+ * physics process, which allows running faster (or slower) than real time.
+ *
+ * The layout below is shared with flight/SimPosix/simlaunch.py, bump
+ * PIOS_SIM_VERSION on any change.
+ */
+
+#define PIOS_SIM_SHM_PREFIX	"/openpilot-sim-"
+#define PIOS_SIM_MAGIC		0x4953504F	/* "OPSI" */
+#define PIOS_SIM_VERSION	2
+#define PIOS_SIM_RING_LEN	64		/* must be a power of two */
+#define PIOS_SIM_NUM_ACTUATORS	16
+#define PIOS_SIM_PORT_STRIDE	10
+
+/* Global Types */
+struct pios_sim_sensors {
+	uint32_t time_us;
+	float gyro[3];		/* rad/s, body frame */
+	float accel[3];		/* m/s^2, body frame */
+	float mag[3];		/* body frame */
+	float baro_alt;		/* m */
+	float gps_ned[3];	/* m, relative to home */
+	float gps_vel[3];	/* m/s, NED */
+};
+
+struct pios_sim_actuators {
+	uint32_t time_us;
+	uint16_t servo[PIOS_SIM_NUM_ACTUATORS];	/* pulse widths in us */
+};
+
+struct pios_sim_bus {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t instance;
+	uint32_t lockstep;
+	uint32_t tick_us;			/* length of one tick */
+	volatile uint32_t tick_granted;		/* written by the physics process */
+	volatile uint32_t tick_done;		/* written by the firmware, once all tasks blocked after the tick */
+	volatile uint32_t sensor_head;		/* written by the physics process */
+	volatile uint32_t sensor_tail;		/* written by the firmware */
+	volatile uint32_t actuator_head;	/* written by the firmware */
+	volatile uint32_t actuator_tail;	/* written by the physics process */
+	volatile uint32_t actuator_dropped;	/* written by the firmware, samples lost to a full ring */
+	struct pios_sim_sensors sensor_ring[PIOS_SIM_RING_LEN];
+	struct pios_sim_actuators actuator_ring[PIOS_SIM_RING_LEN];
+};
+
+/* Public Functions */
+extern int32_t PIOS_SIM_Init(void);
+extern uint32_t PIOS_SIM_GetInstance(void);
+extern uint16_t PIOS_SIM_GetPortOffset(void);
+extern bool PIOS_SIM_IsLockstep(void);
+extern uint32_t PIOS_SIM_GetuS(void);
+extern bool PIOS_SIM_ReadSensors(struct pios_sim_sensors *sensors);
+extern void PIOS_SIM_SetActuator(uint8_t channel, uint16_t value);
+extern void PIOS_SIM_IdleHook(void);
+
+#endif /* PIOS_SIM_H */
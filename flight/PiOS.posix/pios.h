@@ -67,6 +67,9 @@
 #include <pios_debug.h>
 #include <pios_crc.h>
 #include <pios_rcvr.h>
+#if defined(PIOS_INCLUDE_SIM)
+#include <pios_sim.h>
+#endif
 
 #define NELEMENTS(x) (sizeof(x) / sizeof(*(x)))
 
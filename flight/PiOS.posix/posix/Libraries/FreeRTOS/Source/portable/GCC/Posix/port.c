@@ -158,6 +158,8 @@ static volatile portBASE_TYPE xInterruptsEnabled = pdFALSE;
 static volatile portBASE_TYPE xSchedulerNesting = 0;
 static volatile portBASE_TYPE xPendYield = pdFALSE;
 static volatile portLONG lIndexOfLastAddedTask = 0;
+static portBASE_TYPE (* volatile pxExternalTickWait)( void ) = NULL;
+static volatile unsigned portLONG ulTicksHandled = 0;
 /*-----------------------------------------------------------*/
 
 /*
@@ -303,6 +305,24 @@ portBASE_TYPE xPortStartScheduler( void )
 	
 	while ( pdTRUE != xSchedulerEnd )
 	{
+		/* an external tick source replaces the wall clock entirely */
+		if ( NULL != pxExternalTickWait )
+		{
+			if ( pdTRUE == pxExternalTickWait() )
+			{
+				/* the tick handler gives up while the running task can not be
+				 * preempted, an external tick must not get lost so retry it */
+				unsigned portLONG ulTicks = ulTicksHandled;
+				vPortSystemTickHandler();
+				while ( ulTicks == ulTicksHandled && pdTRUE != xSchedulerEnd )
+				{
+					sched_yield();
+					vPortSystemTickHandler();
+				}
+			}
+			continue;
+		}
+
 		/* wait for the specified wait time */
 		wait.tv_sec = sleepTimeUS / 1000000;
 		wait.tv_nsec = 1000 * ( sleepTimeUS % 1000000 );
@@ -346,6 +366,15 @@ portBASE_TYPE xPortStartScheduler( void )
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * install an external tick source, used for lockstep simulation
+ */
+void vPortSetExternalTickSource( portBASE_TYPE (*pxTickWait)( void ) )
+{
+	pxExternalTickWait = pxTickWait;
+}
+/*-----------------------------------------------------------*/
+
 /**
  * quickly clean up all running threads, without asking them first
  */
@@ -647,6 +676,7 @@ void vPortSystemTickHandler()
 	 * call tick handler
 	 */
 	vTaskIncrementTick();
+	ulTicksHandled++;
 
 	
 #if ( configUSE_PREEMPTION == 1 )
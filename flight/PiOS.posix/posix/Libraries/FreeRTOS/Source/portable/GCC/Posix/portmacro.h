@@ -100,6 +100,11 @@ extern void vPortYield( void );
 
 #define portYIELD()					vPortYield()
 
+/* Replace the wall clock tick by an external one, pxTickWait blocks until the
+ * next tick is due and returns pdTRUE to run it. Every tick it grants is
+ * handled exactly once. */
+extern void vPortSetExternalTickSource( portBASE_TYPE (*pxTickWait)( void ) );
+
 #define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYieldFromISR()
 /*-----------------------------------------------------------*/
 
@@ -106,6 +106,12 @@ int32_t PIOS_DELAY_WaitmS(uint32_t mS)
 uint32_t PIOS_DELAY_GetuS()
 {
 	static struct timespec current;
+#if defined(PIOS_INCLUDE_SIM)
+	/* in lockstep mode time only advances with the simulation */
+	if (PIOS_SIM_IsLockstep()) {
+		return PIOS_SIM_GetuS();
+	}
+#endif
 	clock_gettime(CLOCK_REALTIME, &current);
 	return ((current.tv_sec * 1000000) + (current.tv_nsec / 1000));
 }
@@ -66,6 +66,9 @@ void PIOS_Servo_Set(uint8_t Servo, uint16_t Position)
 	if (Servo < PIOS_SERVO_NUM_OUTPUTS) {
 		/* Update the position */
 		ServoPosition[Servo] = Position;
+#if defined(PIOS_INCLUDE_SIM)
+		PIOS_SIM_SetActuator(Servo, Position);
+#endif
 
 	}
 #endif // PIOS_ENABLE_DEBUG_PINS
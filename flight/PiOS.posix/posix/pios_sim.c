@@ -0,0 +1,239 @@
+/**
+ ******************************************************************************
+ *
+ * @file       pios_sim.c
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      Simulation bus shared with an external physics process, see
+ *             pios_sim.h for the description of the shared memory layout.
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/* Project Includes */
+#include "pios.h"
+
+#if defined(PIOS_INCLUDE_SIM)
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sched.h>
+
+/* Local Variables */
+static struct pios_sim_bus *bus;
+static uint32_t instance;
+static bool lockstep;
+static struct pios_sim_actuators actuators;
+static bool actuatorsChanged;
+static uint32_t ticksStarted;
+static volatile uint32_t idleTick;
+
+/* Private Function Prototypes */
+static void PIOS_SIM_PublishActuators(void);
+static portBASE_TYPE PIOS_SIM_WaitTick(void);
+
+/**
+* Map the shared memory region of this vehicle and, in lockstep mode, take
+* over the FreeRTOS tick. Must be called before the scheduler is started.
+* \return < 0 if the region could not be created
+*/
+int32_t PIOS_SIM_Init(void)
+{
+	char name[64];
+	const char *env;
+	int fd;
+
+	env = getenv("OP_SIM_INSTANCE");
+	instance = env ? strtoul(env, NULL, 0) : 0;
+	env = getenv("OP_SIM_LOCKSTEP");
+	lockstep = env && atoi(env) != 0;
+
+	snprintf(name, sizeof(name), "%s%u", PIOS_SIM_SHM_PREFIX, (unsigned int)instance);
+	fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+	if (fd < 0 || ftruncate(fd, sizeof(struct pios_sim_bus)) != 0) {
+		perror(name);
+		return -1;
+	}
+	bus = mmap(NULL, sizeof(struct pios_sim_bus), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (bus == MAP_FAILED) {
+		bus = NULL;
+		perror(name);
+		return -1;
+	}
+
+	/* (Re)start the bus, the magic is written last so the physics process
+	 * never sees a half initialised region */
+	bus->magic = 0;
+	__sync_synchronize();
+	bus->version = PIOS_SIM_VERSION;
+	bus->instance = instance;
+	bus->lockstep = lockstep;
+	bus->tick_us = portTICK_RATE_MICROSECONDS;
+	bus->tick_granted = 0;
+	bus->tick_done = 0;
+	ticksStarted = 0;
+	idleTick = 0;
+	bus->sensor_tail = bus->sensor_head;
+	bus->actuator_head = 0;
+	bus->actuator_tail = 0;
+	bus->actuator_dropped = 0;
+	__sync_synchronize();
+	bus->magic = PIOS_SIM_MAGIC;
+
+	if (lockstep) {
+		vPortSetExternalTickSource(PIOS_SIM_WaitTick);
+	}
+
+	printf("sim instance %u - %s - %s clock\n", (unsigned int)instance, name, lockstep ? "lockstep" : "wall");
+
+	return 0;
+}
+
+/**
+ * @brief The vehicle instance this firmware runs as
+ */
+uint32_t PIOS_SIM_GetInstance(void)
+{
+	return instance;
+}
+
+/**
+ * @brief Offset to add to all UDP ports of this instance
+ */
+uint16_t PIOS_SIM_GetPortOffset(void)
+{
+	return instance * PIOS_SIM_PORT_STRIDE;
+}
+
+/**
+ * @brief Whether the FreeRTOS tick is driven by the physics process
+ */
+bool PIOS_SIM_IsLockstep(void)
+{
+	return lockstep;
+}
+
+/**
+ * @brief Simulated time in lockstep mode
+ * @return Microseconds since the start of the simulation
+ */
+uint32_t PIOS_SIM_GetuS(void)
+{
+	return bus ? ticksStarted * bus->tick_us : 0;
+}
+
+/**
+ * Get the oldest sensor sample the physics process has published.
+ * \param[out] sensors The sample
+ * \return true if a sample was available
+ */
+bool PIOS_SIM_ReadSensors(struct pios_sim_sensors *sensors)
+{
+	uint32_t tail;
+
+	if (!bus || bus->sensor_tail == bus->sensor_head) {
+		return false;
+	}
+	__sync_synchronize();
+	tail = bus->sensor_tail;
+	*sensors = bus->sensor_ring[tail & (PIOS_SIM_RING_LEN - 1)];
+	__sync_synchronize();
+	bus->sensor_tail = tail + 1;
+	return true;
+}
+
+/**
+ * Update an actuator output. In lockstep mode the outputs are published once
+ * at the end of the tick, otherwise immediately.
+ * \param[in] channel Output channel
+ * \param[in] value Pulse width in us
+ */
+void PIOS_SIM_SetActuator(uint8_t channel, uint16_t value)
+{
+	if (channel < PIOS_SIM_NUM_ACTUATORS && actuators.servo[channel] != value) {
+		actuators.servo[channel] = value;
+		actuatorsChanged = true;
+		if (!lockstep) {
+			PIOS_SIM_PublishActuators();
+		}
+	}
+}
+
+/**
+ * Publish the actuator outputs if they changed. If the physics process is
+ * not consuming them the ring is full and the new sample is dropped, the
+ * outputs are published again on the next call. The tail belongs to the
+ * physics process and is never written here.
+ */
+static void PIOS_SIM_PublishActuators(void)
+{
+	uint32_t head;
+
+	if (!bus || !actuatorsChanged) {
+		return;
+	}
+	head = bus->actuator_head;
+	if (head - bus->actuator_tail >= PIOS_SIM_RING_LEN) {
+		++bus->actuator_dropped;
+		return;
+	}
+	actuatorsChanged = false;
+	actuators.time_us = PIOS_DELAY_GetuS();
+	bus->actuator_ring[head & (PIOS_SIM_RING_LEN - 1)] = actuators;
+	__sync_synchronize();
+	bus->actuator_head = head + 1;
+}
+
+/**
+ * Must be called from the FreeRTOS idle hook. The idle task only runs once
+ * every task woken by a tick has blocked again, which completes the tick.
+ */
+void PIOS_SIM_IdleHook(void)
+{
+	idleTick = xTaskGetTickCount();
+}
+
+/**
+ * External tick source of the FreeRTOS port in lockstep mode, runs on the
+ * scheduler thread. Waits until the tasks are done with the previous tick,
+ * reports it as done along with its outputs, then blocks until the physics
+ * process grants the next tick. The port handles every granted tick once, so
+ * the FreeRTOS tick count is the number of ticks started.
+ * \return pdTRUE when the tick handler should run
+ */
+static portBASE_TYPE PIOS_SIM_WaitTick(void)
+{
+	if (bus->tick_done != ticksStarted) {
+		while (idleTick != ticksStarted) {
+			sched_yield();
+		}
+		__sync_synchronize();
+		PIOS_SIM_PublishActuators();
+		__sync_synchronize();
+		bus->tick_done = ticksStarted;
+	}
+	while (bus->tick_granted == ticksStarted) {
+		sched_yield();
+	}
+	__sync_synchronize();
+	++ticksStarted;
+	return pdTRUE;
+}
+
+#endif
@@ -58,6 +58,13 @@ void PIOS_SYS_Init(void)
 	/* Initialise LEDs */
 	PIOS_LED_Init();
 #endif
+
+#if defined(PIOS_INCLUDE_SIM)
+	/* Attach to the simulation bus before the scheduler takes the first tick */
+	if (PIOS_SIM_Init()) {
+		PIOS_Assert(0);
+	}
+#endif
 }
 
 /**
@@ -57,6 +57,7 @@
 #define PIOS_INCLUDE_RTC
 #define PIOS_INCLUDE_WDG
 #define PIOS_INCLUDE_UDP
+#define PIOS_INCLUDE_SIM
 
 /* Select the sensors to include */
 //#define PIOS_INCLUDE_BMA180
@@ -36,6 +36,14 @@
 #include "openpilot.h"
 #include "uavobjectsinit.h"
 #include "systemmod.h"
+#if defined(PIOS_INCLUDE_SIM)
+#include "gyros.h"
+#include "accels.h"
+#include "magnetometer.h"
+#include "baroaltitude.h"
+#include "positionactual.h"
+#include "velocityactual.h"
+#endif
 
 /* Task Priorities */
 #define PRIORITY_TASK_HOOKS             (tskIDLE_PRIORITY + 3)
@@ -47,6 +55,23 @@
 #if INCLUDE_TEST_TASKS
 static uint8_t sdcard_available;
 #endif
+/* Event dispatcher benchmark, enable with CFLAGS=-DINCLUDE_EVENT_BENCHMARK=1 in the environment of make */
+#ifndef INCLUDE_EVENT_BENCHMARK
+#define INCLUDE_EVENT_BENCHMARK 0
+#endif
+#if INCLUDE_EVENT_BENCHMARK
+#include <time.h>
+#define EVENT_BENCHMARK_OBJECTS		200
+#define EVENT_BENCHMARK_REPORT_MS	10000
+#define EVENT_BENCHMARK_TASK_STACK	(1024 / 4)
+static uint32_t benchmarkDispatched[EVENT_BENCHMARK_OBJECTS];
+static int32_t benchmarkMaxLatenessMs;
+static int32_t benchmarkLastDispatchMs[EVENT_BENCHMARK_OBJECTS];
+#endif
+#if defined(PIOS_INCLUDE_SIM)
+#define SIM_SENSORS_TASK_PRIORITY	(tskIDLE_PRIORITY + 3)
+#define SIM_SENSORS_TASK_STACK		(1024 / 4)
+#endif
 FILEINFO File;
 char Buffer[1024];
 uint32_t Cache;
@@ -59,6 +84,13 @@ static void TaskHIDTest(void *pvParameters);
 static void TaskServos(void *pvParameters);
 static void TaskSDCard(void *pvParameters);
 #endif
+#if INCLUDE_EVENT_BENCHMARK
+static void TaskEventBenchmark(void *pvParameters);
+static void eventBenchmarkCallback(UAVObjEvent* ev);
+#endif
+#if defined(PIOS_INCLUDE_SIM)
+static void TaskSimSensors(void *pvParameters);
+#endif
 int32_t CONSOLE_Parse(uint8_t port, char c);
 void OP_ADC_NotifyChange(uint32_t pin, uint32_t pin_value);
 
@@ -131,10 +163,143 @@ initTask(void *parameters)
 	/* Initialize modules */
 	MODULE_INITIALISE_ALL;
 	
+#if INCLUDE_EVENT_BENCHMARK
+	xTaskCreate(TaskEventBenchmark, (const signed char *)"EvBench",
+				EVENT_BENCHMARK_TASK_STACK, NULL, tskIDLE_PRIORITY + 1, NULL);
+#endif
+#if defined(PIOS_INCLUDE_SIM)
+	xTaskCreate(TaskSimSensors, (const signed char *)"SimSensors",
+				SIM_SENSORS_TASK_STACK, NULL, SIM_SENSORS_TASK_PRIORITY, NULL);
+#endif
+
 	/* terminate this task */
 	vTaskDelete(NULL);
 }
 
+#if defined(PIOS_INCLUDE_SIM)
+/**
+ * Simulated sensors.
+ *
+ * Publishes the samples of the physics process on the simulation bus once per
+ * tick. Without a physics process the ring stays empty and nothing is
+ * updated, so the objects can still be set over telemetry (HITL).
+ */
+static void TaskSimSensors(void *pvParameters)
+{
+	struct pios_sim_sensors sensors;
+	GyrosData gyros;
+	AccelsData accels;
+	MagnetometerData mag;
+	BaroAltitudeData baro;
+	PositionActualData position;
+	VelocityActualData velocity;
+	bool updated;
+
+	while (1) {
+		updated = false;
+		while (PIOS_SIM_ReadSensors(&sensors)) {
+			updated = true;
+		}
+		if (updated) {
+			GyrosGet(&gyros);
+			gyros.x = sensors.gyro[0] * 180 / M_PI;
+			gyros.y = sensors.gyro[1] * 180 / M_PI;
+			gyros.z = sensors.gyro[2] * 180 / M_PI;
+			GyrosSet(&gyros);
+
+			AccelsGet(&accels);
+			accels.x = sensors.accel[0];
+			accels.y = sensors.accel[1];
+			accels.z = sensors.accel[2];
+			AccelsSet(&accels);
+
+			mag.x = sensors.mag[0];
+			mag.y = sensors.mag[1];
+			mag.z = sensors.mag[2];
+			MagnetometerSet(&mag);
+
+			BaroAltitudeGet(&baro);
+			baro.Altitude = sensors.baro_alt;
+			BaroAltitudeSet(&baro);
+
+			position.North = sensors.gps_ned[0];
+			position.East = sensors.gps_ned[1];
+			position.Down = sensors.gps_ned[2];
+			PositionActualSet(&position);
+
+			velocity.North = sensors.gps_vel[0];
+			velocity.East = sensors.gps_vel[1];
+			velocity.Down = sensors.gps_vel[2];
+			VelocityActualSet(&velocity);
+		}
+		vTaskDelay(1);
+	}
+}
+#endif
+
+#if INCLUDE_EVENT_BENCHMARK
+/**
+ * Event dispatcher benchmark.
+ *
+ * Registers EVENT_BENCHMARK_OBJECTS periodic callbacks with periods spread
+ * between 10ms and 1s, then periodically reports the number of dispatched
+ * events, the worst lateness of a periodic event and the process CPU time
+ * spent per dispatched event.
+ */
+static void TaskEventBenchmark(void *pvParameters)
+{
+	UAVObjEvent ev;
+	uint32_t n;
+	uint32_t total;
+	clock_t cpuStart;
+	clock_t cpuNow;
+
+	memset(&ev, 0, sizeof(UAVObjEvent));
+	for (n = 0; n < EVENT_BENCHMARK_OBJECTS; ++n) {
+		// The instance id identifies the benchmark entry in the callback
+		ev.instId = n;
+		benchmarkLastDispatchMs[n] = -1;
+		EventPeriodicCallbackCreate(&ev, eventBenchmarkCallback, 10 + (n * 990) / EVENT_BENCHMARK_OBJECTS);
+	}
+
+	cpuStart = clock();
+	while (1) {
+		vTaskDelay(EVENT_BENCHMARK_REPORT_MS / portTICK_RATE_MS);
+		cpuNow = clock();
+		total = 0;
+		for (n = 0; n < EVENT_BENCHMARK_OBJECTS; ++n) {
+			total += benchmarkDispatched[n];
+			benchmarkDispatched[n] = 0;
+		}
+		fprintf(stderr, "EventBenchmark: %u objects, %u events in %ums, max lateness %dms, %.2fus CPU per event\n",
+			EVENT_BENCHMARK_OBJECTS, total, EVENT_BENCHMARK_REPORT_MS, benchmarkMaxLatenessMs,
+			total ? (double)(cpuNow - cpuStart) * 1e6 / CLOCKS_PER_SEC / total : 0.0);
+		benchmarkMaxLatenessMs = 0;
+		cpuStart = cpuNow;
+	}
+}
+
+/**
+ * Periodic callback of the event dispatcher benchmark, runs in the event task.
+ */
+static void eventBenchmarkCallback(UAVObjEvent* ev)
+{
+	int32_t timeNow = xTaskGetTickCount() * portTICK_RATE_MS;
+	uint16_t n = ev->instId;
+	int32_t periodMs = 10 + (n * 990) / EVENT_BENCHMARK_OBJECTS;
+	int32_t lateness;
+
+	if (benchmarkLastDispatchMs[n] >= 0) {
+		lateness = timeNow - benchmarkLastDispatchMs[n] - periodMs;
+		if (lateness > benchmarkMaxLatenessMs) {
+			benchmarkMaxLatenessMs = lateness;
+		}
+	}
+	benchmarkLastDispatchMs[n] = timeNow;
+	++benchmarkDispatched[n];
+}
+#endif
+
 /**
  * @}
  * @}
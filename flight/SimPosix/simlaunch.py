@@ -0,0 +1,184 @@
+#!/usr/bin/env python
+#
+# Launch several SimPosix vehicles on one host together with a minimal
+# physics stand-in talking to each of them over its shared memory
+# simulation bus (see flight/PiOS.posix/inc/pios_sim.h).
+#
+# Vehicle N uses the shared memory region /openpilot-sim-N and has its UDP
+# ports (telemetry 9000, GPS 9001, ...) offset by N * 10, so the GCS can
+# connect to vehicle N on localhost port 9000 + N * 10.
+#
+# With --lockstep the firmware clock only advances when the stand-in grants
+# a tick, --speed sets the simulated to real time ratio (0 for as fast as
+# possible).
+#
+# (c) 2012, The OpenPilot Team, http://www.openpilot.org
+# See also: The GNU Public License (GPL) Version 3
+#
+
+from __future__ import print_function
+
+import mmap
+import optparse
+import os
+import signal
+import struct
+import subprocess
+import sys
+import time
+
+# Must match pios_sim.h
+SIM_SHM_PREFIX = "/dev/shm/openpilot-sim-"
+SIM_MAGIC = 0x4953504F
+SIM_VERSION = 2
+SIM_RING_LEN = 64
+SIM_NUM_ACTUATORS = 16
+SIM_PORT_STRIDE = 10
+
+HEADER = struct.Struct("<12I")
+SENSORS = struct.Struct("<I16f")
+ACTUATORS = struct.Struct("<I%dH" % SIM_NUM_ACTUATORS)
+OFS_TICK_US = 16
+OFS_TICK_GRANTED = 20
+OFS_TICK_DONE = 24
+OFS_SENSOR_HEAD = 28
+OFS_SENSOR_TAIL = 32
+OFS_ACTUATOR_HEAD = 36
+OFS_ACTUATOR_TAIL = 40
+OFS_ACTUATOR_DROPPED = 44
+OFS_SENSOR_RING = HEADER.size
+OFS_ACTUATOR_RING = OFS_SENSOR_RING + SIM_RING_LEN * SENSORS.size
+BUS_SIZE = OFS_ACTUATOR_RING + SIM_RING_LEN * ACTUATORS.size
+
+
+class Vehicle:
+    """One firmware process and its simulation bus"""
+
+    def __init__(self, instance, firmware, lockstep):
+        self.instance = instance
+        self.ticks = 0
+        self.actuators = (0,) * SIM_NUM_ACTUATORS
+        env = dict(os.environ)
+        env["OP_SIM_INSTANCE"] = str(instance)
+        env["OP_SIM_LOCKSTEP"] = "1" if lockstep else "0"
+        self.process = subprocess.Popen([firmware], env=env,
+                                        stdout=open(os.devnull, "w"))
+        self.bus = None
+
+    def attach(self, timeout):
+        """Wait for the firmware to publish its bus"""
+        path = SIM_SHM_PREFIX + str(self.instance)
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            try:
+                fd = os.open(path, os.O_RDWR)
+                try:
+                    if os.fstat(fd).st_size >= BUS_SIZE:
+                        self.bus = mmap.mmap(fd, BUS_SIZE)
+                finally:
+                    os.close(fd)
+                if self.bus and self.read(0) == SIM_MAGIC:
+                    if self.read(4) != SIM_VERSION:
+                        raise RuntimeError("vehicle %d: bus version mismatch" % self.instance)
+                    return
+            except OSError:
+                pass
+            time.sleep(0.01)
+        raise RuntimeError("vehicle %d: no simulation bus" % self.instance)
+
+    def read(self, offset):
+        return struct.unpack_from("<I", self.bus, offset)[0]
+
+    def write(self, offset, value):
+        struct.pack_into("<I", self.bus, offset, value & 0xffffffff)
+
+    def step(self, sim_time_us):
+        """Exchange one tick worth of data and grant the next tick"""
+        # Publish a sensor sample of a vehicle sitting level on the ground
+        head = self.read(OFS_SENSOR_HEAD)
+        if head - self.read(OFS_SENSOR_TAIL) < SIM_RING_LEN:
+            SENSORS.pack_into(self.bus, OFS_SENSOR_RING + (head % SIM_RING_LEN) * SENSORS.size,
+                              sim_time_us & 0xffffffff,
+                              0.0, 0.0, 0.0,
+                              0.0, 0.0, -9.81,
+                              1.0, 0.0, 0.0,
+                              0.0,
+                              0.0, 0.0, 0.0,
+                              0.0, 0.0, 0.0)
+            self.write(OFS_SENSOR_HEAD, head + 1)
+        # Consume the actuator outputs
+        tail = self.read(OFS_ACTUATOR_TAIL)
+        head = self.read(OFS_ACTUATOR_HEAD)
+        while tail != head:
+            sample = ACTUATORS.unpack_from(self.bus, OFS_ACTUATOR_RING + (tail % SIM_RING_LEN) * ACTUATORS.size)
+            self.actuators = sample[1:]
+            tail = (tail + 1) & 0xffffffff
+        self.write(OFS_ACTUATOR_TAIL, tail)
+        # Grant the next tick
+        self.ticks += 1
+        self.write(OFS_TICK_GRANTED, self.ticks)
+
+    def done(self):
+        return self.read(OFS_TICK_DONE) == (self.ticks & 0xffffffff)
+
+    def stop(self):
+        if self.process.poll() is None:
+            self.process.send_signal(signal.SIGTERM)
+            self.process.wait()
+
+
+def main():
+    parser = optparse.OptionParser(usage="%prog [options] firmware")
+    parser.add_option("-n", "--vehicles", type="int", default=1,
+                      help="number of vehicles to launch")
+    parser.add_option("-l", "--lockstep", action="store_true", default=False,
+                      help="drive the firmware clock from the physics stand-in")
+    parser.add_option("-s", "--speed", type="float", default=1.0,
+                      help="simulated to real time ratio in lockstep mode, 0 for unlimited")
+    parser.add_option("-t", "--time", type="float", default=0,
+                      help="simulated seconds to run, 0 for forever")
+    (options, args) = parser.parse_args()
+    if len(args) != 1:
+        parser.error("firmware not given")
+
+    vehicles = [Vehicle(n, args[0], options.lockstep) for n in range(options.vehicles)]
+    try:
+        for v in vehicles:
+            v.attach(10.0)
+            print("vehicle %d: telemetry on udp port %d" % (v.instance, 9000 + v.instance * SIM_PORT_STRIDE))
+        tick_us = vehicles[0].read(OFS_TICK_US)
+
+        start = time.time()
+        report = start
+        sim_time_us = 0
+        while options.time == 0 or sim_time_us < options.time * 1e6:
+            for v in vehicles:
+                v.step(sim_time_us)
+            sim_time_us += tick_us
+            if options.lockstep:
+                # Every vehicle must have run its tick before time moves on
+                while not all(v.done() for v in vehicles):
+                    pass
+                if options.speed > 0:
+                    delay = start + sim_time_us / 1e6 / options.speed - time.time()
+                    if delay > 0:
+                        time.sleep(delay)
+            else:
+                time.sleep(tick_us / 1e6)
+            now = time.time()
+            if now - report >= 5.0:
+                print("sim time %.1fs, %.2fx real time" % (sim_time_us / 1e6, sim_time_us / 1e6 / (now - start)))
+                for v in vehicles:
+                    dropped = v.read(OFS_ACTUATOR_DROPPED)
+                    if dropped:
+                        print("vehicle %d: %d actuator samples dropped" % (v.instance, dropped))
+                report = now
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for v in vehicles:
+            v.stop()
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -56,17 +56,24 @@ typedef struct {
 
 /**
  * List of object properties that are needed for the periodic updates.
+ * Entries with a non-zero period are also linked into a pairing heap ordered by
+ * timeToNextUpdateMs, so the dispatcher only ever touches entries that are due.
  */
 struct PeriodicObjectListStruct {
 	EventCallbackInfo evInfo; /** Event callback information */
     uint16_t updatePeriodMs; /** Update period in ms or 0 if no periodic updates are needed */
     int32_t timeToNextUpdateMs; /** Time delay to the next update */
     struct PeriodicObjectListStruct* next; /** Needed by linked list library (utlist.h) */
+    struct PeriodicObjectListStruct* heapChild; /** First child in the deadline heap */
+    struct PeriodicObjectListStruct* heapSibling; /** Next sibling in the deadline heap */
+    struct PeriodicObjectListStruct* heapPrev; /** Previous sibling, or parent for a first child, NULL for the root */
+    uint8_t inHeap; /** Set while the entry is linked into the deadline heap */
 };
 typedef struct PeriodicObjectListStruct PeriodicObjectList;
 
 // Private variables
 static PeriodicObjectList* objList;
+static PeriodicObjectList* heapRoot;
 static xQueueHandle queue;
 static xTaskHandle eventTaskHandle;
 static xSemaphoreHandle mutex;
@@ -78,6 +85,11 @@ static void eventTask();
 static int32_t eventPeriodicCreate(UAVObjEvent* ev, UAVObjEventCallback cb, xQueueHandle queue, uint16_t periodMs);
 static int32_t eventPeriodicUpdate(UAVObjEvent* ev, UAVObjEventCallback cb, xQueueHandle queue, uint16_t periodMs);
 static uint16_t randomizePeriod(uint16_t periodMs);
+static PeriodicObjectList* heapMeld(PeriodicObjectList* a, PeriodicObjectList* b);
+static PeriodicObjectList* heapMergePairs(PeriodicObjectList* first);
+static void heapInsert(PeriodicObjectList* objEntry);
+static void heapRemove(PeriodicObjectList* objEntry);
+static void wakeEventTask();
 
 
 /**
@@ -88,6 +100,7 @@ int32_t EventDispatcherInitialize()
 {
 	// Initialize variables
 	objList = NULL;
+	heapRoot = NULL;
 	memset(&stats, 0, sizeof(EventStats));
 
 	// Create mutex
@@ -203,6 +216,7 @@ int32_t EventPeriodicQueueUpdate(UAVObjEvent* ev, xQueueHandle queue, uint16_t p
 static int32_t eventPeriodicCreate(UAVObjEvent* ev, UAVObjEventCallback cb, xQueueHandle queue, uint16_t periodMs)
 {
 	PeriodicObjectList* objEntry;
+	uint8_t wake;
 	// Get lock
 	xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
 	// Check that the object is not already connected
@@ -221,18 +235,37 @@ static int32_t eventPeriodicCreate(UAVObjEvent* ev, UAVObjEventCallback cb, xQue
 	}
     // Create handle
 	objEntry = (PeriodicObjectList*)pvPortMalloc(sizeof(PeriodicObjectList));
-	if (objEntry == NULL) return -1;
+	if (objEntry == NULL)
+	{
+		xSemaphoreGiveRecursive(mutex);
+		return -1;
+	}
 	objEntry->evInfo.ev.obj = ev->obj;
 	objEntry->evInfo.ev.instId = ev->instId;
 	objEntry->evInfo.ev.event = ev->event;
 	objEntry->evInfo.cb = cb;
 	objEntry->evInfo.queue = queue;
     objEntry->updatePeriodMs = periodMs;
-    objEntry->timeToNextUpdateMs = randomizePeriod(periodMs); // avoid bunching of updates
+    objEntry->timeToNextUpdateMs = xTaskGetTickCount()*portTICK_RATE_MS + randomizePeriod(periodMs); // avoid bunching of updates
+    objEntry->heapChild = NULL;
+    objEntry->heapSibling = NULL;
+    objEntry->heapPrev = NULL;
+    objEntry->inHeap = 0;
     // Add to list
     LL_APPEND(objList, objEntry);
+    // Schedule it, if periodic
+    if (periodMs > 0)
+    {
+    	heapInsert(objEntry);
+    }
+    // The new entry may be due before the deadline the event task is sleeping on
+    wake = (heapRoot == objEntry);
 	// Release lock
 	xSemaphoreGiveRecursive(mutex);
+	if (wake)
+	{
+		wakeEventTask();
+	}
     return 0;
 }
 
@@ -247,6 +280,7 @@ static int32_t eventPeriodicCreate(UAVObjEvent* ev, UAVObjEventCallback cb, xQue
 static int32_t eventPeriodicUpdate(UAVObjEvent* ev, UAVObjEventCallback cb, xQueueHandle queue, uint16_t periodMs)
 {
 	PeriodicObjectList* objEntry;
+	uint8_t wake;
 	// Get lock
 	xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
 	// Find object
@@ -258,11 +292,25 @@ static int32_t eventPeriodicUpdate(UAVObjEvent* ev, UAVObjEventCallback cb, xQue
 			objEntry->evInfo.ev.instId == ev->instId &&
 			objEntry->evInfo.ev.event == ev->event)
 		{
-			// Object found, update period
+			// Object found, update period and reschedule
+			if (objEntry->inHeap)
+			{
+				heapRemove(objEntry);
+			}
 			objEntry->updatePeriodMs = periodMs;
-			objEntry->timeToNextUpdateMs = randomizePeriod(periodMs); // avoid bunching of updates
+			objEntry->timeToNextUpdateMs = xTaskGetTickCount()*portTICK_RATE_MS + randomizePeriod(periodMs); // avoid bunching of updates
+			if (periodMs > 0)
+			{
+				heapInsert(objEntry);
+			}
+			// The rescheduled entry may be due before the deadline the event task is sleeping on
+			wake = (heapRoot == objEntry);
 			// Release lock
 			xSemaphoreGiveRecursive(mutex);
+			if (wake)
+			{
+				wakeEventTask();
+			}
 			return 0;
 		}
 	}
@@ -289,7 +337,7 @@ static void eventTask()
 	// Loop forever
 	while (1)
 	{
-		// Calculate delay time
+		// Calculate delay time, sleep exactly until the earliest deadline
 		delayMs = timeToNextUpdateMs-(xTaskGetTickCount()*portTICK_RATE_MS);
 		if (delayMs < 0)
 		{
@@ -299,24 +347,21 @@ static void eventTask()
 		// Wait for queue message
 		if ( xQueueReceive(queue, &evInfo, delayMs/portTICK_RATE_MS) == pdTRUE )
 		{
-			// Invoke callback, if one
+			// Invoke callback, if one (wakeup messages carry none)
 			if ( evInfo.cb != 0)
 			{
 				evInfo.cb(&evInfo.ev); // the function is expected to copy the event information
 			}
 		}
 
-		// Process periodic updates
-		if ((xTaskGetTickCount()*portTICK_RATE_MS) >= timeToNextUpdateMs )
-		{
-			timeToNextUpdateMs = processPeriodicUpdates();
-		}
+		// Process periodic updates, this also picks up deadlines changed while sleeping
+		timeToNextUpdateMs = processPeriodicUpdates();
 	}
 }
 
 /**
- * Handle periodic updates for all objects.
- * \return The system time until the next update (in ms) or -1 if failed
+ * Handle periodic updates for all objects that are due.
+ * \return The system time of the next update (in ms)
  */
 static int32_t processPeriodicUpdates()
 {
@@ -328,43 +373,44 @@ static int32_t processPeriodicUpdates()
 	// Get lock
 	xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
 
-    // Iterate through each object and update its timer, if zero then transmit object.
-    // Also calculate smallest delay to next update.
-    timeToNextUpdate = xTaskGetTickCount()*portTICK_RATE_MS + MAX_UPDATE_PERIOD_MS;
-    LL_FOREACH(objList, objEntry)
+    // Pop due objects off the deadline heap, transmit them and reschedule.
+    // Objects that are not due are never visited.
+    timeNow = xTaskGetTickCount()*portTICK_RATE_MS;
+    while (heapRoot != NULL && heapRoot->timeToNextUpdateMs <= timeNow)
     {
-        // If object is configured for periodic updates
-        if (objEntry->updatePeriodMs > 0)
-        {
-            // Check if time for the next update
-        	timeNow = xTaskGetTickCount()*portTICK_RATE_MS;
-            if (objEntry->timeToNextUpdateMs <= timeNow)
-            {
-                // Reset timer
-            	offset = ( timeNow - objEntry->timeToNextUpdateMs ) % objEntry->updatePeriodMs;
-            	objEntry->timeToNextUpdateMs = timeNow + objEntry->updatePeriodMs - offset;
-    			// Invoke callback, if one
-    			if ( objEntry->evInfo.cb != 0)
-    			{
-    				objEntry->evInfo.cb(&objEntry->evInfo.ev); // the function is expected to copy the event information
-    			}
-    			// Push event to queue, if one
-    			if ( objEntry->evInfo.queue != 0)
-    			{
-    				if ( xQueueSend(objEntry->evInfo.queue, &objEntry->evInfo.ev, 0) != pdTRUE ) // do not block if queue is full
-    				{
-						if (objEntry->evInfo.ev.obj != NULL)
-							stats.lastErrorID = UAVObjGetID(objEntry->evInfo.ev.obj);
-    					++stats.eventErrors;
-    				}
-    			}
-            }
-            // Update minimum delay
-            if (objEntry->timeToNextUpdateMs < timeToNextUpdate)
-            {
-            	timeToNextUpdate = objEntry->timeToNextUpdateMs;
-            }
-        }
+    	objEntry = heapRoot;
+    	heapRemove(objEntry);
+        // Reset timer
+    	offset = ( timeNow - objEntry->timeToNextUpdateMs ) % objEntry->updatePeriodMs;
+    	objEntry->timeToNextUpdateMs = timeNow + objEntry->updatePeriodMs - offset;
+    	heapInsert(objEntry);
+		// Invoke callback, if one
+		if ( objEntry->evInfo.cb != 0)
+		{
+			objEntry->evInfo.cb(&objEntry->evInfo.ev); // the function is expected to copy the event information
+		}
+		// Push event to queue, if one
+		if ( objEntry->evInfo.queue != 0)
+		{
+			if ( xQueueSend(objEntry->evInfo.queue, &objEntry->evInfo.ev, 0) != pdTRUE ) // do not block if queue is full
+			{
+				if (objEntry->evInfo.ev.obj != NULL)
+					stats.lastErrorID = UAVObjGetID(objEntry->evInfo.ev.obj);
+				++stats.eventErrors;
+			}
+		}
+		// Callbacks may take a while, refresh the time
+		timeNow = xTaskGetTickCount()*portTICK_RATE_MS;
+    }
+
+    // The earliest deadline is at the root, idle for at most MAX_UPDATE_PERIOD_MS otherwise
+    if (heapRoot != NULL)
+    {
+    	timeToNextUpdate = heapRoot->timeToNextUpdateMs;
+    }
+    else
+    {
+    	timeToNextUpdate = timeNow + MAX_UPDATE_PERIOD_MS;
     }
 
     // Done
@@ -372,6 +418,149 @@ static int32_t processPeriodicUpdates()
     return timeToNextUpdate;
 }
 
+/**
+ * Wake up the event task so that it recomputes its sleep time. Used when a
+ * periodic entry became the earliest deadline while the task is blocked.
+ */
+static void wakeEventTask()
+{
+	EventCallbackInfo evInfo;
+	memset(&evInfo, 0, sizeof(EventCallbackInfo));
+	xQueueSend(queue, &evInfo, 0); // if the queue is full the task is awake anyway
+}
+
+/**
+ * Link two deadline heaps, the root with the later deadline becomes the first
+ * child of the other.
+ * \param[in] a First heap root or NULL
+ * \param[in] b Second heap root or NULL
+ * \return The new root
+ */
+static PeriodicObjectList* heapMeld(PeriodicObjectList* a, PeriodicObjectList* b)
+{
+	PeriodicObjectList* tmp;
+	if (a == NULL) return b;
+	if (b == NULL) return a;
+	if (b->timeToNextUpdateMs < a->timeToNextUpdateMs)
+	{
+		tmp = a;
+		a = b;
+		b = tmp;
+	}
+	// Make b the first child of a
+	b->heapPrev = a;
+	b->heapSibling = a->heapChild;
+	if (a->heapChild != NULL)
+	{
+		a->heapChild->heapPrev = b;
+	}
+	a->heapChild = b;
+	a->heapSibling = NULL;
+	a->heapPrev = NULL;
+	return a;
+}
+
+/**
+ * Standard two-pass pairing of a sibling list, done iteratively so that the
+ * stack usage of the event task does not depend on the number of objects.
+ * \param[in] first The first heap in the sibling list
+ * \return The root of the merged heap
+ */
+static PeriodicObjectList* heapMergePairs(PeriodicObjectList* first)
+{
+	PeriodicObjectList* a;
+	PeriodicObjectList* b;
+	PeriodicObjectList* next;
+	PeriodicObjectList* pairs = NULL;
+	PeriodicObjectList* result;
+
+	// First pass, meld pairs left to right, chaining the results in reverse order
+	while (first != NULL)
+	{
+		a = first;
+		b = a->heapSibling;
+		if (b != NULL)
+		{
+			next = b->heapSibling;
+			a->heapSibling = NULL;
+			b->heapSibling = NULL;
+			a = heapMeld(a, b);
+		}
+		else
+		{
+			next = NULL;
+		}
+		a->heapSibling = pairs;
+		pairs = a;
+		first = next;
+	}
+
+	// Second pass, meld the pairs right to left
+	result = NULL;
+	while (pairs != NULL)
+	{
+		next = pairs->heapSibling;
+		pairs->heapSibling = NULL;
+		result = heapMeld(result, pairs);
+		pairs = next;
+	}
+	return result;
+}
+
+/**
+ * Add an entry to the deadline heap, keyed by timeToNextUpdateMs.
+ * \param[in] objEntry The entry, must not already be in the heap
+ */
+static void heapInsert(PeriodicObjectList* objEntry)
+{
+	objEntry->heapChild = NULL;
+	objEntry->heapSibling = NULL;
+	objEntry->heapPrev = NULL;
+	objEntry->inHeap = 1;
+	heapRoot = heapMeld(heapRoot, objEntry);
+}
+
+/**
+ * Remove an entry from anywhere in the deadline heap.
+ * \param[in] objEntry The entry, must be in the heap
+ */
+static void heapRemove(PeriodicObjectList* objEntry)
+{
+	PeriodicObjectList* subHeap;
+
+	if (objEntry == heapRoot)
+	{
+		heapRoot = heapMergePairs(objEntry->heapChild);
+		if (heapRoot != NULL)
+		{
+			heapRoot->heapPrev = NULL;
+		}
+	}
+	else
+	{
+		// Unlink from the parent/sibling list
+		if (objEntry->heapPrev->heapChild == objEntry)
+		{
+			objEntry->heapPrev->heapChild = objEntry->heapSibling;
+		}
+		else
+		{
+			objEntry->heapPrev->heapSibling = objEntry->heapSibling;
+		}
+		if (objEntry->heapSibling != NULL)
+		{
+			objEntry->heapSibling->heapPrev = objEntry->heapPrev;
+		}
+		// Merge the children back in
+		subHeap = heapMergePairs(objEntry->heapChild);
+		heapRoot = heapMeld(heapRoot, subHeap);
+	}
+	objEntry->heapChild = NULL;
+	objEntry->heapSibling = NULL;
+	objEntry->heapPrev = NULL;
+	objEntry->inHeap = 0;
+}
+
 /**
  * Return a psedorandom integer from 0 to periodMs
  * Based on the Park-Miller-Carta Pseudo-Random Number Generator
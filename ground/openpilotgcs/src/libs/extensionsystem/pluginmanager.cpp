@@ -37,6 +37,9 @@
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
 #include <QtCore/QWriteLocker>
+#include <QtCore/QThread>
+#include <QtCore/QFile>
+#include <QtCore/QtConcurrentMap>
 #include <QtDebug>
 #ifdef WITH_TESTS
 #include <QTest>
@@ -46,6 +49,40 @@ typedef QList<ExtensionSystem::PluginSpec *> PluginSpecSet;
 
 enum { debugLeaks = 0 };
 
+namespace {
+
+// Reads one plugin spec, run in parallel for all spec files
+struct ReadSpecTask
+{
+    ReadSpecTask(ExtensionSystem::Internal::PluginManagerPrivate *pm) : pm(pm) {}
+
+    void operator()(QPair<ExtensionSystem::PluginSpec *, QString> &spec)
+    {
+        int start = pm->profileTime();
+        ExtensionSystem::Internal::PluginManagerPrivate::privateSpec(spec.first)->read(spec.second);
+        pm->profileEvent(QFileInfo(spec.second).baseName(), QLatin1String("read"), start);
+    }
+
+    ExtensionSystem::Internal::PluginManagerPrivate *pm;
+};
+
+// Maps one plugin library ahead of loadLibrary(), see PluginManagerPrivate::preloadLibraries()
+struct PreloadTask
+{
+    PreloadTask(ExtensionSystem::Internal::PluginManagerPrivate *pm) : pm(pm) {}
+
+    void operator()(ExtensionSystem::PluginSpec *spec)
+    {
+        int start = pm->profileTime();
+        ExtensionSystem::Internal::PluginManagerPrivate::privateSpec(spec)->preloadLibrary();
+        pm->profileEvent(spec->name(), QLatin1String("preload"), start);
+    }
+
+    ExtensionSystem::Internal::PluginManagerPrivate *pm;
+};
+
+} // anonymous namespace
+
 /*!
     \namespace ExtensionSystem
     \brief The ExtensionSystem namespace provides classes that belong to the core plugin system.
@@ -379,6 +416,9 @@ void PluginManager::formatOptions(QTextStream &str, int optionIndentation, int d
     formatOption(str, QLatin1String(OptionsParser::NO_LOAD_OPTION),
                  QLatin1String("plugin"), QLatin1String("Do not load <plugin>"),
                  optionIndentation, descriptionIndentation);
+    formatOption(str, QLatin1String(OptionsParser::PROFILE_OPTION),
+                 QLatin1String("file"), QLatin1String("Write plugin startup times to <file> (Chrome trace format)"),
+                 optionIndentation, descriptionIndentation);
 }
 
 /*!
@@ -490,6 +530,7 @@ PluginSpecPrivate *PluginManagerPrivate::privateSpec(PluginSpec *spec)
 PluginManagerPrivate::PluginManagerPrivate(PluginManager *pluginManager)
     : extension("xml"), q(pluginManager)
 {
+    profileTimer.start();
 }
 
 /*!
@@ -574,6 +615,7 @@ void PluginManagerPrivate::removeObject(QObject *obj)
 void PluginManagerPrivate::loadPlugins()
 {
     QList<PluginSpec *> queue = loadQueue();
+    preloadLibraries(queue);
     foreach (PluginSpec *spec, queue) {
         loadPlugin(spec, PluginSpec::Loaded);
     }
@@ -588,6 +630,34 @@ void PluginManagerPrivate::loadPlugins()
     emit q->pluginsChanged();
     q->m_allPluginsLoaded=true;
     emit q->pluginsLoadEnded();
+
+    if (!profileFile.isEmpty() && !writeProfile(profileFile))
+        qWarning() << "PluginManagerPrivate::loadPlugins(): could not write profile to" << profileFile;
+}
+
+/*!
+    \fn void PluginManagerPrivate::preloadLibraries(const QList<PluginSpec *> &queue)
+    \internal
+    Maps the plugin libraries on worker threads before they are loaded.
+    Plugins are grouped by their depth in the dependency graph and each
+    group is mapped in parallel once all groups below it are done.
+*/
+void PluginManagerPrivate::preloadLibraries(const QList<PluginSpec *> &queue)
+{
+    QHash<PluginSpec *, int> depths;
+    QList<QList<PluginSpec *> > groups;
+    // the queue lists dependencies before their dependents
+    foreach (PluginSpec *spec, queue) {
+        int depth = 0;
+        foreach (PluginSpec *depSpec, spec->dependencySpecs())
+            depth = qMax(depth, depths.value(depSpec) + 1);
+        depths.insert(spec, depth);
+        if (depth == groups.size())
+            groups.append(QList<PluginSpec *>());
+        groups[depth].append(spec);
+    }
+    for (int i = 0; i < groups.size(); ++i)
+        QtConcurrent::blockingMap(groups[i], PreloadTask(this));
 }
 
 /*!
@@ -657,7 +727,9 @@ void PluginManagerPrivate::loadPlugin(PluginSpec *spec, PluginSpec::State destSt
     if (spec->hasError())
         return;
     if (destState == PluginSpec::Running) {
+        int start = profileTime();
         spec->d->initializeExtensions();
+        profileEvent(spec->name(), QLatin1String("extensionsInitialized"), start);
         return;
     } else if (destState == PluginSpec::Deleted) {
         spec->d->kill();
@@ -672,12 +744,16 @@ void PluginManagerPrivate::loadPlugin(PluginSpec *spec, PluginSpec::State destSt
             return;
         }
     }
-    if (destState == PluginSpec::Loaded)
+    int start = profileTime();
+    if (destState == PluginSpec::Loaded) {
         spec->d->loadLibrary();
-    else if (destState == PluginSpec::Initialized)
+        profileEvent(spec->name(), QLatin1String("load"), start);
+    } else if (destState == PluginSpec::Initialized) {
         spec->d->initializePlugin();
-    else if (destState == PluginSpec::Stopped)
+        profileEvent(spec->name(), QLatin1String("initialize"), start);
+    } else if (destState == PluginSpec::Stopped) {
         spec->d->stop();
+    }
 }
 
 /*!
@@ -710,11 +786,13 @@ void PluginManagerPrivate::readPluginPaths()
         foreach (const QFileInfo &subdir, dirs)
             searchPaths << subdir.absoluteFilePath();
     }
+    QList<QPair<PluginSpec *, QString> > specs;
     foreach (const QString &specFile, specFiles) {
         PluginSpec *spec = new PluginSpec;
-        spec->d->read(specFile);
+        specs.append(qMakePair(spec, specFile));
         pluginSpecs.append(spec);
     }
+    QtConcurrent::blockingMap(specs, ReadSpecTask(this));
     resolveDependencies();
     // ensure deterministic plugin load order by sorting
     qSort(pluginSpecs.begin(), pluginSpecs.end(), lessThanByPluginName);
@@ -728,6 +806,61 @@ void PluginManagerPrivate::resolveDependencies()
     }
 }
 
+/*!
+    \fn int PluginManagerPrivate::profileTime()
+    \internal
+*/
+int PluginManagerPrivate::profileTime()
+{
+    return profileTimer.elapsed();
+}
+
+/*!
+    \fn void PluginManagerPrivate::profileEvent(const QString &name, const QString &phase, int start)
+    \internal
+    Records that \a phase of plugin \a name ran from \a start until now.
+*/
+void PluginManagerPrivate::profileEvent(const QString &name, const QString &phase, int start)
+{
+    QMutexLocker locker(&profileMutex);
+    ProfileEvent event;
+    event.name = name;
+    event.phase = phase;
+    event.start = start;
+    event.duration = profileTimer.elapsed() - start;
+    event.thread = quintptr(QThread::currentThreadId());
+    profileEvents.append(event);
+}
+
+/*!
+    \fn bool PluginManagerPrivate::writeProfile(const QString &fileName)
+    \internal
+    Writes the recorded startup profile as Chrome trace events
+    (load it in chrome://tracing).
+*/
+bool PluginManagerPrivate::writeProfile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    QMutexLocker locker(&profileMutex);
+    QTextStream out(&file);
+    out << "{\"traceEvents\":[\n";
+    for (int i = 0; i < profileEvents.size(); ++i) {
+        const ProfileEvent &event = profileEvents.at(i);
+        QString name = event.name;
+        name.replace(QLatin1Char('\\'), QLatin1String("\\\\")).replace(QLatin1Char('"'), QLatin1String("\\\""));
+        out << "{\"name\":\"" << name << "\",\"cat\":\"" << event.phase
+            << "\",\"ph\":\"X\",\"ts\":" << qint64(event.start) * 1000
+            << ",\"dur\":" << qint64(event.duration) * 1000
+            << ",\"pid\":1,\"tid\":" << quint64(event.thread) << "}"
+            << (i + 1 < profileEvents.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+    return true;
+}
+
  // Look in argument descriptions of the specs for the option.
 PluginSpec *PluginManagerPrivate::pluginForOption(const QString &option, bool *requiresArgument) const
 {
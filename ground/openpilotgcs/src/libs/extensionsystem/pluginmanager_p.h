@@ -35,6 +35,8 @@
 #include <QtCore/QSet>
 #include <QtCore/QStringList>
 #include <QtCore/QObject>
+#include <QtCore/QTime>
+#include <QtCore/QMutex>
 
 namespace ExtensionSystem {
 
@@ -60,6 +62,19 @@ public:
     QList<PluginSpec *> loadQueue();
     void loadPlugin(PluginSpec *spec, PluginSpec::State destState);
     void resolveDependencies();
+    void preloadLibraries(const QList<PluginSpec *> &queue);
+
+    // Startup profiler, records the time spent on each plugin per phase
+    struct ProfileEvent {
+        QString name;
+        QString phase;
+        int start;     // ms since the plugin manager was created
+        int duration;
+        quintptr thread;
+    };
+    int profileTime();
+    void profileEvent(const QString &name, const QString &phase, int start);
+    bool writeProfile(const QString &fileName);
 
     QList<PluginSpec *> pluginSpecs;
     QList<PluginSpec *> testSpecs;
@@ -68,6 +83,7 @@ public:
     QList<QObject *> allObjects; // ### make this a QList<QPointer<QObject> > > ?
 
     QStringList arguments;
+    QString profileFile;
 
     // Look in argument descriptions of the specs for the option.
     PluginSpec *pluginForOption(const QString &option, bool *requiresArgument) const;
@@ -79,6 +95,10 @@ public:
 private:
     PluginManager *q;
 
+    QTime profileTimer;
+    QMutex profileMutex;
+    QList<ProfileEvent> profileEvents;
+
     void readPluginPaths();
     bool loadQueue(PluginSpec *spec,
             QList<PluginSpec *> &queue,
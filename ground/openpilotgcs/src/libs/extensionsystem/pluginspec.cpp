@@ -37,6 +37,7 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QXmlStreamReader>
 #include <QtCore/QRegExp>
+#include <QtCore/QLibrary>
 #include <QtCore/QCoreApplication>
 #include <QtDebug>
 
@@ -666,10 +667,12 @@ bool PluginSpecPrivate::provides(const QString &pluginName, const QString &plugi
     \fn QRegExp &PluginSpecPrivate::versionRegExp()
     \internal
 */
+// Plugin specs are read in parallel, so this must not be a function local static
+static QRegExp versionRegExpInstance("([0-9]+)(?:[.]([0-9]+))?(?:[.]([0-9]+))?(?:_([0-9]+))?");
+
 QRegExp &PluginSpecPrivate::versionRegExp()
 {
-    static QRegExp reg("([0-9]+)(?:[.]([0-9]+))?(?:[.]([0-9]+))?(?:_([0-9]+))?");
-    return reg;
+    return versionRegExpInstance;
 }
 /*!
     \fn bool PluginSpecPrivate::isValidVersion(const QString &version)
@@ -677,7 +680,9 @@ QRegExp &PluginSpecPrivate::versionRegExp()
 */
 bool PluginSpecPrivate::isValidVersion(const QString &version)
 {
-    return versionRegExp().exactMatch(version);
+    // match on a copy, the shared instance keeps its captures
+    QRegExp reg = versionRegExp();
+    return reg.exactMatch(version);
 }
 
 /*!
@@ -747,42 +752,66 @@ bool PluginSpecPrivate::resolveDependencies(const QList<PluginSpec *> &specs)
 }
 
 /*!
-    \fn bool PluginSpecPrivate::loadLibrary()
+    \fn QString PluginSpecPrivate::libraryFileName() const
     \internal
 */
-bool PluginSpecPrivate::loadLibrary()
+QString PluginSpecPrivate::libraryFileName() const
 {
-    if (hasError)
-        return false;
-    if (state != PluginSpec::Resolved) {
-        if (state == PluginSpec::Loaded)
-            return true;
-        errorString = QCoreApplication::translate("PluginSpec", "Loading the library failed because state != Resolved");
-        hasError = true;
-        return false;
-    }
 #ifdef QT_NO_DEBUG
 
 #ifdef Q_OS_WIN
-    QString libName = QString("%1/%2.dll").arg(location).arg(name);
+    return QString("%1/%2.dll").arg(location).arg(name);
 #elif defined(Q_OS_MAC)
-    QString libName = QString("%1/lib%2.dylib").arg(location).arg(name);
+    return QString("%1/lib%2.dylib").arg(location).arg(name);
 #else
-    QString libName = QString("%1/lib%2.so").arg(location).arg(name);
+    return QString("%1/lib%2.so").arg(location).arg(name);
 #endif
 
 #else //Q_NO_DEBUG
 
 #ifdef Q_OS_WIN
-    QString libName = QString("%1/%2d.dll").arg(location).arg(name);
+    return QString("%1/%2d.dll").arg(location).arg(name);
 #elif defined(Q_OS_MAC)
-    QString libName = QString("%1/lib%2_debug.dylib").arg(location).arg(name);
+    return QString("%1/lib%2_debug.dylib").arg(location).arg(name);
 #else
-    QString libName = QString("%1/lib%2.so").arg(location).arg(name);
+    return QString("%1/lib%2.so").arg(location).arg(name);
 #endif
 
 #endif
+}
 
+/*!
+    \fn bool PluginSpecPrivate::preloadLibrary()
+    \internal
+    Maps the plugin library without instantiating the plugin, so that this
+    can be done on a worker thread. The library stays loaded, loadLibrary()
+    then only needs to create the plugin instance. Errors are left for
+    loadLibrary() to report.
+*/
+bool PluginSpecPrivate::preloadLibrary()
+{
+    if (hasError || state != PluginSpec::Resolved)
+        return false;
+    QLibrary library(libraryFileName());
+    return library.load();
+}
+
+/*!
+    \fn bool PluginSpecPrivate::loadLibrary()
+    \internal
+*/
+bool PluginSpecPrivate::loadLibrary()
+{
+    if (hasError)
+        return false;
+    if (state != PluginSpec::Resolved) {
+        if (state == PluginSpec::Loaded)
+            return true;
+        errorString = QCoreApplication::translate("PluginSpec", "Loading the library failed because state != Resolved");
+        hasError = true;
+        return false;
+    }
+    QString libName = libraryFileName();
     PluginLoader loader(libName);
     if (!loader.load()) {
         hasError = true;
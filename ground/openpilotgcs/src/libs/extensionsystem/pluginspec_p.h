@@ -52,6 +52,7 @@ public:
     bool read(const QString &fileName);
     bool provides(const QString &pluginName, const QString &version) const;
     bool resolveDependencies(const QList<PluginSpec *> &specs);
+    bool preloadLibrary();
     bool loadLibrary();
     bool initializePlugin();
     bool initializeExtensions();
@@ -87,6 +88,7 @@ private:
     PluginSpec *q;
 
     bool reportError(const QString &err);
+    QString libraryFileName() const;
     void readPluginSpec(QXmlStreamReader &reader);
     void readDependencies(QXmlStreamReader &reader);
     void readDependencyEntry(QXmlStreamReader &reader);
@@ -26,6 +26,14 @@
 #include "../glc_renderstatistics.h"
 #include "../glc_context.h"
 
+#include <QtConcurrentMap>
+
+// Used by finishMeshes
+static void finishMesh(GLC_Mesh*& pMesh)
+{
+	pMesh->finish();
+}
+
 // Class chunk id
 quint32 GLC_Mesh::m_ChunkId= 0xA701;
 
@@ -654,6 +662,13 @@ void GLC_Mesh::finish()
 	//qDebug() << "Mesh mem size= " << memmorySize();
 }
 
+// Finish the given meshes concurrently
+void GLC_Mesh::finishMeshes(QList<GLC_Mesh*> meshes)
+{
+	// finish() only works on the data of its own mesh
+	QtConcurrent::blockingMap(meshes, finishMesh);
+}
+
 
 // Set the lod Index
 void GLC_Mesh::setCurrentLod(const int value)
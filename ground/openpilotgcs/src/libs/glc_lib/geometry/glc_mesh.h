@@ -243,6 +243,10 @@ public:
 	//! Copy vertex list in a vector list for Vertex Array Use
 	void finish();
 
+	//! Finish the given meshes concurrently on the global thread pool
+	/*! The meshes must not be shared with another thread during the call*/
+	static void finishMeshes(QList<GLC_Mesh*> meshes);
+
 	//! Set the lod Index
 	virtual void setCurrentLod(const int);
 
@@ -59,6 +59,7 @@ GLC_3dsToWorld::GLC_3dsToWorld()
 , m_NumberOfMeshes(0)
 , m_CurrentMeshNumber(0)
 , m_ListOfAttachedFileName()
+, m_MeshesToFinish()
 {
 }
 
@@ -142,6 +143,11 @@ GLC_World* GLC_3dsToWorld::CreateWorldFrom3ds(QFile &file)
 	// Free Lib3dsFile and all its ressources
 	lib3ds_file_free(m_pLib3dsFile);
 	m_pLib3dsFile= NULL;
+
+	// Finish the meshes all at once
+	GLC_Mesh::finishMeshes(m_MeshesToFinish);
+	m_MeshesToFinish.clear();
+
 	emit currentQuantum(100);
 	// Create the world bounding box
 	m_pWorld->collection()->boundingBox();
@@ -184,6 +190,7 @@ void GLC_3dsToWorld::clear()
 	m_NumberOfMeshes= 0;
 	m_CurrentMeshNumber= 0;
 	m_ListOfAttachedFileName.clear();
+	m_MeshesToFinish.clear();
 }
 
 // Create meshes from the 3ds File
@@ -226,6 +233,8 @@ void GLC_3dsToWorld::createMeshes(GLC_StructOccurence* pProduct, Lib3dsNode* pFa
 		    	}
 		    	else
 		    	{
+		    		// The mesh is deleted with the representation
+		    		m_MeshesToFinish.removeAll(dynamic_cast<GLC_Mesh*>(representation.geomAt(0)));
 		    		// the instance will be deleted, check material usage
 		    		QSet<GLC_Material*> meshMaterials= representation.materialSet();
 		    		QSet<GLC_Material*>::const_iterator iMat= meshMaterials.constBegin();
@@ -358,7 +367,7 @@ GLC_3DRep GLC_3dsToWorld::create3DRep(Lib3dsMesh* p3dsMesh)
 	}
 	m_PreviousQuantumValue= m_CurrentQuantumValue;
 
-	pMesh->finish();
+	m_MeshesToFinish.append(pMesh);
 	return GLC_3DRep(pMesh);
 }
 
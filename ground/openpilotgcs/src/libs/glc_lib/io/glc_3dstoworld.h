@@ -158,6 +158,9 @@ private:
 	//! The list of attached file name
 	QSet<QString> m_ListOfAttachedFileName;
 
+	//! The meshes which are finished once the file is read
+	QList<GLC_Mesh*> m_MeshesToFinish;
+
 
 
 
@@ -1837,6 +1837,8 @@ void GLC_ColladaToWorld::linkTexturesToMaterials()
 void GLC_ColladaToWorld::createMesh()
 {
 	//qDebug() << "GLC_ColladaToWorld::createMesh()";
+	// The meshes are finished all at once
+	QList<GLC_Mesh*> meshesToFinish;
 	QHash<const QString, MeshInfo*>::iterator iMeshInfo= m_GeometryHash.begin();
 	while (m_GeometryHash.constEnd() != iMeshInfo)
 	{
@@ -1909,14 +1911,19 @@ void GLC_ColladaToWorld::createMesh()
 
 			++iMatInfo;
 		}
-		pCurrentMeshInfo->m_pMesh->finish();
-		GLC_3DRep* pRep= new GLC_3DRep(pCurrentMeshInfo->m_pMesh);
+		GLC_Mesh* pMesh= pCurrentMeshInfo->m_pMesh;
+		GLC_3DRep* pRep= new GLC_3DRep(pMesh);
 		pCurrentMeshInfo->m_pMesh= NULL;
 		pRep->clean();
+		if (!pRep->isEmpty())
+		{
+			meshesToFinish.append(pMesh);
+		}
 		//qDebug() << "Insert Rep : " << iMeshInfo.key();
 		m_3DRepHash.insert(iMeshInfo.key(), pRep);
 		++iMeshInfo;
 	}
+	GLC_Mesh::finishMeshes(meshesToFinish);
 }
 
 // Create the scene graph struct
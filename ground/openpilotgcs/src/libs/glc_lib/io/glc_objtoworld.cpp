@@ -37,6 +37,53 @@
 #include <QFileInfo>
 #include <QGLContext>
 
+//////////////////////////////////////////////////////////////////////
+// Line tokenizer
+//////////////////////////////////////////////////////////////////////
+
+// Find the next token separated by white spaces or by the given separator,
+// the token is a span of the line and is not copied
+static bool nextToken(const QChar*& pPos, const QChar* pEnd, const QChar*& pToken, int& length, QChar separator= QChar(' '))
+{
+	while ((pPos < pEnd) && (pPos->isSpace() || (*pPos == separator))) ++pPos;
+	if (pPos == pEnd) return false;
+	pToken= pPos;
+	while ((pPos < pEnd) && !pPos->isSpace() && (*pPos != separator)) ++pPos;
+	length= static_cast<int>(pPos - pToken);
+	return true;
+}
+
+// Convert a token to float, the conversion doesn't depend on the locale
+static inline bool tokenToFloat(const QChar* pToken, int length, float& value)
+{
+	bool ok;
+	value= QString::fromRawData(pToken, length).toFloat(&ok);
+	return ok;
+}
+
+// Convert a token to int
+static inline bool tokenToInt(const QChar* pToken, int length, int& value)
+{
+	const QChar* pEnd= pToken + length;
+	bool negative= false;
+	if ((pToken < pEnd) && ((*pToken == QChar('-')) || (*pToken == QChar('+'))))
+	{
+		negative= (*pToken == QChar('-'));
+		++pToken;
+	}
+	if (pToken == pEnd) return false;
+	int result= 0;
+	while (pToken < pEnd)
+	{
+		const int digit= pToken->unicode() - '0';
+		if ((digit < 0) || (digit > 9)) return false;
+		result= result * 10 + digit;
+		++pToken;
+	}
+	value= negative ? -result : result;
+	return true;
+}
+
 //////////////////////////////////////////////////////////////////////
 // Constructor
 //////////////////////////////////////////////////////////////////////
@@ -53,6 +100,7 @@ GLC_ObjToWorld::GLC_ObjToWorld()
 , m_Positions()
 , m_Normals()
 , m_Texels()
+, m_MeshesToFinish()
 {
 }
 
@@ -179,6 +227,10 @@ GLC_World* GLC_ObjToWorld::CreateWorldFromObj(QFile &file)
 
 	addCurrentObjMeshToWorld();
 
+	// Finish the meshes all at once
+	GLC_Mesh::finishMeshes(m_MeshesToFinish);
+	m_MeshesToFinish.clear();
+
 	//! Test if there is meshes in the world
 	if (m_pWorld->rootOccurence()->childCount() == 0)
 	{
@@ -235,7 +287,7 @@ void GLC_ObjToWorld::scanLigne(QString &line)
 	if (line.startsWith("v ")|| line.startsWith(QString("v") + QString(QChar(9))))
 	{
 		line.remove(0,2); // Remove first 2 char
-		m_Positions.append(extract3dVect(line));
+		extract3dVect(line, &m_Positions);
 		m_FaceType = notSet;
 	}
 
@@ -243,7 +295,7 @@ void GLC_ObjToWorld::scanLigne(QString &line)
 	else if (line.startsWith("vt ")|| line.startsWith(QString("vt") + QString(QChar(9))))
 	{
 		line.remove(0,3); // Remove first 3 char
-		m_Texels.append(extract2dVect(line));
+		extract2dVect(line, &m_Texels);
 		m_FaceType = notSet;
 	}
 
@@ -251,7 +303,7 @@ void GLC_ObjToWorld::scanLigne(QString &line)
 	else if (line.startsWith("vn ") || line.startsWith(QString("vn") + QString(QChar(9))))
 	{
 		line.remove(0,3); // Remove first 3 char
-		m_Normals.append(extract3dVect(line));
+		extract3dVect(line, &m_Normals);
 		m_FaceType = notSet;
 	}
 
@@ -328,24 +380,18 @@ void GLC_ObjToWorld::changeGroup(QString line)
 }
 
 // Extract a Vector from a string
-QList<float> GLC_ObjToWorld::extract3dVect(QString &line)
+void GLC_ObjToWorld::extract3dVect(const QString &line, QList<float>* pList)
 {
-	float x=0.0f;
-	float y=0.0f;
-	float z=0.0f;
-
-	QList<float> vectResult;
-	QTextStream stringVecteur(&line);
+	const QChar* pPos= line.constData();
+	const QChar* pEnd= pPos + line.size();
+	const QChar* pToken;
+	int length;
+	float vect[3];
 
-	QString xString, yString, zString;
-
-	if (((stringVecteur >> xString >> yString >> zString).status() == QTextStream::Ok))
+	for (int i= 0; i < 3; ++i)
 	{
-		bool xOk, yOk, zOk;
-		x= xString.toFloat(&xOk);
-		y= yString.toFloat(&yOk);
-		z= zString.toFloat(&zOk);
-		if (!(xOk && yOk && zOk))
+		if (!nextToken(pPos, pEnd, pToken, length)) return;
+		if (!tokenToFloat(pToken, length, vect[i]))
 		{
 			QString message= "GLC_ObjToWorld::extract3dVect " + m_FileName + " failed to convert vector component to float";
 			message.append("\nAt ligne : ");
@@ -353,56 +399,39 @@ QList<float> GLC_ObjToWorld::extract3dVect(QString &line)
 			QStringList stringList(m_FileName);
 			stringList.append(message);
 			GLC_ErrorLog::addError(stringList);
-
-			//GLC_FileFormatException fileFormatException(message, m_FileName);
-			//clear();
-			//throw(fileFormatException);
-		}
-		else
-		{
-			vectResult << x << y << z;
+			return;
 		}
 	}
-
-	return vectResult;
-
+	pList->append(vect[0]);
+	pList->append(vect[1]);
+	pList->append(vect[2]);
 }
 
 // Extract a Vector from a string
-QList<float> GLC_ObjToWorld::extract2dVect(QString &line)
+void GLC_ObjToWorld::extract2dVect(const QString &line, QList<float>* pList)
 {
-	float x=0.0f;
-	float y=0.0f;
-	QList<float> vectResult;
-	QTextStream stringVecteur(&line);
+	const QChar* pPos= line.constData();
+	const QChar* pEnd= pPos + line.size();
+	const QChar* pToken;
+	int length;
+	float vect[2];
 
-	QString xString, yString;
-
-	if (((stringVecteur >> xString >> yString).status() == QTextStream::Ok))
+	for (int i= 0; i < 2; ++i)
 	{
-		bool xOk, yOk;
-		x= xString.toFloat(&xOk);
-		y= yString.toFloat(&yOk);
-		if (!(xOk && yOk))
+		if (!nextToken(pPos, pEnd, pToken, length)) return;
+		if (!tokenToFloat(pToken, length, vect[i]))
 		{
-			QString message= "GLC_ObjToWorld::extract2dVect " + m_FileName + " failed to convert vector component to double";
-			message.append("\nAt ligne : ");
-			message.append(QString::number(m_CurrentLineNumber));
-			GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::WrongFileFormat);
-			clear();
-			throw(fileFormatException);
+			throwLineException("GLC_ObjToWorld::extract2dVect " + m_FileName + " failed to convert vector component to double",
+					GLC_FileFormatException::WrongFileFormat);
 		}
-		vectResult << x << y;
 	}
-
-	return vectResult;
+	pList->append(vect[0]);
+	pList->append(vect[1]);
 }
 
 // Extract a face from a string
 void GLC_ObjToWorld::extractFaceIndex(QString &line)
 {
-	QString buff;
-
 	int coordinateIndex;
 	int normalIndex;
 	int textureCoordinateIndex;
@@ -411,11 +440,13 @@ void GLC_ObjToWorld::extractFaceIndex(QString &line)
 	//////////////////////////////////////////////////////////////////
 	// Parse the line containing face index
 	//////////////////////////////////////////////////////////////////
-	QTextStream streamFace(&line);
-	while ((!streamFace.atEnd()))
+	const QChar* pPos= line.constData();
+	const QChar* pEnd= pPos + line.size();
+	const QChar* pToken;
+	int length;
+	while (nextToken(pPos, pEnd, pToken, length))
 	{
-		streamFace >> buff;
-		extractVertexIndex(buff, coordinateIndex, normalIndex, textureCoordinateIndex);
+		extractVertexIndex(pToken, length, coordinateIndex, normalIndex, textureCoordinateIndex);
 
 		ObjVertice currentVertice(coordinateIndex, normalIndex, textureCoordinateIndex);
 		if (m_pCurrentObjMesh->m_ObjVerticeIndexMap.contains(currentVertice))
@@ -577,160 +608,102 @@ void GLC_ObjToWorld::setCurrentMaterial(QString &line)
 	}
 
 }
-// Extract a vertex from a string
-void GLC_ObjToWorld::extractVertexIndex(QString line, int &Coordinate, int &Normal, int &TextureCoordinate)
+// Extract a vertex from a token of a face line
+void GLC_ObjToWorld::extractVertexIndex(const QChar* pToken, int length, int &Coordinate, int &Normal, int &TextureCoordinate)
 {
  	if (m_FaceType == notSet)
  	{
- 		setObjType(line);
+ 		QString ligne(pToken, length);
+ 		setObjType(ligne);
  	}
 
- 	if (m_FaceType == coordinateAndTextureAndNormal)
- 	{
-		// Replace "/" with " "
-		line.replace('/', ' ');
-		QTextStream streamVertex(&line);
-		QString coordinateString, textureCoordinateString, normalString;
-	 	if ((streamVertex >> coordinateString >> textureCoordinateString >> normalString).status() == QTextStream::Ok)
+	// Indexes of the vertex, empty fields between "/" are skipped
+	int values[3];
+	int valueCount= 0;
+	const QChar* pPos= pToken;
+	const QChar* pEnd= pToken + length;
+	const QChar* pField;
+	int fieldLength;
+
+	if (m_FaceType == coordinate)
+	{
+		if (!tokenToInt(pToken, length, values[0]))
 		{
-			bool coordinateOk, textureCoordinateOk, normalOk;
-			Coordinate= coordinateString.toInt(&coordinateOk);
-			--Coordinate;
-			TextureCoordinate= textureCoordinateString.toInt(&textureCoordinateOk);
-			--TextureCoordinate;
-			Normal= normalString.toInt(&normalOk);
-			--Normal;
-			if (!(coordinateOk && textureCoordinateOk && normalOk))
-			{
-				QString message= "GLC_ObjToWorld::extractVertexIndex " + m_FileName + " failed to convert String to int";
-				message.append("\nAt line : ");
-				message.append(QString::number(m_CurrentLineNumber));
-				GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::WrongFileFormat);
-				clear();
-				throw(fileFormatException);
-			}
+			throwLineException("GLC_ObjToWorld::extractVertexIndex "  + m_FileName + " failed to convert String to int",
+					GLC_FileFormatException::WrongFileFormat);
 		}
-		else
+		valueCount= 1;
+	}
+	else
+	{
+		while ((valueCount < 3) && nextToken(pPos, pEnd, pField, fieldLength, QChar('/')))
 		{
-			QString message= "GLC_ObjToWorld::extractVertexIndex Obj file " + m_FileName + " type is not supported";
-			message.append("\nAt line : ");
-			message.append(QString::number(m_CurrentLineNumber));
-			GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::FileNotSupported);
-			clear();
-			throw(fileFormatException);
+			if (!tokenToInt(pField, fieldLength, values[valueCount]))
+			{
+				throwLineException("GLC_ObjToWorld::extractVertexIndex " + m_FileName + " failed to convert String to int",
+						GLC_FileFormatException::WrongFileFormat);
+			}
+			++valueCount;
 		}
+	}
 
+ 	if (m_FaceType == coordinateAndTextureAndNormal)
+ 	{
+ 		if (valueCount < 3)
+ 		{
+			throwLineException("GLC_ObjToWorld::extractVertexIndex Obj file " + m_FileName + " type is not supported",
+					GLC_FileFormatException::FileNotSupported);
+ 		}
+		Coordinate= values[0] - 1;
+		TextureCoordinate= values[1] - 1;
+		Normal= values[2] - 1;
  	}
  	else if (m_FaceType == coordinateAndTexture)
  	{
-		// Replace "/" with " "
-		line.replace('/', ' ');
-		QTextStream streamVertex(&line);
-		QString coordinateString, textureCoordinateString;
-	 	if ((streamVertex >> coordinateString >> textureCoordinateString).status() == QTextStream::Ok)
-		{
-			bool coordinateOk, textureCoordinateOk;
-			Coordinate= coordinateString.toInt(&coordinateOk);
-			--Coordinate;
-			TextureCoordinate= textureCoordinateString.toInt(&textureCoordinateOk);
-			--TextureCoordinate;
-			Normal= -1;
-			if (!(coordinateOk && textureCoordinateOk))
-			{
-				QString message= "GLC_ObjToWorld::extractVertexIndex " + m_FileName +  "failed to convert String to int";
-				message.append("\nAt line : ");
-				message.append(QString::number(m_CurrentLineNumber));
-				GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::WrongFileFormat);
-				clear();
-				throw(fileFormatException);
-			}
-		}
-		else
-		{
-			QString message= "GLC_ObjToWorld::extractVertexIndex " + m_FileName + " this Obj file type is not supported";
-			message.append("\nAt line : ");
-			message.append(QString::number(m_CurrentLineNumber));
-			GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::FileNotSupported);
-			clear();
-			throw(fileFormatException);
-		}
+ 		if (valueCount < 2)
+ 		{
+			throwLineException("GLC_ObjToWorld::extractVertexIndex " + m_FileName + " this Obj file type is not supported",
+					GLC_FileFormatException::FileNotSupported);
+ 		}
+		Coordinate= values[0] - 1;
+		TextureCoordinate= values[1] - 1;
+		Normal= -1;
  	}
  	else if (m_FaceType == coordinateAndNormal)
  	{
-		// Replace "/" with " "
-		line.replace('/', ' ');
-		QTextStream streamVertex(&line);
-		QString coordinateString, normalString;
-	 	if ((streamVertex >> coordinateString >> normalString).status() == QTextStream::Ok)
-		{
-			bool coordinateOk, normalOk;
-			Coordinate= coordinateString.toInt(&coordinateOk);
-			--Coordinate;
-			TextureCoordinate= -1;
-			Normal= normalString.toInt(&normalOk);
-			--Normal;
-			if (!(coordinateOk && normalOk))
-			{
-				QString message= "GLC_ObjToWorld::extractVertexIndex " + m_FileName + " failed to convert String to int";
-				message.append("\nAt line : ");
-				message.append(QString::number(m_CurrentLineNumber));
-				GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::WrongFileFormat);
-				clear();
-				throw(fileFormatException);
-			}
-		}
-		else
-		{
-			QString message= "GLC_ObjToWorld::extractVertexIndex " + m_FileName + " this Obj file type is not supported";
-			message.append("\nAt line : ");
-			message.append(QString::number(m_CurrentLineNumber));
-			GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::FileNotSupported);
-			clear();
-			throw(fileFormatException);
-		}
+ 		if (valueCount < 2)
+ 		{
+			throwLineException("GLC_ObjToWorld::extractVertexIndex " + m_FileName + " this Obj file type is not supported",
+					GLC_FileFormatException::FileNotSupported);
+ 		}
+		Coordinate= values[0] - 1;
+		TextureCoordinate= -1;
+		Normal= values[1] - 1;
  	}
   	else if (m_FaceType == coordinate)
  	{
- 		QTextStream streamVertex(&line);
- 		QString coordinateString;
-	 	if ((streamVertex >> coordinateString).status() == QTextStream::Ok)
-		{
-			bool coordinateOk;
-			Coordinate= coordinateString.toInt(&coordinateOk);
-			--Coordinate;
-			TextureCoordinate= -1;
-			Normal= -1;
-			if (!coordinateOk)
-			{
-				QString message= "GLC_ObjToWorld::extractVertexIndex "  + m_FileName + " failed to convert String to int";
-				message.append("\nAt line : ");
-				message.append(QString::number(m_CurrentLineNumber));
-				GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::WrongFileFormat);
-				clear();
-				throw(fileFormatException);
-			}
-		}
-		else
-		{
-			QString message= "GLC_ObjToWorld::extractVertexIndex Obj " + m_FileName + " file type is not supported";
-			message.append("\nAt line : ");
-			message.append(QString::number(m_CurrentLineNumber));
-			GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::FileNotSupported);
-			clear();
-			throw(fileFormatException);
-		}
+		Coordinate= values[0] - 1;
+		TextureCoordinate= -1;
+		Normal= -1;
  	}
  	else
  	{
-		QString message= "GLC_ObjToWorld::extractVertexIndex OBJ file " + m_FileName + " not reconize";
-		message.append("\nAt line : ");
-		message.append(QString::number(m_CurrentLineNumber));
-		GLC_FileFormatException fileFormatException(message, m_FileName, GLC_FileFormatException::FileNotSupported);
-		clear();
-		throw(fileFormatException);
+		throwLineException("GLC_ObjToWorld::extractVertexIndex OBJ file " + m_FileName + " not reconize",
+				GLC_FileFormatException::FileNotSupported);
  	}
 }
 
+// Throw a file format exception for the current line
+void GLC_ObjToWorld::throwLineException(const QString& message, GLC_FileFormatException::ExceptionType type)
+{
+	QString lineMessage(message);
+	lineMessage.append("\nAt line : ");
+	lineMessage.append(QString::number(m_CurrentLineNumber));
+	GLC_FileFormatException fileFormatException(lineMessage, m_FileName, type);
+	clear();
+	throw(fileFormatException);
+}
+
 // set the OBJ File type
 void GLC_ObjToWorld::setObjType(QString& ligne)
 {
@@ -803,6 +776,7 @@ void GLC_ObjToWorld::clear()
 {
 	m_CurrentMeshMaterials.clear();
 	m_ListOfAttachedFileName.clear();
+	m_MeshesToFinish.clear();
 
 	if (NULL != m_pMtlLoader)
 	{
@@ -875,7 +849,7 @@ void GLC_ObjToWorld::addCurrentObjMeshToWorld()
 			}
 			if (m_pCurrentObjMesh->m_pMesh->faceCount(0) > 0)
 			{
-				m_pCurrentObjMesh->m_pMesh->finish();
+				m_MeshesToFinish.append(m_pCurrentObjMesh->m_pMesh);
 				GLC_3DRep* pRep= new GLC_3DRep(m_pCurrentObjMesh->m_pMesh);
 				m_pWorld->rootOccurence()->addChild((new GLC_StructInstance(pRep)));
 			}
@@ -38,6 +38,7 @@
 #include "../maths/glc_vector2df.h"
 #include "../maths/glc_vector3df.h"
 #include "../geometry/glc_mesh.h"
+#include "../glc_fileformatexception.h"
 
 #include "../glc_config.h"
 
@@ -75,21 +76,19 @@ public:
 	struct ObjVertice
 	{
 		ObjVertice()
-		: m_Values(3)
 		{
 			m_Values[0]= 0;
 			m_Values[1]= 0;
 			m_Values[2]= 0;
 		}
 		ObjVertice(int v1, int v2, int v3)
-		: m_Values(3)
 		{
 			m_Values[0]= v1;
 			m_Values[1]= v2;
 			m_Values[2]= v3;
 		}
 
-		QVector<int> m_Values;
+		int m_Values[3];
 	};
 
 	// Material assignement
@@ -179,11 +178,11 @@ private:
 	//! Change current group
 	void changeGroup(QString);
 
-	//! Extract a 3D Vector from a string
-	QList<float> extract3dVect(QString &);
+	//! Extract a 3D Vector from a string and append it to the list
+	void extract3dVect(const QString &, QList<float>*);
 
-	//! Extract a 2D Vector from a string
-	QList<float> extract2dVect(QString &);
+	//! Extract a 2D Vector from a string and append it to the list
+	void extract2dVect(const QString &, QList<float>*);
 
 	//! Extract a face from a string
 	void extractFaceIndex(QString &);
@@ -191,8 +190,11 @@ private:
 	//! Set Current material index
 	void setCurrentMaterial(QString &line);
 
-	//! Extract a vertex from a string
-	void extractVertexIndex(QString ligne, int &Coordinate, int &Normal, int &TextureCoordinate);
+	//! Extract a vertex from a token of a face line
+	void extractVertexIndex(const QChar* pToken, int length, int &Coordinate, int &Normal, int &TextureCoordinate);
+
+	//! Throw a file format exception for the current line
+	void throwLineException(const QString& message, GLC_FileFormatException::ExceptionType type);
 
 	//! set the OBJ File type
 	void setObjType(QString &);
@@ -256,14 +258,26 @@ private:
 
 	//! The texture coordinate bulk data
 	QList<float> m_Texels;
+
+	//! The meshes which are finished once the file is read
+	QList<GLC_Mesh*> m_MeshesToFinish;
 };
 
 // To use ObjVertice as a QHash key
 inline bool operator==(const GLC_ObjToWorld::ObjVertice& vertice1, const GLC_ObjToWorld::ObjVertice& vertice2)
-{ return (vertice1.m_Values == vertice2.m_Values);}
+{
+	return (vertice1.m_Values[0] == vertice2.m_Values[0])
+		&& (vertice1.m_Values[1] == vertice2.m_Values[1])
+		&& (vertice1.m_Values[2] == vertice2.m_Values[2]);
+}
 
 inline uint qHash(const GLC_ObjToWorld::ObjVertice& vertice)
-{ return qHash(QString::number(vertice.m_Values.at(0)) + QString::number(vertice.m_Values.at(1)) + QString::number(vertice.m_Values.at(2)));}
+{
+	uint hash= static_cast<uint>(vertice.m_Values[0]);
+	hash= hash * 31 + static_cast<uint>(vertice.m_Values[1]);
+	hash= hash * 31 + static_cast<uint>(vertice.m_Values[2]);
+	return hash;
+}
 
 
 #endif /*GLC_OBJTOWORLD_H_*/
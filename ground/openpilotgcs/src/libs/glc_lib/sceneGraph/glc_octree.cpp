@@ -81,12 +81,7 @@ void GLC_Octree::updateSpacePartitioning()
 	delete m_pRootNode;
 	m_pRootNode= new GLC_OctreeNode(m_pCollection->boundingBox(true));
 	// fill the octree
-	QList<GLC_3DViewInstance*> instanceList(m_pCollection->instancesHandle());
-	const int size= instanceList.size();
-	for (int i= 0; i < size; ++i)
-	{
-		m_pRootNode->addInstance(instanceList.at(i), m_OctreeDepth);
-	}
+	m_pRootNode->addInstances(m_pCollection->instancesHandle(), m_OctreeDepth);
 	m_pRootNode->removeEmptyChildren();
 }
 
@@ -23,8 +23,15 @@
 
 #include "glc_octreenode.h"
 
+#include <QtConcurrentRun>
+#include <QFuture>
+#include <QVector>
+
 bool GLC_OctreeNode::m_useBoundingSphere= true;
 
+// Below this number of instances the branches are filled serially
+static const int concurrentInstanceCount= 64;
+
 GLC_OctreeNode::GLC_OctreeNode(const GLC_BoundingBox& boundingBox, GLC_OctreeNode* pParent)
 : m_BoundingBox(boundingBox)
 , m_pParent(pParent)
@@ -176,9 +183,92 @@ void GLC_OctreeNode::addChildren()
 
 
 void GLC_OctreeNode::addInstance(GLC_3DViewInstance* pInstance, int depth)
+{
+	addInstance(pInstance, pInstance->boundingBox(), depth);
+}
+
+void GLC_OctreeNode::addInstances(const QList<GLC_3DViewInstance*>& instances, int depth)
+{
+	const int size= instances.size();
+	// The bounding boxes are computed here, the worker threads don't touch the instances
+	QList<GLC_BoundingBox> boxes;
+	boxes.reserve(size);
+	for (int i= 0; i < size; ++i)
+	{
+		boxes.append(instances.at(i)->boundingBox());
+	}
+
+	if ((0 == depth) || (size < concurrentInstanceCount))
+	{
+		addInstanceList(instances, boxes, depth);
+		return;
+	}
+
+	m_Empty= false;
+	if (m_Children.isEmpty())
+	{
+		addChildren();
+	}
+
+	// Dispatch the instances over this node and its children
+	QVector<QList<GLC_3DViewInstance*> > childInstances(8);
+	QVector<QList<GLC_BoundingBox> > childBoxes(8);
+	for (int i= 0; i < size; ++i)
+	{
+		const GLC_BoundingBox& instanceBox= boxes.at(i);
+		if (instanceBox.isEmpty() || !intersect(instanceBox)) continue;
+
+		bool childIntersect[8];
+		bool allIntersect= true;
+		for (int j= 0; j < 8; ++j)
+		{
+			childIntersect[j]= m_Children.at(j)->intersect(instanceBox);
+			allIntersect= allIntersect && childIntersect[j];
+		}
+		if (allIntersect)
+		{
+			m_3DViewInstanceSet.insert(instances.at(i));
+		}
+		else
+		{
+			for (int j= 0; j < 8; ++j)
+			{
+				if (childIntersect[j])
+				{
+					childInstances[j].append(instances.at(i));
+					childBoxes[j].append(instanceBox);
+				}
+			}
+		}
+	}
+
+	// The children branches don't share any node
+	QList<QFuture<void> > futures;
+	for (int j= 0; j < 8; ++j)
+	{
+		if (!childInstances.at(j).isEmpty())
+		{
+			futures.append(QtConcurrent::run(m_Children.at(j), &GLC_OctreeNode::addInstanceList, childInstances.at(j), childBoxes.at(j), depth - 1));
+		}
+	}
+	for (int j= 0; j < futures.size(); ++j)
+	{
+		futures[j].waitForFinished();
+	}
+}
+
+void GLC_OctreeNode::addInstanceList(const QList<GLC_3DViewInstance*>& instances, const QList<GLC_BoundingBox>& boxes, int depth)
+{
+	const int size= instances.size();
+	for (int i= 0; i < size; ++i)
+	{
+		addInstance(instances.at(i), boxes.at(i), depth);
+	}
+}
+
+void GLC_OctreeNode::addInstance(GLC_3DViewInstance* pInstance, const GLC_BoundingBox& instanceBox, int depth)
 {
 	m_Empty= false;
-	const GLC_BoundingBox instanceBox= pInstance->boundingBox();
 	// Check if the instance's bounding box intersect this node bounding box
 	if (!instanceBox.isEmpty() && intersect(instanceBox))
 	{
@@ -212,7 +302,7 @@ void GLC_OctreeNode::addInstance(GLC_3DViewInstance* pInstance, int depth)
 				{
 					if (childIntersect[i])
 					{
-						m_Children[i]->addInstance(pInstance, depth - 1);
+						m_Children[i]->addInstance(pInstance, instanceBox, depth - 1);
 					}
 				}
 			}
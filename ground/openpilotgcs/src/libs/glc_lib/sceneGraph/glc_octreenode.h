@@ -114,6 +114,10 @@ public:
 	//! Add 3d view instance in this octree node branch
 	void addInstance(GLC_3DViewInstance*, int);
 
+	//! Add the list of 3d view instances in this octree node branch
+	/*! The branches of the children of this node are filled concurrently*/
+	void addInstances(const QList<GLC_3DViewInstance*>&, int);
+
 	//! Update 3d view instances visibility of this octree node branch from the given frustum
 	/*! Viewable 3d view instance are inserted the the given set if exist also the set is created*/
 	void updateViewableInstances(const GLC_Frustum&, QSet<GLC_3DViewInstance*>* pInstanceSet= NULL);
@@ -129,6 +133,12 @@ public:
 // Private services function
 //////////////////////////////////////////////////////////////////////
 private:
+	//! Add 3d view instance with the given bounding box in this octree node branch
+	void addInstance(GLC_3DViewInstance*, const GLC_BoundingBox&, int);
+
+	//! Add 3d view instances with the given bounding boxes in this octree node branch
+	void addInstanceList(const QList<GLC_3DViewInstance*>&, const QList<GLC_BoundingBox>&, int);
+
 	//! Unable the node and sub node view flag
 	void unableViewFlag(QSet<GLC_3DViewInstance*>*);
 
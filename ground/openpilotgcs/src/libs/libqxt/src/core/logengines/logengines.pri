@@ -5,6 +5,10 @@ DEPENDPATH += $$PWD
 HEADERS += $$PWD/qxtabstractfileloggerengine.h $$PWD/qxtabstractiologgerengine.h
 SOURCES += $$PWD/qxtabstractfileloggerengine.cpp $$PWD/qxtabstractiologgerengine.cpp
 
+# Asynchronous Logger Engine
+HEADERS += $$PWD/qxtasyncloggerengine.h
+SOURCES += $$PWD/qxtasyncloggerengine.cpp
+
 # Basic STD Logger Engine
 HEADERS += $$PWD/qxtbasicstdloggerengine.h
 SOURCES += $$PWD/qxtbasicstdloggerengine.cpp
@@ -0,0 +1,362 @@
+/****************************************************************************
+ **
+ ** Copyright (C) Qxt Foundation. Some rights reserved.
+ **
+ ** This file is part of the QxtCore module of the Qxt library.
+ **
+ ** This library is free software; you can redistribute it and/or modify it
+ ** under the terms of the Common Public License, version 1.0, as published
+ ** by IBM, and/or under the terms of the GNU Lesser General Public License,
+ ** version 2.1, as published by the Free Software Foundation.
+ **
+ ** This file is provided "AS IS", without WARRANTIES OR CONDITIONS OF ANY
+ ** KIND, EITHER EXPRESS OR IMPLIED INCLUDING, WITHOUT LIMITATION, ANY
+ ** WARRANTIES OR CONDITIONS OF TITLE, NON-INFRINGEMENT, MERCHANTABILITY OR
+ ** FITNESS FOR A PARTICULAR PURPOSE.
+ **
+ ** You should have received a copy of the CPL and the LGPL along with this
+ ** file. See the LICENSE file and the cpl1.0.txt/lgpl-2.1.txt files
+ ** included with the source distribution for more information.
+ ** If you did not receive a copy of the licenses, contact the Qxt Foundation.
+ **
+ ** <http://libqxt.org>  <foundation@libqxt.org>
+ **
+ ****************************************************************************/
+
+#include "qxtasyncloggerengine.h"
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSemaphore>
+#include <QThread>
+#include <QTime>
+
+/*!
+    \class QxtAsyncLoggerEngine
+    \brief The QxtAsyncLoggerEngine class runs another logger engine on a background thread.
+    \inmodule QxtCore
+
+    QxtAsyncLoggerEngine takes ownership of a target engine and hands every message
+    to it from a writer thread, so the thread that logs never waits for a file or a
+    console. Messages are queued without locking and written in batches, in the order
+    they were logged.
+
+    Identical messages repeated within the suppression interval are counted instead
+    of written, the count is reported once the message changes or the interval has
+    passed.
+
+    \code
+    qxtLog->addLoggerEngine("file", new QxtAsyncLoggerEngine(new QxtBasicFileLoggerEngine("gcs.log")));
+    \endcode
+
+    The target engine is called from the writer thread, so it must not touch objects
+    of other threads and must not be used directly once it is handed over.
+
+    \sa QxtLogger
+ */
+
+struct QxtAsyncLoggerMessage
+{
+    QxtAsyncLoggerMessage *next;
+    QxtLogger::LogLevel level;
+    QList<QVariant> messages;
+};
+
+class QxtAsyncLoggerThread : public QThread
+{
+public:
+    QxtAsyncLoggerThread(QxtAsyncLoggerEnginePrivate *engine) : engine(engine) {}
+
+protected:
+    void run();
+
+private:
+    QxtAsyncLoggerEnginePrivate *engine;
+};
+
+class QxtAsyncLoggerEnginePrivate : public QxtPrivate<QxtAsyncLoggerEngine>
+{
+    QXT_DECLARE_PUBLIC(QxtAsyncLoggerEngine)
+
+public:
+    QxtAsyncLoggerEnginePrivate();
+    ~QxtAsyncLoggerEnginePrivate();
+
+    void push(QxtAsyncLoggerMessage *message);
+    int  writeQueued();
+    void writeMessage(QxtLogger::LogLevel level, const QList<QVariant> &messages);
+    void writeRepeated();
+
+    QxtLoggerEngine *target;
+    QxtAsyncLoggerThread *thread;
+
+    // The loggers push onto a lock free stack, the writer takes all of it at once
+    QAtomicPointer<QxtAsyncLoggerMessage> queue;
+    QSemaphore pending;
+    QAtomicInt stopping;
+
+    // Everything below is guarded by target_lock
+    mutable QMutex target_lock;
+    int suppress_interval;
+    QxtLogger::LogLevel last_level;
+    QList<QVariant> last_messages;
+    int repeat_count;
+    QTime last_written;
+};
+
+QxtAsyncLoggerEnginePrivate::QxtAsyncLoggerEnginePrivate()
+        : target(0), queue(0), stopping(0), suppress_interval(1000),
+          last_level(QxtLogger::NoLevels), repeat_count(0)
+{
+    thread = new QxtAsyncLoggerThread(this);
+}
+
+QxtAsyncLoggerEnginePrivate::~QxtAsyncLoggerEnginePrivate()
+{
+    delete thread;
+    delete target;
+}
+
+/*!
+    \internal
+    Pushes \a message onto the queue. Only the message that finds the queue
+    empty wakes the writer, the others are picked up with the same batch.
+ */
+void QxtAsyncLoggerEnginePrivate::push(QxtAsyncLoggerMessage *message)
+{
+    QxtAsyncLoggerMessage *head;
+    do
+    {
+        head = queue;
+        message->next = head;
+    }
+    while (!queue.testAndSetRelease(head, message));
+
+    if (!head) pending.release();
+}
+
+/*!
+    \internal
+    Writes all queued messages, must be called with target_lock held.
+    Returns the milliseconds until a pending repeat count is due, or -1.
+ */
+int QxtAsyncLoggerEnginePrivate::writeQueued()
+{
+    // The stack holds the newest message first
+    QxtAsyncLoggerMessage *message = queue.fetchAndStoreAcquire(0);
+    QxtAsyncLoggerMessage *batch = 0;
+    while (message)
+    {
+        QxtAsyncLoggerMessage *next = message->next;
+        message->next = batch;
+        batch = message;
+        message = next;
+    }
+
+    while (batch)
+    {
+        QxtAsyncLoggerMessage *next = batch->next;
+        writeMessage(batch->level, batch->messages);
+        delete batch;
+        batch = next;
+    }
+
+    if (repeat_count == 0) return -1;
+    int elapsed = last_written.elapsed();
+    if (elapsed < suppress_interval) return suppress_interval - elapsed;
+    writeRepeated();
+    return -1;
+}
+
+/*!
+    \internal
+    Writes \a messages with \a level unless they repeat the last ones.
+ */
+void QxtAsyncLoggerEnginePrivate::writeMessage(QxtLogger::LogLevel level, const QList<QVariant> &messages)
+{
+    if (suppress_interval > 0 && level == last_level && messages == last_messages)
+    {
+        repeat_count++;
+        if (last_written.elapsed() >= suppress_interval) writeRepeated();
+        return;
+    }
+
+    writeRepeated();
+    last_level = level;
+    last_messages = messages;
+    last_written.start();
+    if (target->isInitialized()) target->writeFormatted(level, messages);
+}
+
+/*!
+    \internal
+    Reports how often the last message was suppressed.
+ */
+void QxtAsyncLoggerEnginePrivate::writeRepeated()
+{
+    if (repeat_count == 0) return;
+    QList<QVariant> messages;
+    messages << QString("Last message repeated %1 times").arg(repeat_count);
+    repeat_count = 0;
+    last_written.start();
+    if (target->isInitialized()) target->writeFormatted(last_level, messages);
+}
+
+void QxtAsyncLoggerThread::run()
+{
+    int wait = -1;
+    while (!engine->stopping)
+    {
+        engine->pending.tryAcquire(1, wait);
+        QMutexLocker lock(&engine->target_lock);
+        wait = engine->writeQueued();
+    }
+}
+
+/*!
+    Constructs an asynchronous logger engine for \a target. The engine takes
+    ownership of \a target and starts out with its log levels.
+ */
+QxtAsyncLoggerEngine::QxtAsyncLoggerEngine(QxtLoggerEngine *target)
+{
+    QXT_INIT_PRIVATE(QxtAsyncLoggerEngine);
+    Q_ASSERT(target);
+    qxt_d().target = target;
+    QxtLoggerEngine::setLoggingEnabled(target->isLoggingEnabled());
+    for (int bit = QxtLogger::TraceLevel; bit <= QxtLogger::WriteLevel; bit <<= 1)
+    {
+        QxtLogger::LogLevel level = QxtLogger::LogLevel(bit);
+        QxtLoggerEngine::setLogLevelsEnabled(level, target->isLogLevelEnabled(level));
+    }
+    qxt_d().thread->start(QThread::LowPriority);
+}
+
+/*!
+    Writes the messages still queued, stops the writer thread and deletes the target engine.
+ */
+QxtAsyncLoggerEngine::~QxtAsyncLoggerEngine()
+{
+    qxt_d().stopping.fetchAndStoreOrdered(1);
+    qxt_d().pending.release();
+    qxt_d().thread->wait();
+    flush();
+}
+
+/*!
+    \reimp
+ */
+void QxtAsyncLoggerEngine::initLoggerEngine()
+{
+    QMutexLocker lock(&qxt_d().target_lock);
+    qxt_d().target->initLoggerEngine();
+}
+
+/*!
+    \reimp
+    The queued messages are written before the target engine is killed.
+ */
+void QxtAsyncLoggerEngine::killLoggerEngine()
+{
+    QMutexLocker lock(&qxt_d().target_lock);
+    qxt_d().writeQueued();
+    qxt_d().writeRepeated();
+    qxt_d().target->killLoggerEngine();
+}
+
+/*!
+    \reimp
+    The state of the target engine is checked by the writer thread, this
+    engine itself is ready as long as the writer thread runs.
+ */
+bool QxtAsyncLoggerEngine::isInitialized() const
+{
+    return qxt_d().thread->isRunning();
+}
+
+/*!
+    \reimp
+    Queues \a messages with given \a level and returns immediately.
+
+    Critical and fatal messages are written before this function returns,
+    after the messages queued so far. A fatal message is followed by abort(),
+    so it would never reach the writer thread.
+ */
+void QxtAsyncLoggerEngine::writeFormatted(QxtLogger::LogLevel level, const QList<QVariant> &messages)
+{
+    if (level == QxtLogger::CriticalLevel || level == QxtLogger::FatalLevel)
+    {
+        // The writer thread already holds the lock if the target itself failed
+        bool locked = QThread::currentThread() != qxt_d().thread;
+        if (locked) qxt_d().target_lock.lock();
+        qxt_d().writeQueued();
+        qxt_d().writeRepeated();
+        if (qxt_d().target->isInitialized()) qxt_d().target->writeFormatted(level, messages);
+        if (locked) qxt_d().target_lock.unlock();
+        return;
+    }
+
+    QxtAsyncLoggerMessage *message = new QxtAsyncLoggerMessage;
+    message->level = level;
+    message->messages = messages;
+    qxt_d().push(message);
+}
+
+/*!
+    \reimp
+    Enables or disables logging for the target engine as well.
+ */
+void QxtAsyncLoggerEngine::setLoggingEnabled(bool enable)
+{
+    QxtLoggerEngine::setLoggingEnabled(enable);
+    QMutexLocker lock(&qxt_d().target_lock);
+    qxt_d().target->setLoggingEnabled(enable);
+}
+
+/*!
+    \reimp
+    Enables or disables \a levels for the target engine as well.
+ */
+void QxtAsyncLoggerEngine::setLogLevelsEnabled(QxtLogger::LogLevels levels, bool enable)
+{
+    QxtLoggerEngine::setLogLevelsEnabled(levels, enable);
+    QMutexLocker lock(&qxt_d().target_lock);
+    qxt_d().target->setLogLevelsEnabled(levels, enable);
+}
+
+/*!
+    Returns the engine the messages are written to.
+ */
+QxtLoggerEngine *QxtAsyncLoggerEngine::targetEngine() const
+{
+    return qxt_d().target;
+}
+
+/*!
+    Returns the interval in milliseconds within which repeated messages are suppressed.
+ */
+int QxtAsyncLoggerEngine::suppressInterval() const
+{
+    QMutexLocker lock(&qxt_d().target_lock);
+    return qxt_d().suppress_interval;
+}
+
+/*!
+    Sets the interval in milliseconds within which repeated messages are
+    suppressed to \a msecs. An interval of 0 writes every message.
+ */
+void QxtAsyncLoggerEngine::setSuppressInterval(int msecs)
+{
+    QMutexLocker lock(&qxt_d().target_lock);
+    qxt_d().suppress_interval = msecs;
+}
+
+/*!
+    Writes all queued messages from the calling thread and returns when they are written.
+ */
+void QxtAsyncLoggerEngine::flush()
+{
+    QMutexLocker lock(&qxt_d().target_lock);
+    qxt_d().writeQueued();
+    qxt_d().writeRepeated();
+}
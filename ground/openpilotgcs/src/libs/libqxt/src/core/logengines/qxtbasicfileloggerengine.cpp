@@ -83,20 +83,21 @@ void QxtBasicFileLoggerEngine::writeToFile(const QString &level, const QVariantL
 {
     if (messages.isEmpty()) return;
     QString header = '[' + QDateTime::currentDateTime().toString(qxt_d().dateFormat) + "] [" + level + "] ";
-    QString padding;
+    QString padding(header.size(), ' ');
     QIODevice* file = device();
     Q_ASSERT(file);
-    file->write(header.toUtf8());
-    for (int i = 0; i < header.size(); i++) padding.append(" ");
+    // The file is unbuffered, so the whole entry is converted and written at once
+    QString text = header;
     int count = 0;
     Q_FOREACH(const QVariant& out, messages)
     {
         if (!out.isNull())
         {
-            if (count != 0) file->write(padding.toUtf8());
-            file->write(out.toString().toUtf8());
-            file->write("\n");
+            if (count != 0) text += padding;
+            text += out.toString();
+            text += '\n';
         }
         count++;
     }
+    file->write(text.toUtf8());
 }
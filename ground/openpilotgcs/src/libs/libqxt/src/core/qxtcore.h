@@ -30,6 +30,7 @@
 #include "qxtabstractiologgerengine.h"
 #include "qxtabstractsignalserializer.h"
 #include "qxtalgorithms.h"
+#include "qxtasyncloggerengine.h"
 #include "qxtbasicfileloggerengine.h"
 #include "qxtbasicstdloggerengine.h"
 #include "qxtboundcfunction.h"
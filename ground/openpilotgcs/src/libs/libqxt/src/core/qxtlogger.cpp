@@ -134,6 +134,7 @@
 Constructor for QxtLogger's private data
 *******************************************************************************/
 QxtLoggerPrivate::QxtLoggerPrivate()
+        : levelSerial(-1), levelMask(0)
 {
     mut_lock = new QMutex(QMutex::Recursive);
 }
@@ -166,6 +167,37 @@ void QxtLoggerPrivate::log(QxtLogger::LogLevel level, const QList<QVariant>& msg
     }
 }
 
+/*******************************************************************************
+    Changed whenever an engine is added or removed or changes its log levels
+*******************************************************************************/
+QAtomicInt QxtLoggerPrivate::engineSerial(0);
+
+/*******************************************************************************
+    Checks if any enabled engine logs the given level. The union of the engine
+    levels is cached and only rebuilt after engineSerial changed, so messages
+    nobody is listening to are dropped without taking the lock.
+*******************************************************************************/
+bool QxtLoggerPrivate::isLogLevelEnabled(QxtLogger::LogLevel level) const
+{
+    int serial = engineSerial;
+    if (serial != levelSerial)
+    {
+        QMutexLocker lock(mut_lock);
+        int mask = 0;
+        Q_FOREACH(QxtLoggerEngine *eng, map_logEngineMap)
+        {
+            if (!eng || !eng->isLoggingEnabled()) continue;
+            for (int bit = QxtLogger::TraceLevel; bit <= QxtLogger::WriteLevel; bit <<= 1)
+            {
+                if (eng->isLogLevelEnabled(QxtLogger::LogLevel(bit))) mask |= bit;
+            }
+        }
+        levelMask.fetchAndStoreOrdered(mask);
+        levelSerial.fetchAndStoreOrdered(serial);
+    }
+    return (levelMask & level);
+}
+
 void QxtLoggerPrivate::setQxtLoggerEngineMinimumLevel(QxtLoggerEngine *eng, QxtLogger::LogLevel level)
 {
     QMutexLocker lock(mut_lock);
@@ -284,7 +316,7 @@ QxtLogStream QxtLogger::write()
 */
 void QxtLogger::info(const QVariant &message, const QVariant &msg1, const QVariant &msg2, const QVariant &msg3, const QVariant &msg4, const QVariant &msg5, const QVariant &msg6, const QVariant &msg7, const QVariant &msg8 , const QVariant &msg9)
 {
-    QMutexLocker lock(qxt_d().mut_lock);
+    if (!qxt_d().isLogLevelEnabled(QxtLogger::InfoLevel)) return;
     QList<QVariant> args;
     args.push_back(message);
     if (!msg1.isNull()) args.push_back(msg1);
@@ -308,7 +340,7 @@ void QxtLogger::info(const QVariant &message, const QVariant &msg1, const QVaria
 */
 void QxtLogger::trace(const QVariant &message, const QVariant &msg1 , const QVariant &msg2 , const QVariant &msg3 , const QVariant &msg4 , const QVariant &msg5 , const QVariant &msg6 , const QVariant &msg7 , const QVariant &msg8 , const QVariant &msg9)
 {
-    QMutexLocker lock(qxt_d().mut_lock);
+    if (!qxt_d().isLogLevelEnabled(QxtLogger::TraceLevel)) return;
     QList<QVariant> args;
     args.push_back(message);
     if (!msg1.isNull()) args.push_back(msg1);
@@ -331,7 +363,7 @@ void QxtLogger::trace(const QVariant &message, const QVariant &msg1 , const QVar
 */
 void QxtLogger::warning(const QVariant &message, const QVariant &msg1 , const QVariant &msg2 , const QVariant &msg3 , const QVariant &msg4 , const QVariant &msg5 , const QVariant &msg6 , const QVariant &msg7 , const QVariant &msg8 , const QVariant &msg9)
 {
-    QMutexLocker lock(qxt_d().mut_lock);
+    if (!qxt_d().isLogLevelEnabled(QxtLogger::WarningLevel)) return;
     QList<QVariant> args;
     args.push_back(message);
     if (!msg1.isNull()) args.push_back(msg1);
@@ -354,7 +386,7 @@ void QxtLogger::warning(const QVariant &message, const QVariant &msg1 , const QV
 */
 void QxtLogger::error(const QVariant &message, const QVariant &msg1 , const QVariant &msg2 , const QVariant &msg3 , const QVariant &msg4 , const QVariant &msg5 , const QVariant &msg6 , const QVariant &msg7 , const QVariant &msg8 , const QVariant &msg9)
 {
-    QMutexLocker lock(qxt_d().mut_lock);
+    if (!qxt_d().isLogLevelEnabled(QxtLogger::ErrorLevel)) return;
     QList<QVariant> args;
     args.push_back(message);
     if (!msg1.isNull()) args.push_back(msg1);
@@ -377,7 +409,7 @@ void QxtLogger::error(const QVariant &message, const QVariant &msg1 , const QVar
 */
 void QxtLogger::debug(const QVariant &message, const QVariant &msg1 , const QVariant &msg2 , const QVariant &msg3 , const QVariant &msg4 , const QVariant &msg5 , const QVariant &msg6 , const QVariant &msg7 , const QVariant &msg8 , const QVariant &msg9)
 {
-    QMutexLocker lock(qxt_d().mut_lock);
+    if (!qxt_d().isLogLevelEnabled(QxtLogger::DebugLevel)) return;
     QList<QVariant> args;
     args.push_back(message);
     if (!msg1.isNull()) args.push_back(msg1);
@@ -400,7 +432,7 @@ void QxtLogger::debug(const QVariant &message, const QVariant &msg1 , const QVar
 */
 void QxtLogger::write(const QVariant &message, const QVariant &msg1 , const QVariant &msg2, const QVariant &msg3 , const QVariant &msg4 , const QVariant &msg5 , const QVariant &msg6 , const QVariant &msg7 , const QVariant &msg8 , const QVariant &msg9)
 {
-    QMutexLocker lock(qxt_d().mut_lock);
+    if (!qxt_d().isLogLevelEnabled(QxtLogger::WriteLevel)) return;
     QList<QVariant> args;
     args.push_back(message);
     if (!msg1.isNull()) args.push_back(msg1);
@@ -423,7 +455,7 @@ void QxtLogger::write(const QVariant &message, const QVariant &msg1 , const QVar
 */
 void QxtLogger::critical(const QVariant &message, const QVariant &msg1 , const QVariant &msg2 , const QVariant &msg3 , const QVariant &msg4 , const QVariant &msg5 , const QVariant &msg6 , const QVariant &msg7 , const QVariant &msg8 , const QVariant &msg9)
 {
-    QMutexLocker lock(qxt_d().mut_lock);
+    if (!qxt_d().isLogLevelEnabled(QxtLogger::CriticalLevel)) return;
     QList<QVariant> args;
     args.push_back(message);
     if (!msg1.isNull()) args.push_back(msg1);
@@ -446,7 +478,7 @@ void QxtLogger::critical(const QVariant &message, const QVariant &msg1 , const Q
 */
 void QxtLogger::fatal(const QVariant &message, const QVariant &msg1 , const QVariant &msg2 , const QVariant &msg3 , const QVariant &msg4 , const QVariant &msg5 , const QVariant &msg6 , const QVariant &msg7 , const QVariant &msg8 , const QVariant &msg9)
 {
-    QMutexLocker lock(qxt_d().mut_lock);
+    if (!qxt_d().isLogLevelEnabled(QxtLogger::FatalLevel)) return;
     QList<QVariant> args;
     args.push_back(message);
     if (!msg1.isNull()) args.push_back(msg1);
@@ -544,6 +576,7 @@ void QxtLogger::log(LogLevel level, const QList<QVariant>& args)
     QMutexLocker lock(qxt_d().mut_lock);
     qxt_d().log(level, msgList);
     */
+    if (!qxt_d().isLogLevelEnabled(level)) return;
     QMetaObject::invokeMethod(&qxt_d(), "log", Qt::AutoConnection, Q_ARG(QxtLogger::LogLevel, level), Q_ARG(QList<QVariant>, args));
 }
 
@@ -892,6 +925,21 @@ void QxtLogger::killLoggerEngine(const QString &engineName)
         }
     }
 }
+/*! \brief Checks if any enabled Engine has the given LogLevel enabled.
+    Messages of a level no Engine logs are dropped before any work is done,
+    callers can use this to skip building expensive messages as well.
+    \code
+    if (qxtLog->isLogLevelEnabled(QxtLogger::TraceLevel))
+        qxtLog->trace(dumpState());
+    \endcode
+    \a level           A LogLevel to query.
+    Returns true or false.
+*/
+bool QxtLogger::isLogLevelEnabled(LogLevel level) const
+{
+    return qxt_d().isLogLevelEnabled(level);
+}
+
 /*! \brief Checks if the named Engine has the given LogLevel enabled.
     \a engineName  The name of a QxtLoggerEngine to query
     \a level           A LogLevel or LogLevels to disable.
@@ -957,6 +1005,7 @@ void QxtLogger::addLoggerEngine(const QString &engineName, QxtLoggerEngine *engi
     if (!qxt_d().map_logEngineMap.contains(engineName) && engine)
     {
         qxt_d().map_logEngineMap.insert(engineName, engine);
+        QxtLoggerPrivate::engineSerial.ref();
         emit loggerEngineAdded(engineName);
     }
 }
@@ -1028,6 +1077,7 @@ QxtLoggerEngine *QxtLogger::takeLoggerEngine(const QString &engineName)
     QMutexLocker lock(qxt_d().mut_lock);
     QxtLoggerEngine *eng = qxt_d().map_logEngineMap.take(engineName);
     if (!eng) return NULL;
+    QxtLoggerPrivate::engineSerial.ref();
     emit loggerEngineRemoved(engineName);
     return eng;
 }
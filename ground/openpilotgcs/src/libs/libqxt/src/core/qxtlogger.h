@@ -93,6 +93,7 @@ public:
     QStringList allEnabledLoggerEngines(LogLevel level) const;
     QStringList allDisabledLoggerEngines() const;
 
+    bool   isLogLevelEnabled(LogLevel level) const;
     bool   isLogLevelEnabled(const QString& engineName, LogLevel level) const;
     bool   isLoggerEngine(const QString& engineName) const;
     bool   isLoggerEngineEnabled(const QString& engineName) const;
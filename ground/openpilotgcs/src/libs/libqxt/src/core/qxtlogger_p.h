@@ -28,6 +28,7 @@
 
 #include "qxtlogger.h"
 #include <QHash>
+#include <QAtomicInt>
 
 /*******************************************************************************
     QxtLoggerPrivate
@@ -43,9 +44,14 @@ public:
     QxtLoggerPrivate();
     ~QxtLoggerPrivate();
     void setQxtLoggerEngineMinimumLevel(QxtLoggerEngine *engine, QxtLogger::LogLevel level);
+    bool isLogLevelEnabled(QxtLogger::LogLevel level) const;
     QHash<QString, QxtLoggerEngine*> map_logEngineMap;
     QMutex* mut_lock;
 
+    static QAtomicInt engineSerial;
+    mutable QAtomicInt levelSerial;
+    mutable QAtomicInt levelMask;
+
 public Q_SLOTS:
     void log(QxtLogger::LogLevel, const QList<QVariant>&);
 };
@@ -24,6 +24,7 @@
  ****************************************************************************/
 
 #include "qxtloggerengine.h"
+#include "qxtlogger_p.h"
 
 /*! \class QxtLoggerEngine
     \brief The QxtLoggerEngine class is the parent class of all extended Engine Plugins.
@@ -129,6 +130,7 @@ void QxtLoggerEngine::disableLogging()
 void QxtLoggerEngine::setLoggingEnabled(bool enable)
 {
     qxt_d().b_isLogging = enable;
+    QxtLoggerPrivate::engineSerial.ref();
 }
 
 /*!
@@ -144,6 +146,7 @@ void QxtLoggerEngine::setLogLevelsEnabled(QxtLogger::LogLevels levels, bool enab
     {
         qxt_d().bm_logLevel &= ~levels;
     }
+    QxtLoggerPrivate::engineSerial.ref();
 }
 
 /*!
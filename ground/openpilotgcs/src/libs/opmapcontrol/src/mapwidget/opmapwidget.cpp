@@ -34,7 +34,7 @@ namespace mapcontrol
 {
 
     OPMapWidget::OPMapWidget(QWidget *parent, Configuration *config):QGraphicsView(parent),configuration(config),UAV(0),GPS(0),Home(0)
-      ,followmouse(true),compass(0),showuav(false),showhome(false),diagTimer(0),diagGraphItem(0),showDiag(false),overlayOpacity(1)
+      ,followmouse(true),compass(0),showuav(false),showhome(false),diagTimer(0),diagGraphItem(0),showDiag(false),overlayOpacity(1),insertBatch(0),insertBatchLast(-1)
     {
         setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
         core=new internals::Core;
@@ -289,8 +289,7 @@ namespace mapcontrol
         item->SetNumber(position);
         ConnectWP(item);
         item->setParentItem(map);
-        emit WPInserted(position,item);
-        setOverlayOpacity(overlayOpacity);
+        WPInsertNotify(position,item);
         return item;
     }
     void OPMapWidget::WPInsert(WayPointItem* item,const int &position)
@@ -298,8 +297,7 @@ namespace mapcontrol
         item->SetNumber(position);
         ConnectWP(item);
         item->setParentItem(map);
-        emit WPInserted(position,item);
-        setOverlayOpacity(overlayOpacity);
+        WPInsertNotify(position,item);
     }
     WayPointItem* OPMapWidget::WPInsert(internals::PointLatLng const& coord,int const& altitude,const int &position)
     {
@@ -307,15 +305,14 @@ namespace mapcontrol
         item->SetNumber(position);
         ConnectWP(item);
         item->setParentItem(map);
-        emit WPInserted(position,item);
-        setOverlayOpacity(overlayOpacity);
+        WPInsertNotify(position,item);
         return item;
     }
     WayPointItem* OPMapWidget::WPInsert(internals::PointLatLng const& coord,int const& altitude, QString const& description,const int &position)
     {
         internals::PointLatLng mcoord;
         bool reloc=false;
-        if(mcoord==internals::PointLatLng(0,0))
+        if(coord==internals::PointLatLng(0,0))
         {
             mcoord=CurrentPosition();
             reloc=true;
@@ -326,10 +323,9 @@ namespace mapcontrol
         item->SetNumber(position);
         ConnectWP(item);
         item->setParentItem(map);
-        emit WPInserted(position,item);
+        WPInsertNotify(position,item);
         if(reloc)
             emit WPValuesChanged(item);
-        setOverlayOpacity(overlayOpacity);
         return item;
     }
     WayPointItem* OPMapWidget::WPInsert(distBearingAltitude const& relative, QString const& description,const int &position)
@@ -338,10 +334,39 @@ namespace mapcontrol
         item->SetNumber(position);
         ConnectWP(item);
         item->setParentItem(map);
-        emit WPInserted(position,item);
-        setOverlayOpacity(overlayOpacity);
+        WPInsertNotify(position,item);
         return item;
     }
+    void OPMapWidget::WPInsertNotify(int const& position,WayPointItem* item)
+    {
+        if(insertBatch==0)
+        {
+            emit WPInserted(position,item);
+            setOverlayOpacity(overlayOpacity);
+            return;
+        }
+        // Only WayPoints with a number from position up are renumbered,
+        // there are none when appending behind the last one
+        if(position<=insertBatchLast)
+        {
+            emit WPInserted(position,item);
+            ++insertBatchLast;
+        }
+        else
+            insertBatchLast=position;
+    }
+    void OPMapWidget::WPBeginInsert()
+    {
+        if(insertBatch++>0)
+            return;
+        QMap<int,WayPointItem*> items=WPAll();
+        insertBatchLast=items.isEmpty()?-1:items.lastKey();
+    }
+    void OPMapWidget::WPEndInsert()
+    {
+        if(insertBatch>0 && --insertBatch==0)
+            setOverlayOpacity(overlayOpacity);
+    }
     void OPMapWidget::WPDelete(WayPointItem *item)
     {
         emit WPDeleted(item->Number(),item);
@@ -378,6 +403,17 @@ namespace mapcontrol
         }
         return NULL;
     }
+    QMap<int,WayPointItem*> OPMapWidget::WPAll()
+    {
+        QMap<int,WayPointItem*> items;
+        foreach(QGraphicsItem* i,map->childItems())
+        {
+            WayPointItem* w=qgraphicsitem_cast<WayPointItem*>(i);
+            if(w && w->Number()!=-1)
+                items.insert(w->Number(),w);
+        }
+        return items;
+    }
     void OPMapWidget::WPSetVisibleAll(bool value)
     {
         foreach(QGraphicsItem* i,map->childItems())
@@ -324,6 +324,17 @@ namespace mapcontrol
         */
         WayPointItem* WPInsert(internals::PointLatLng const& coord,int const& altitude, QString const& description,int const& position);
         WayPointItem *WPInsert(const distBearingAltitude &relative, const QString &description, const int &position);
+        /**
+        * @brief Starts inserting a batch of WayPoints. Until WPEndInsert the overlay
+        * opacity is not reapplied after each WayPoint and WayPoints appended behind
+        * the last one are not announced with WPInserted, as nothing is renumbered.
+        * This keeps inserting thousands of WayPoints linear.
+        */
+        void WPBeginInsert();
+        /**
+        * @brief Ends a batch started with WPBeginInsert
+        */
+        void WPEndInsert();
 
         /**
         * @brief Deletes the WayPoint
@@ -374,6 +385,12 @@ namespace mapcontrol
         bool WPPresent();
         void WPDelete(int number);
         WayPointItem *WPFind(int number);
+        /**
+        * @brief Returns all WayPoints except the magic WayPoint
+        *
+        * @return QMap<int,WayPointItem *> the WayPoints by number
+        */
+        QMap<int,WayPointItem*> WPAll();
         void setSelectedWP(QList<WayPointItem *> list);
       private:
         internals::Core *core;
@@ -386,6 +403,7 @@ namespace mapcontrol
         internals::PointLatLng currentmouseposition;
         bool followmouse;
         void ConnectWP(WayPointItem* item);
+        void WPInsertNotify(int const& position,WayPointItem* item);
         QGraphicsSvgItem *compass;
         bool showuav;
         bool showhome;
@@ -393,6 +411,8 @@ namespace mapcontrol
         QGraphicsTextItem * diagGraphItem;
         bool showDiag;
         qreal overlayOpacity;
+        int insertBatch;
+        int insertBatchLast;
     private slots:
         void diagRefresh();
         //   WayPointItem* item;//apagar
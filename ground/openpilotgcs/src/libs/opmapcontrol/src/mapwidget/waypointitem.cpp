@@ -49,7 +49,10 @@ WayPointItem::WayPointItem(const internals::PointLatLng &coord,int const& altitu
         {
             HomeItem* h=qgraphicsitem_cast <HomeItem*>(obj);
             if(h)
+            {
                 myHome=h;
+                break;
+            }
         }
 
         if(myHome)
@@ -96,7 +99,10 @@ WayPointItem::WayPointItem(MapGraphicItem *map, bool magicwaypoint):reached(fals
     {
         HomeItem* h=qgraphicsitem_cast <HomeItem*>(obj);
         if(h)
+        {
             myHome=h;
+            break;
+        }
     }
 
     if(myHome)
@@ -130,7 +136,10 @@ WayPointItem::WayPointItem(MapGraphicItem *map, bool magicwaypoint):reached(fals
         {
             HomeItem* h=qgraphicsitem_cast <HomeItem*>(obj);
             if(h)
+            {
                 myHome=h;
+                break;
+            }
         }
         if(myHome)
         {
@@ -152,7 +161,10 @@ WayPointItem::WayPointItem(MapGraphicItem *map, bool magicwaypoint):reached(fals
         {
             HomeItem* h=qgraphicsitem_cast <HomeItem*>(obj);
             if(h)
-               myHome=h;
+            {
+                myHome=h;
+                break;
+            }
         }
         if(myHome)
         {
@@ -37,6 +37,145 @@ static int verifyRange( int size, int &i1, int &i2 )
     return ( i2 - i1 + 1 );
 }
 
+/*
+  Contiguous x/y arrays of the series, when the data is stored that way.
+  They are read directly instead of through the virtual sample().
+ */
+static bool qwtRawSamples( const QwtSeriesData<QPointF> *series,
+    const double *&xData, const double *&yData )
+{
+    const QwtPointArrayData *arrayData =
+        dynamic_cast<const QwtPointArrayData *>( series );
+    if ( arrayData )
+    {
+        xData = arrayData->xData().constData();
+        yData = arrayData->yData().constData();
+        return true;
+    }
+
+    const QwtCPointerData *pointerData =
+        dynamic_cast<const QwtCPointerData *>( series );
+    if ( pointerData )
+    {
+        xData = pointerData->xData();
+        yData = pointerData->yData();
+        return true;
+    }
+
+    return false;
+}
+
+static inline bool qwtIsLinear( const QwtScaleMap &map )
+{
+    return map.transformation()->type() == QwtScaleTransformation::Linear;
+}
+
+/*
+  Map the raw arrays in one pass. For linear maps the factors are
+  hoisted out of the loop, which leaves a loop the compiler can unroll
+  and vectorize.
+ */
+static void qwtTransformRaw( const double *xData, const double *yData,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    bool doAlign, QPointF *points, int size )
+{
+    if ( qwtIsLinear( xMap ) && qwtIsLinear( yMap ) )
+    {
+        const double xs1 = xMap.s1();
+        const double xp1 = xMap.p1();
+        const double xcnv = ( xMap.s2() != xMap.s1() ) ?
+            ( xMap.p2() - xMap.p1() ) / ( xMap.s2() - xMap.s1() ) : 0.0;
+
+        const double ys1 = yMap.s1();
+        const double yp1 = yMap.p1();
+        const double ycnv = ( yMap.s2() != yMap.s1() ) ?
+            ( yMap.p2() - yMap.p1() ) / ( yMap.s2() - yMap.s1() ) : 0.0;
+
+        if ( doAlign )
+        {
+            for ( int i = 0; i < size; i++ )
+            {
+                points[i].rx() = qRound( xp1 + ( xData[i] - xs1 ) * xcnv );
+                points[i].ry() = qRound( yp1 + ( yData[i] - ys1 ) * ycnv );
+            }
+        }
+        else
+        {
+            for ( int i = 0; i < size; i++ )
+            {
+                points[i].rx() = xp1 + ( xData[i] - xs1 ) * xcnv;
+                points[i].ry() = yp1 + ( yData[i] - ys1 ) * ycnv;
+            }
+        }
+        return;
+    }
+
+    for ( int i = 0; i < size; i++ )
+    {
+        double x = xMap.transform( xData[i] );
+        double y = yMap.transform( yData[i] );
+        if ( doAlign )
+        {
+            x = qRound( x );
+            y = qRound( y );
+        }
+
+        points[i].rx() = x;
+        points[i].ry() = y;
+    }
+}
+
+static inline int qwtOutcode( const QPointF &p, const QRectF &rect )
+{
+    int code = 0;
+    if ( p.x() < rect.left() )
+        code |= 1;
+    else if ( p.x() > rect.right() )
+        code |= 2;
+    if ( p.y() < rect.top() )
+        code |= 4;
+    else if ( p.y() > rect.bottom() )
+        code |= 8;
+
+    return code;
+}
+
+/*
+  Drop the inner points of runs, that lie beyond the same edge of
+  the clip rectangle. The lines between them never enter the rectangle,
+  so the visible part of the polyline doesn't change, but the clipper and
+  the paint engine get much less points, when most of the curve is
+  scrolled or zoomed out of the canvas.
+ */
+static void qwtCullPolyline( QPolygonF &polyline, const QRectF &rect )
+{
+    QPointF *points = polyline.data();
+    const int size = polyline.size();
+    if ( size < 3 )
+        return;
+
+    int n = 1;
+    int code0 = qwtOutcode( points[0], rect );
+    int code1 = code0;
+    for ( int i = 1; i < size; i++ )
+    {
+        const int code = qwtOutcode( points[i], rect );
+        if ( n >= 2 && ( code & code1 & code0 ) )
+        {
+            points[n - 1] = points[i];
+            code1 = code;
+        }
+        else
+        {
+            points[n++] = points[i];
+            code0 = code1;
+            code1 = code;
+        }
+    }
+
+    polyline.resize( n );
+}
+
 class QwtPlotCurve::PrivateData
 {
 public:
@@ -71,6 +210,9 @@ public:
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    // Reused by drawLines() to avoid an allocation on every repaint
+    QPolygonF polyline;
 };
 
 /*!
@@ -387,33 +529,55 @@ void QwtPlotCurve::drawLines( QPainter *painter,
 
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
-    QPolygonF polyline( size );
+    QPolygonF &polyline = d_data->polyline;
+    if ( polyline.capacity() < size )
+        polyline.reserve( size );
+    polyline.resize( size );
 
     QPointF *points = polyline.data();
-    for ( int i = from; i <= to; i++ )
-    {
-        const QPointF sample = d_series->sample( i );
 
-        double x = xMap.transform( sample.x() );
-        double y = yMap.transform( sample.y() );
-        if ( doAlign )
+    const double *xData;
+    const double *yData;
+    if ( qwtRawSamples( d_series, xData, yData ) )
+    {
+        qwtTransformRaw( xData + from, yData + from,
+            xMap, yMap, doAlign, points, size );
+    }
+    else
+    {
+        for ( int i = from; i <= to; i++ )
         {
-            x = qRound( x );
-            y = qRound( y );
-        }
+            const QPointF sample = d_series->sample( i );
 
-        points[i - from].rx() = x;
-        points[i - from].ry() = y;
+            double x = xMap.transform( sample.x() );
+            double y = yMap.transform( sample.y() );
+            if ( doAlign )
+            {
+                x = qRound( x );
+                y = qRound( y );
+            }
+
+            points[i - from].rx() = x;
+            points[i - from].ry() = y;
+        }
     }
 
-    if ( ( d_data->attributes & Fitted ) && d_data->curveFitter )
+    const bool doFit = ( d_data->attributes & Fitted ) && d_data->curveFitter;
+    if ( doFit )
         polyline = d_data->curveFitter->fitCurve( polyline );
 
     if ( d_data->paintAttributes & ClipPolygons )
     {
         qreal pw = qMax( qreal( 1.0 ), painter->pen().widthF());
+        const QRectF clipRect = canvasRect.adjusted(-pw, -pw, pw, pw);
+
+        // The fill is closed against the baseline, so points outside
+        // of the canvas still matter, when there is a brush
+        if ( !doFit && d_data->brush.style() == Qt::NoBrush )
+            qwtCullPolyline( polyline, clipRect );
+
         const QPolygonF clipped = QwtClipper::clipPolygonF( 
-            canvasRect.adjusted(-pw, -pw, pw, pw), polyline, false );
+            clipRect, polyline, false );
 
         QwtPainter::drawPolyline( painter, clipped );
     }
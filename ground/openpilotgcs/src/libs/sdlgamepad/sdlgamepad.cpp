@@ -175,6 +175,20 @@ void SDLGamepad::quit()
 {
   loop = false;
 }
+/**********************************************************************/
+bool SDLGamepad::suspend()
+{
+  bool running = isRunning();
+  loop = false;
+  wait();
+  return running;
+}
+/**********************************************************************/
+void SDLGamepad::resume()
+{
+  loop = true;
+  start();
+}
 
 /**********************************************************************/
 qint16 SDLGamepad::getAxes()
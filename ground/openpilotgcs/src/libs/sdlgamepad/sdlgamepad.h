@@ -182,6 +182,25 @@ class SDLGAMEPADSHARED_EXPORT SDLGamepad : public QThread
      */
     qint16 getButtons();
 
+    /**
+     * Stop the thread and wait for it.
+     *
+     * Signals delivered with a direct connection run on this thread,
+     * once this returns no such slot is running and the receiver can
+     * be disconnected and deleted safely.
+     *
+     * @see resume()
+     * @return True if the thread was running.
+     */
+    bool suspend();
+
+    /**
+     * Restart the thread after suspend().
+     *
+     * @see suspend()
+     */
+    void resume();
+
   public slots:
 
     /**
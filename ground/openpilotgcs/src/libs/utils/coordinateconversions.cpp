@@ -258,4 +258,129 @@ void CoordinateConversions::Quaternion2R(const float q[4], float Rbe[3][3])
 }
 
 
+// ****** batch conversions ********
+
+#define WGS84_A     6378137.0                   // Equatorial Radius
+#define WGS84_E     8.1819190842622e-2          // Eccentricity
+#define WGS84_E2    (WGS84_E * WGS84_E)
+
+/**
+  * Precompute the home location for the batch NED conversions
+  * @param[in] LLA latitude longitude altitude of the home location
+  * @param[out] home the home reference, the rotation is kept in double precision
+  */
+void CoordinateConversions::SetHome(const double LLA[3], HomeReference &home)
+{
+    double sinLat = sin(DEG2RAD*LLA[0]);
+    double sinLon = sin(DEG2RAD*LLA[1]);
+    double cosLat = cos(DEG2RAD*LLA[0]);
+    double cosLon = cos(DEG2RAD*LLA[1]);
+
+    for (int i = 0; i < 3; i++)
+        home.LLA[i] = LLA[i];
+    LLA2ECEF(1, &LLA[0], &LLA[1], &LLA[2], &home.ECEF[0], &home.ECEF[1], &home.ECEF[2]);
+
+    home.Rne[0][0] = -sinLat*cosLon; home.Rne[0][1] = -sinLat*sinLon; home.Rne[0][2] = cosLat;
+    home.Rne[1][0] = -sinLon;        home.Rne[1][1] = cosLon;         home.Rne[1][2] = 0;
+    home.Rne[2][0] = -cosLat*cosLon; home.Rne[2][1] = -cosLat*sinLon; home.Rne[2][2] = -sinLat;
+}
+
+/**
+  * Convert n points from LLA coordinates to ECEF coordinates
+  */
+void CoordinateConversions::LLA2ECEF(int n, const double *lat, const double *lon, const double *alt, double *x, double *y, double *z)
+{
+    for (int i = 0; i < n; i++) {
+        double sinLat = sin(DEG2RAD*lat[i]);
+        double sinLon = sin(DEG2RAD*lon[i]);
+        double cosLat = cos(DEG2RAD*lat[i]);
+        double cosLon = cos(DEG2RAD*lon[i]);
+        double h = alt[i];
+
+        double N = WGS84_A / sqrt(1.0 - WGS84_E2*sinLat*sinLat);  //prime vertical radius of curvature
+
+        x[i] = (N + h)*cosLat*cosLon;
+        y[i] = (N + h)*cosLat*sinLon;
+        z[i] = ((1 - WGS84_E2)*N + h)*sinLat;
+    }
+}
+
+/**
+  * Convert n points from ECEF coordinates to LLA coordinates.
+  * Uses the closed form solution by Heikkinen (1982) instead of the iteration
+  * in ECEF2LLA(), the result agrees to well below a millimetre for anything
+  * from the earth's surface up to orbital heights.
+  */
+void CoordinateConversions::ECEF2LLA(int n, const double *x, const double *y, const double *z, double *lat, double *lon, double *alt)
+{
+    const double a2 = WGS84_A*WGS84_A;
+    const double b = WGS84_A*sqrt(1 - WGS84_E2);
+    const double b2 = b*b;
+    const double ep2 = (a2 - b2)/b2;    // second eccentricity squared
+
+    for (int i = 0; i < n; i++) {
+        double X = x[i], Y = y[i], Z = z[i];
+        double Z2 = Z*Z;
+        double p2 = X*X + Y*Y;
+        double p = sqrt(p2);
+
+        double F = 54*b2*Z2;
+        double G = p2 + (1 - WGS84_E2)*Z2 - WGS84_E2*(a2 - b2);
+        double c = WGS84_E2*WGS84_E2*F*p2/(G*G*G);
+        double s = cbrt(1 + c + sqrt(c*c + 2*c));
+        double k = s + 1 + 1/s;
+        double P = F/(3*k*k*G*G);
+        double Q = sqrt(1 + 2*WGS84_E2*WGS84_E2*P);
+        double r0sq = a2/2*(1 + 1/Q) - P*(1 - WGS84_E2)*Z2/(Q*(1 + Q)) - P*p2/2;
+        double r0 = -P*WGS84_E2*p/(1 + Q) + sqrt(r0sq > 0 ? r0sq : 0);
+        double t = p - WGS84_E2*r0;
+        double U = sqrt(t*t + Z2);
+        double V = sqrt(t*t + (1 - WGS84_E2)*Z2);
+        double z0 = b2*Z/(WGS84_A*V);
+
+        lat[i] = RAD2DEG*atan2(Z + ep2*z0, p);
+        lon[i] = RAD2DEG*atan2(Y, X);
+        alt[i] = U*(1 - b2/(WGS84_A*V));
+    }
+}
+
+/**
+  * Convert n points from LLA coordinates to NED offsets from the home location
+  */
+void CoordinateConversions::LLA2NED(const HomeReference &home, int n, const double *lat, const double *lon, const double *alt,
+                                    double *north, double *east, double *down)
+{
+    LLA2ECEF(n, lat, lon, alt, north, east, down);
+
+    const double (*Rne)[3] = home.Rne;
+    for (int i = 0; i < n; i++) {
+        double dx = north[i] - home.ECEF[0];
+        double dy = east[i] - home.ECEF[1];
+        double dz = down[i] - home.ECEF[2];
+
+        north[i] = Rne[0][0]*dx + Rne[0][1]*dy + Rne[0][2]*dz;
+        east[i]  = Rne[1][0]*dx + Rne[1][1]*dy + Rne[1][2]*dz;
+        down[i]  = Rne[2][0]*dx + Rne[2][1]*dy + Rne[2][2]*dz;
+    }
+}
+
+/**
+  * Convert n NED offsets from the home location to LLA coordinates
+  */
+void CoordinateConversions::NED2LLA(const HomeReference &home, int n, const double *north, const double *east, const double *down,
+                                    double *lat, double *lon, double *alt)
+{
+    /* P = ECEF + Rne' * NED */
+    const double (*Rne)[3] = home.Rne;
+    for (int i = 0; i < n; i++) {
+        double N = north[i], E = east[i], D = down[i];
+
+        lat[i] = home.ECEF[0] + Rne[0][0]*N + Rne[1][0]*E + Rne[2][0]*D;
+        lon[i] = home.ECEF[1] + Rne[0][1]*N + Rne[1][1]*E + Rne[2][1]*D;
+        alt[i] = home.ECEF[2] + Rne[0][2]*N + Rne[1][2]*E + Rne[2][2]*D;
+    }
+
+    ECEF2LLA(n, lat, lon, alt, lat, lon, alt);
+}
+
 }
@@ -37,9 +37,23 @@
 
 namespace Utils {
 
+/**
+ * The batch functions convert n points at once. Each coordinate is passed as
+ * its own array so the arithmetic runs over contiguous doubles and can be
+ * vectorized by the compiler, the outputs may be the same arrays as the inputs.
+ * There is no hand written SIMD code, the GCS is built for several
+ * architectures and compilers.
+ */
 class QTCREATOR_UTILS_EXPORT CoordinateConversions
 {
 public:
+    // Home location with its ECEF position and ECEF to NED rotation
+    struct HomeReference {
+        double LLA[3];
+        double ECEF[3];
+        double Rne[3][3];
+    };
+
     CoordinateConversions();
     int NED2LLA_HomeECEF(double BaseECEFcm[3], double NED[3], double position[3]);
     int NED2LLA_HomeLLA(double LLA[3], double NED[3], double position[3]);
@@ -50,6 +64,15 @@ public:
     void Quaternion2RPY(const float q[4], float rpy[3]);
     void RPY2Quaternion(const float rpy[3], float q[4]);
     void Quaternion2R(const float q[4], float Rbe[3][3]);
+
+    // Batch conversions
+    void SetHome(const double LLA[3], HomeReference &home);
+    void LLA2ECEF(int n, const double *lat, const double *lon, const double *alt, double *x, double *y, double *z);
+    void ECEF2LLA(int n, const double *x, const double *y, const double *z, double *lat, double *lon, double *alt);
+    void LLA2NED(const HomeReference &home, int n, const double *lat, const double *lon, const double *alt,
+                 double *north, double *east, double *down);
+    void NED2LLA(const HomeReference &home, int n, const double *north, const double *east, const double *down,
+                 double *lat, double *lon, double *alt);
 };
 
 }
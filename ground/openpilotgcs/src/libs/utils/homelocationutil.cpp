@@ -69,8 +69,11 @@ HomeLocationUtil::HomeLocationUtil()
 
         QDateTime dt = QDateTime::currentDateTime().toUTC();
 
-        //Fetch world magnetic model
-        Q_ASSERT(WorldMagModel().GetMagVector(LLA, dt.date().month(), dt.date().day(), dt.date().year(), Be) >= 0);
+        //Fetch world magnetic model, kept so the coefficients are only computed once a day
+        static WorldMagModel magModel;
+        int ret = magModel.GetMagVector(LLA, dt.date().month(), dt.date().day(), dt.date().year(), Be);
+        Q_ASSERT(ret >= 0);
+        if (ret < 0) return -6;
 
         return 0;	// OK
     }
@@ -0,0 +1,11 @@
+CONFIG += qtestlib
+TEMPLATE = app
+CONFIG -= app_bundle
+TARGET = tst_coordinateconversions
+
+# Input
+
+include(../../../../../openpilotgcs.pri)
+include(../../utils.pri)
+
+SOURCES += tst_coordinateconversions.cpp
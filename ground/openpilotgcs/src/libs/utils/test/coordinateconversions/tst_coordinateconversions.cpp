@@ -0,0 +1,220 @@
+/**
+ ******************************************************************************
+ *
+ * @file       tst_coordinateconversions.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      Accuracy and speed of the batch coordinate conversions
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   
+ * @{
+ * 
+ *****************************************************************************/
+/* 
+ * This program is free software; you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation; either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License 
+ * for more details.
+ * 
+ * You should have received a copy of the GNU General Public License along 
+ * with this program; if not, write to the Free Software Foundation, Inc., 
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include <utils/coordinateconversions.h>
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+using namespace Utils;
+
+#define POINTS 10000
+
+class tst_CoordinateConversions : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void lla2ecef();
+    void ecef2lla();
+    void ecef2llaPoles();
+    void ned2lla();
+    void nedRoundTrip();
+    void benchmarkECEF2LLAScalar();
+    void benchmarkECEF2LLABatch();
+    void benchmarkNED2LLAScalar();
+    void benchmarkNED2LLABatch();
+
+private:
+    QVector<double> lat, lon, alt;
+    QVector<double> x, y, z;
+    QVector<double> north, east, down;
+    double home[3];
+    double homeECEF[3];
+};
+
+void tst_CoordinateConversions::initTestCase()
+{
+    // Points all over the globe from below sea level up to orbital heights
+    qsrand(1);
+    lat.resize(POINTS); lon.resize(POINTS); alt.resize(POINTS);
+    x.resize(POINTS); y.resize(POINTS); z.resize(POINTS);
+    north.resize(POINTS); east.resize(POINTS); down.resize(POINTS);
+    for (int i = 0; i < POINTS; i++) {
+        lat[i] = qrand() * 180.0 / RAND_MAX - 90;
+        lon[i] = qrand() * 360.0 / RAND_MAX - 180;
+        alt[i] = qrand() * 1001000.0 / RAND_MAX - 1000;
+        double LLA[3] = { lat[i], lon[i], alt[i] };
+        double ECEF[3];
+        CoordinateConversions().LLA2ECEF(LLA, ECEF);
+        x[i] = ECEF[0];
+        y[i] = ECEF[1];
+        z[i] = ECEF[2];
+
+        // Offsets around the home location as seen by the map
+        north[i] = qrand() * 20000.0 / RAND_MAX - 10000;
+        east[i] = qrand() * 20000.0 / RAND_MAX - 10000;
+        down[i] = qrand() * 2000.0 / RAND_MAX - 1500;
+    }
+
+    home[0] = 47.3;
+    home[1] = 8.5;
+    home[2] = 500;
+    CoordinateConversions().LLA2ECEF(home, homeECEF);
+}
+
+void tst_CoordinateConversions::lla2ecef()
+{
+    QVector<double> bx(POINTS), by(POINTS), bz(POINTS);
+    CoordinateConversions().LLA2ECEF(POINTS, lat.constData(), lon.constData(), alt.constData(),
+                                     bx.data(), by.data(), bz.data());
+    for (int i = 0; i < POINTS; i++) {
+        QVERIFY(qAbs(bx[i] - x[i]) < 1e-6);
+        QVERIFY(qAbs(by[i] - y[i]) < 1e-6);
+        QVERIFY(qAbs(bz[i] - z[i]) < 1e-6);
+    }
+}
+
+void tst_CoordinateConversions::ecef2lla()
+{
+    QVector<double> blat(POINTS), blon(POINTS), balt(POINTS);
+    CoordinateConversions().ECEF2LLA(POINTS, x.constData(), y.constData(), z.constData(),
+                                     blat.data(), blon.data(), balt.data());
+    for (int i = 0; i < POINTS; i++) {
+        double ECEF[3] = { x[i], y[i], z[i] };
+        double LLA[3];
+        CoordinateConversions().ECEF2LLA(ECEF, LLA);
+        QVERIFY(qAbs(blat[i] - LLA[0]) < 1e-9);
+        QVERIFY(qAbs(blon[i] - LLA[1]) < 1e-9);
+        QVERIFY(qAbs(balt[i] - LLA[2]) < 1e-4);
+        QVERIFY(qAbs(blat[i] - lat[i]) < 1e-9);
+        QVERIFY(qAbs(balt[i] - alt[i]) < 1e-4);
+    }
+}
+
+void tst_CoordinateConversions::ecef2llaPoles()
+{
+    double plat[4] = { 90, -90, 90, 0 };
+    double plon[4] = { 0, 0, 0, 0 };
+    double palt[4] = { 0, 100, 1e6, -1000 };
+    double px[4], py[4], pz[4];
+    CoordinateConversions().LLA2ECEF(4, plat, plon, palt, px, py, pz);
+    CoordinateConversions().ECEF2LLA(4, px, py, pz, px, py, pz);
+    for (int i = 0; i < 4; i++) {
+        QVERIFY(qAbs(px[i] - plat[i]) < 1e-9);
+        QVERIFY(qAbs(pz[i] - palt[i]) < 1e-4);
+    }
+}
+
+void tst_CoordinateConversions::ned2lla()
+{
+    CoordinateConversions::HomeReference ref;
+    CoordinateConversions().SetHome(home, ref);
+    for (int i = 0; i < 3; i++)
+        QVERIFY(qAbs(ref.ECEF[i] - homeECEF[i]) < 1e-6);
+
+    QVector<double> blat(POINTS), blon(POINTS), balt(POINTS);
+    CoordinateConversions().NED2LLA(ref, POINTS, north.constData(), east.constData(), down.constData(),
+                                    blat.data(), blon.data(), balt.data());
+    for (int i = 0; i < POINTS; i++) {
+        double NED[3] = { north[i], east[i], down[i] };
+        double LLA[3];
+        CoordinateConversions().NED2LLA_HomeECEF(homeECEF, NED, LLA);
+        // The scalar version uses a float rotation matrix, allow for a millimetre
+        QVERIFY(qAbs(blat[i] - LLA[0]) < 1e-8);
+        QVERIFY(qAbs(blon[i] - LLA[1]) < 1e-8);
+        QVERIFY(qAbs(balt[i] - LLA[2]) < 1e-3);
+    }
+}
+
+void tst_CoordinateConversions::nedRoundTrip()
+{
+    CoordinateConversions::HomeReference ref;
+    CoordinateConversions().SetHome(home, ref);
+
+    QVector<double> n(north), e(east), d(down);
+    CoordinateConversions().NED2LLA(ref, POINTS, n.constData(), e.constData(), d.constData(), n.data(), e.data(), d.data());
+    CoordinateConversions().LLA2NED(ref, POINTS, n.constData(), e.constData(), d.constData(), n.data(), e.data(), d.data());
+    for (int i = 0; i < POINTS; i++) {
+        QVERIFY(qAbs(n[i] - north[i]) < 1e-6);
+        QVERIFY(qAbs(e[i] - east[i]) < 1e-6);
+        QVERIFY(qAbs(d[i] - down[i]) < 1e-6);
+    }
+}
+
+void tst_CoordinateConversions::benchmarkECEF2LLAScalar()
+{
+    QVector<double> blat(POINTS);
+    QBENCHMARK {
+        for (int i = 0; i < POINTS; i++) {
+            double ECEF[3] = { x[i], y[i], z[i] };
+            double LLA[3];
+            CoordinateConversions().ECEF2LLA(ECEF, LLA);
+            blat[i] = LLA[0];
+        }
+    }
+}
+
+void tst_CoordinateConversions::benchmarkECEF2LLABatch()
+{
+    QVector<double> blat(POINTS), blon(POINTS), balt(POINTS);
+    QBENCHMARK {
+        CoordinateConversions().ECEF2LLA(POINTS, x.constData(), y.constData(), z.constData(),
+                                         blat.data(), blon.data(), balt.data());
+    }
+}
+
+void tst_CoordinateConversions::benchmarkNED2LLAScalar()
+{
+    QVector<double> blat(POINTS);
+    QBENCHMARK {
+        for (int i = 0; i < POINTS; i++) {
+            double NED[3] = { north[i], east[i], down[i] };
+            double LLA[3];
+            CoordinateConversions().NED2LLA_HomeLLA(home, NED, LLA);
+            blat[i] = LLA[0];
+        }
+    }
+}
+
+void tst_CoordinateConversions::benchmarkNED2LLABatch()
+{
+    QVector<double> blat(POINTS), blon(POINTS), balt(POINTS);
+    QBENCHMARK {
+        CoordinateConversions::HomeReference ref;
+        CoordinateConversions().SetHome(home, ref);
+        CoordinateConversions().NED2LLA(ref, POINTS, north.constData(), east.constData(), down.constData(),
+                                        blat.data(), blon.data(), balt.data());
+    }
+}
+
+QTEST_MAIN(tst_CoordinateConversions)
+
+#include "tst_coordinateconversions.moc"
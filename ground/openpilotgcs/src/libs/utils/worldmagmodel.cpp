@@ -149,16 +149,80 @@ const double CoeffFile[91][6] = {
 
 namespace Utils {
 
-    WorldMagModel::WorldMagModel()
+    WorldMagModel::WorldMagModel() :
+        coeff_date(-1),
+        grid_spacing(1.0),
+        grid_alt_spacing(1000.0)
     {
         Initialize();
     }
 
     int WorldMagModel::GetMagVector(double LLA[3], int Month, int Day, int Year, double Be[3])
+    {
+        int ret = CheckPosition(LLA);
+        if (ret < 0)
+            return ret; // error
+
+        if (SetDate(Month, Day, Year) < 0)
+            return -5;  // error
+
+        return MagVector(LLA, Be);
+    }
+
+    /**
+     * Same as GetMagVector() but interpolated between cached grid nodes, see
+     * SetGridSpacing(). With the default spacing of 1 degree and 1000 m the
+     * result is within a fraction of a percent of the exact value.
+     */
+    int WorldMagModel::GetMagVectorInterpolated(double LLA[3], int Month, int Day, int Year, double Be[3])
+    {
+        int ret = CheckPosition(LLA);
+        if (ret < 0)
+            return ret; // error
+
+        if (SetDate(Month, Day, Year) < 0)
+            return -5;  // error
+
+        return MagVectorInterpolated(LLA, Be);
+    }
+
+    /**
+     * Evaluate Count points at once. Be is set to zero for the points that
+     * fail and the error of the first of them is returned.
+     */
+    int WorldMagModel::GetMagVectors(const double LLA[][3], int Count, int Month, int Day, int Year, double Be[][3], bool Interpolate)
+    {
+        if (SetDate(Month, Day, Year) < 0)
+            return -5;  // error
+
+        int ret = 0;
+        for (int i = 0; i < Count; i++)
+        {
+            int err = CheckPosition(LLA[i]);
+            if (err == 0)
+                err = Interpolate ? MagVectorInterpolated(LLA[i], Be[i]) : MagVector(LLA[i], Be[i]);
+            if (err < 0)
+            {
+                Be[i][0] = Be[i][1] = Be[i][2] = 0;
+                if (ret == 0)
+                    ret = err;
+            }
+        }
+
+        return ret;
+    }
+
+    void WorldMagModel::SetGridSpacing(double Degrees, double Meters)
+    {
+        grid_spacing = qBound(0.01, Degrees, 10.0);
+        grid_alt_spacing = qMax(1.0, Meters);
+        grid.clear();
+    }
+
+    int WorldMagModel::CheckPosition(const double LLA[3])
     {
         double Lat = LLA[0];
         double Lon = LLA[1];
-        double AltEllipsoid = LLA[2]/1000.0; // convert to km
 
         // ***********
         // range check supplied params
@@ -169,25 +233,23 @@ namespace Utils {
         if (Lon < -180) return -3;  // error
         if (Lon >  180) return -4;  // error
 
-        // ***********
+        return 0;   // OK
+    }
 
+    int WorldMagModel::MagVector(const double LLA[3], double Be[3])
+    {
         WMMtype_CoordSpherical CoordSpherical;
         WMMtype_CoordGeodetic CoordGeodetic;
         WMMtype_GeoMagneticElements GeoMagneticElements;
 
-        Initialize();
-
-        CoordGeodetic.lambda = Lon;
-        CoordGeodetic.phi = Lat;
-        CoordGeodetic.HeightAboveEllipsoid = AltEllipsoid;
+        CoordGeodetic.lambda = LLA[1];
+        CoordGeodetic.phi = LLA[0];
+        CoordGeodetic.HeightAboveEllipsoid = LLA[2] / 1000.0; // convert to km
 
         // Convert from geodeitic to Spherical Equations: 17-18, WMM Technical report
         GeodeticToSpherical(&CoordGeodetic, &CoordSpherical);
 
-        if (DateToYear(Month, Day, Year) < 0)
-            return -5;  // error
-
-        // Compute the geoMagnetic field elements and their time change
+        // Compute the geoMagnetic field elements
         if (Geomag(&CoordSpherical, &CoordGeodetic, &GeoMagneticElements) < 0)
             return -6;  // error
 
@@ -196,7 +258,56 @@ namespace Utils {
         Be[1] = GeoMagneticElements.Y * 1e-2;
         Be[2] = GeoMagneticElements.Z * 1e-2;
 
-        // ***********
+        return 0;   // OK
+    }
+
+    int WorldMagModel::MagVectorInterpolated(const double LLA[3], double Be[3])
+    {
+        double cell[3] = { (LLA[0] + 90.0) / grid_spacing, (LLA[1] + 180.0) / grid_spacing, LLA[2] / grid_alt_spacing };
+        int index[3];
+        double frac[3];
+        for (int i = 0; i < 3; i++)
+        {
+            index[i] = (int)floor(cell[i]);
+            frac[i] = cell[i] - index[i];
+        }
+
+        // Trilinear interpolation between the 8 grid nodes around the position
+        Be[0] = Be[1] = Be[2] = 0;
+        for (int corner = 0; corner < 8; corner++)
+        {
+            int node[3];
+            double weight = 1.0;
+            for (int i = 0; i < 3; i++)
+            {
+                int upper = (corner >> i) & 1;
+                node[i] = index[i] + upper;
+                weight *= upper ? frac[i] : 1.0 - frac[i];
+            }
+            if (weight == 0.0)
+                continue;   // also skips the nodes past the poles and the date line
+
+            quint64 key = ((quint64)(quint16)node[0] << 48) | ((quint64)(quint16)node[1] << 32) | (quint32)node[2];
+            QHash<quint64, WMMtype_MagneticResults>::const_iterator it = grid.constFind(key);
+            if (it == grid.constEnd())
+            {
+                double nodeLLA[3] = { qMin(node[0] * grid_spacing - 90.0, 90.0),
+                                      qMin(node[1] * grid_spacing - 180.0, 180.0),
+                                      node[2] * grid_alt_spacing };
+                double nodeBe[3];
+                if (MagVector(nodeLLA, nodeBe) < 0)
+                    return -6;  // error
+
+                if (grid.size() >= WMM_GRID_MAX_NODES)
+                    grid.clear();
+                WMMtype_MagneticResults result = { nodeBe[0], nodeBe[1], nodeBe[2] };
+                it = grid.insert(key, result);
+            }
+
+            Be[0] += weight * it->Bx;
+            Be[1] += weight * it->By;
+            Be[2] += weight * it->Bz;
+        }
 
         return 0;   // OK
     }
@@ -222,6 +333,55 @@ namespace Utils {
         MagneticModel.EditionDate = 5.7863328170559505e-307;
         MagneticModel.epoch = 2010.0;
         sprintf(MagneticModel.ModelName, "WMM-2010");
+
+        /*Compute the ration between the Gauss-normalized associated Legendre
+          functions and the Schmidt quasi-normalized version. This is equivalent to
+        sqrt((m==0?1:2)*(n-m)!/(n+m!))*(2n-1)!!/(n-m)!  */
+
+        schmidtQuasiNorm[0] = 1.0;
+        for (int n = 1; n <= MagneticModel.nMax; n++)
+        {
+            int index = (n * (n + 1) / 2);
+            int index1 = (n - 1) * n / 2;
+            /* for m = 0 */
+            schmidtQuasiNorm[index] = schmidtQuasiNorm[index1] * (double)(2 * n - 1) / (double)n;
+
+            for (int m = 1; m <= n; m++)
+            {
+                index = (n * (n + 1) / 2 + m);
+                index1 = (n * (n + 1) / 2 + m - 1);
+                schmidtQuasiNorm[index] = schmidtQuasiNorm[index1] * sqrt((double)((n - m + 1) * (m == 1 ? 2 : 1)) / (double)(n + m));
+            }
+        }
+    }
+
+    int WorldMagModel::SetDate(int Month, int Day, int Year)
+    {
+        if (DateToYear(Month, Day, Year) < 0)
+            return -1;  // error
+
+        if (decimal_date == coeff_date)
+            return 0;   // OK, nothing changed
+
+        // Advance the main field coefficients to the date by the secular variation
+        int a = MagneticModel.nMaxSecVar;
+        int b = (a * (a + 1) / 2 + a);
+        int c = (MagneticModel.nMax * (MagneticModel.nMax + 1) / 2 + MagneticModel.nMax);
+        for (int index = 0; index < WMM_NUMTERMS; index++)
+        {
+            main_field_coeff_g[index] = CoeffFile[index][2];
+            main_field_coeff_h[index] = CoeffFile[index][3];
+            if (index >= 1 && index <= c && index <= b)
+            {
+                main_field_coeff_g[index] += (decimal_date - MagneticModel.epoch) * get_secular_var_coeff_g(index);
+                main_field_coeff_h[index] += (decimal_date - MagneticModel.epoch) * get_secular_var_coeff_h(index);
+            }
+        }
+
+        coeff_date = decimal_date;
+        grid.clear();
+
+        return 0;   // OK
     }
 
 
@@ -257,20 +417,24 @@ namespace Utils {
         // Accumulate the spherical harmonic coefficients
         Summation(&LegendreFunction, &SphVariables, CoordSpherical, &MagneticResultsSph);
 
-        // Sum the Secular Variation Coefficients
-        SecVarSummation(&LegendreFunction, &SphVariables, CoordSpherical, &MagneticResultsSphVar);
-
         // Map the computed Magnetic fields to Geodeitic coordinates
         RotateMagneticVector(CoordSpherical, CoordGeodetic, &MagneticResultsSph, &MagneticResultsGeo);
 
-        // Map the secular variation field components to Geodetic coordinates
-        RotateMagneticVector(CoordSpherical, CoordGeodetic, &MagneticResultsSphVar, &MagneticResultsGeoVar);
-
         // Calculate the Geomagnetic elements, Equation 18 , WMM Technical report
         CalculateGeoMagneticElements(&MagneticResultsGeo, GeoMagneticElements);
 
-        // Calculate the secular variation of each of the Geomagnetic elements
-        CalculateSecularVariation(&MagneticResultsGeoVar, GeoMagneticElements);
+        // The yearly rates of change are only computed when they are asked for
+        if (MagneticModel.SecularVariationUsed)
+        {
+            // Sum the Secular Variation Coefficients
+            SecVarSummation(&LegendreFunction, &SphVariables, CoordSpherical, &MagneticResultsSphVar);
+
+            // Map the secular variation field components to Geodetic coordinates
+            RotateMagneticVector(CoordSpherical, CoordGeodetic, &MagneticResultsSphVar, &MagneticResultsGeoVar);
+
+            // Calculate the secular variation of each of the Geomagnetic elements
+            CalculateSecularVariation(&MagneticResultsGeoVar, GeoMagneticElements);
+        }
 
         return 0;   // OK
     }
@@ -387,15 +551,16 @@ namespace Utils {
             for (int m = 0; m <= n; m++)
             {
                 int index = (n * (n + 1) / 2 + m);
+                double g = main_field_coeff_g[index];
+                double h = main_field_coeff_h[index];
+                double gcos_hsin = g * SphVariables->cos_mlambda[m] + h * SphVariables->sin_mlambda[m];
 
 /*		    nMax  	(n+2) 	  n     m            m           m
     Bz =   -SUM (a/r)   (n+1) SUM  [g cos(m p) + h sin(m p)] P (sin(phi))
             n=1      	      m=0   n            n           n  */
 /* Equation 12 in the WMM Technical report.  Derivative with respect to radius.*/
                 MagneticResults->Bz -=
-                    SphVariables->RelativeRadiusPower[n] *
-                     (get_main_field_coeff_g(index) *
-                     SphVariables->cos_mlambda[m] + get_main_field_coeff_h(index) * SphVariables->sin_mlambda[m])
+                    SphVariables->RelativeRadiusPower[n] * gcos_hsin
                     * (double)(n + 1) * LegendreFunction->Pcup[index];
 
 /*		  1 nMax  (n+2)    n     m            m           m
@@ -404,8 +569,7 @@ namespace Utils {
 /* Equation 11 in the WMM Technical report. Derivative with respect to longitude, divided by radius. */
                 MagneticResults->By +=
                     SphVariables->RelativeRadiusPower[n] *
-                    (get_main_field_coeff_g(index) *
-                     SphVariables->sin_mlambda[m] - get_main_field_coeff_h(index) * SphVariables->cos_mlambda[m])
+                    (g * SphVariables->sin_mlambda[m] - h * SphVariables->cos_mlambda[m])
                     * (double)(m) * LegendreFunction->Pcup[index];
 /*		   nMax  (n+2) n     m            m           m
     Bx = - SUM (a/r)   SUM  [g cos(m p) + h sin(m p)] dP (sin(phi))
@@ -413,9 +577,7 @@ namespace Utils {
 /* Equation 10  in the WMM Technical report. Derivative with respect to latitude, divided by radius. */
 
                 MagneticResults->Bx -=
-                    SphVariables->RelativeRadiusPower[n] *
-                    (get_main_field_coeff_g(index) *
-                     SphVariables->cos_mlambda[m] + get_main_field_coeff_h(index) * SphVariables->sin_mlambda[m])
+                    SphVariables->RelativeRadiusPower[n] * gcos_hsin
                     * LegendreFunction->dPcup[index];
 
             }
@@ -450,8 +612,6 @@ namespace Utils {
            OUTPUT : MagneticResults
          */
 
-        MagneticModel.SecularVariationUsed = true;
-
         MagneticResults->Bz = 0.0;
         MagneticResults->By = 0.0;
         MagneticResults->Bx = 0.0;
@@ -766,8 +926,6 @@ namespace Utils {
           the Associated Legendre Functions.
         */
 
-        double schmidtQuasiNorm[WMM_NUMPCUP];
-
         Pcup[0] = 1.0;
         dPcup[0] = 0.0;
 
@@ -813,29 +971,9 @@ namespace Utils {
             }
         }
 
-        /*Compute the ration between the Gauss-normalized associated Legendre
-          functions and the Schmidt quasi-normalized version. This is equivalent to
-        sqrt((m==0?1:2)*(n-m)!/(n+m!))*(2n-1)!!/(n-m)!  */
-
-        schmidtQuasiNorm[0] = 1.0;
-        for (int n = 1; n <= nMax; n++)
-        {
-            int index = (n * (n + 1) / 2);
-            int index1 = (n - 1) * n / 2;
-            /* for m = 0 */
-            schmidtQuasiNorm[index] = schmidtQuasiNorm[index1] * (double)(2 * n - 1) / (double)n;
-
-            for (int m = 1; m <= n; m++)
-            {
-                index = (n * (n + 1) / 2 + m);
-                index1 = (n * (n + 1) / 2 + m - 1);
-                schmidtQuasiNorm[index] = schmidtQuasiNorm[index1] * sqrt((double)((n - m + 1) * (m == 1 ? 2 : 1)) / (double)(n + m));
-            }
-        }
-
         /* Converts the  Gauss-normalized associated Legendre
               functions to the Schmidt quasi-normalized version using pre-computed
-              relation stored in the variable schmidtQuasiNorm */
+              relation stored in the variable schmidtQuasiNorm, see Initialize() */
 
         for (int n = 1; n <= nMax; n++)
         {
@@ -949,32 +1087,13 @@ namespace Utils {
         }
     }
 
-    // brief Comput the MainFieldCoeffH accounting for the date
+    // brief The MainFieldCoeffG for the date, see SetDate()
     double WorldMagModel::get_main_field_coeff_g(int index)
     {
         if (index >= WMM_NUMTERMS)
             return 0;
 
-        double coeff = CoeffFile[index][2];
-
-        int a = MagneticModel.nMaxSecVar;
-        int b = (a * (a + 1) / 2 + a);
-        for (int n = 1; n <= MagneticModel.nMax; n++)
-        {
-            for (int m = 0; m <= n; m++)
-            {
-                int sum_index = (n * (n + 1) / 2 + m);
-
-                /* Hacky for now, will solve for which conditions need summing analytically */
-                if (sum_index != index)
-                    continue;
-
-                if (index <= b)
-                    coeff += (decimal_date - MagneticModel.epoch) * get_secular_var_coeff_g(sum_index);
-            }
-        }
-
-        return coeff;
+        return main_field_coeff_g[index];
     }
 
     double WorldMagModel::get_main_field_coeff_h(int index)
@@ -982,26 +1101,7 @@ namespace Utils {
         if (index >= WMM_NUMTERMS)
             return 0;
 
-        double coeff = CoeffFile[index][3];
-
-        int a = MagneticModel.nMaxSecVar;
-        int b = (a * (a + 1) / 2 + a);
-        for (int n = 1; n <= MagneticModel.nMax; n++)
-        {
-            for (int m = 0; m <= n; m++)
-            {
-                int sum_index = (n * (n + 1) / 2 + m);
-
-                /* Hacky for now, will solve for which conditions need summing analytically */
-                if (sum_index != index)
-                    continue;
-
-                if (index <= b)
-                    coeff += (decimal_date - MagneticModel.epoch) * get_secular_var_coeff_h(sum_index);
-            }
-        }
-
-        return coeff;
+        return main_field_coeff_h[index];
     }
 
     double WorldMagModel::get_secular_var_coeff_g(int index)
@@ -30,6 +30,7 @@
 #define WORLDMAGMODEL_H
 
 #include "utils_global.h"
+#include <QHash>
 
 // ******************************
 // internal structure definitions
@@ -39,6 +40,7 @@
 #define	WMM_NUMTERMS                                91		// ((WMM_MAX_MODEL_DEGREES + 1) * (WMM_MAX_MODEL_DEGREES + 2) / 2);
 #define WMM_NUMPCUP                                 92		// NUMTERMS + 1
 #define WMM_NUMPCUPS                                13		// WMM_MAX_MODEL_DEGREES + 1
+#define WMM_GRID_MAX_NODES                          65536	// cached grid nodes before the cache is cleared
 
 typedef struct
 {
@@ -130,12 +132,23 @@ typedef struct
 
 namespace Utils {
 
+    /**
+     * The model coefficients for a date are computed once and kept until the
+     * date changes. GetMagVectorInterpolated() evaluates the model on the nodes
+     * of a lat/lon/alt grid around the position and interpolates between them,
+     * the nodes are cached so points close to each other, like the waypoints of
+     * a route or a survey area, cost little more than the interpolation.
+     */
     class QTCREATOR_UTILS_EXPORT WorldMagModel
     {
         public:
             WorldMagModel();
 
             int GetMagVector(double LLA[3], int Month, int Day, int Year, double Be[3]);
+            int GetMagVectorInterpolated(double LLA[3], int Month, int Day, int Year, double Be[3]);
+            int GetMagVectors(const double LLA[][3], int Count, int Month, int Day, int Year, double Be[][3], bool Interpolate = false);
+
+            void SetGridSpacing(double Degrees, double Meters);
 
         private:
             WMMtype_Ellipsoid       Ellip;
@@ -143,7 +156,22 @@ namespace Utils {
 
             double                  decimal_date;
 
+            // Coefficients for coeff_date, updated by SetDate()
+            double                  coeff_date;
+            double                  main_field_coeff_g[WMM_NUMTERMS];
+            double                  main_field_coeff_h[WMM_NUMTERMS];
+            double                  schmidtQuasiNorm[WMM_NUMPCUP];
+
+            // Be at the grid nodes for coeff_date
+            double                  grid_spacing;
+            double                  grid_alt_spacing;
+            QHash<quint64, WMMtype_MagneticResults> grid;
+
             void Initialize();
+            int SetDate(int Month, int Day, int Year);
+            int CheckPosition(const double LLA[3]);
+            int MagVector(const double LLA[3], double Be[3]);
+            int MagVectorInterpolated(const double LLA[3], double Be[3]);
             int Geomag(WMMtype_CoordSpherical *CoordSpherical, WMMtype_CoordGeodetic *CoordGeodetic, WMMtype_GeoMagneticElements *GeoMagneticElements);
             void ComputeSphericalHarmonicVariables(WMMtype_CoordSpherical *CoordSpherical, int nMax, WMMtype_SphericalHarmonicVariables *SphVariables);
             int AssociatedLegendreFunction(WMMtype_CoordSpherical *CoordSpherical, int nMax, WMMtype_LegendreFunction *LegendreFunction);
@@ -39,9 +39,20 @@
 #include <QSize>
 #include <QPoint>
 #include <QtCore/QUrl>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QDir>
+#include <QtCore/QDataStream>
+#include <QtCore/QXmlStreamReader>
+#include <QtCore/QCryptographicHash>
+#include <QtGui/QDesktopServices>
 
 #define NUM_PREFIX "arr_"
 
+// Binary settings cache, see readCache()
+#define CACHE_MAGIC 0x47435358
+#define CACHE_VERSION 2
+
 QString XmlConfig::rootName = "gcs";
 
 const QSettings::Format XmlConfig::XmlSettingsFormat =
@@ -50,36 +61,76 @@ const QSettings::Format XmlConfig::XmlSettingsFormat =
 
 bool XmlConfig::readXmlFile(QIODevice &device, QSettings::SettingsMap &map)
 {
-    QDomDocument domDoc;
-    QDomElement root;
-    QString errorStr;
-    int errorLine;
-    int errorColumn;
-
-    if (!domDoc.setContent(&device, true, &errorStr, &errorLine,
-                                &errorColumn)) {
+    // QSettings hands us the config file itself, which lets us reuse the
+    // map stored by a previous parse as long as the file didn't change.
+    // Hashing the content is far cheaper than parsing it.
+    QFile *file = qobject_cast<QFile*>(&device);
+    QString fileName = file ? QFileInfo(*file).absoluteFilePath() : QString();
+    QByteArray data = device.readAll();
+    QByteArray hash;
+
+    if (!fileName.isEmpty()) {
+        hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+        if (readCache(fileName, hash, map))
+            return true;
+    }
+
+    if (!parseXml(data, map))
+        return false;
+
+    if (!fileName.isEmpty())
+        writeCache(fileName, hash, map);
+    return true;
+}
+
+bool XmlConfig::parseXml(const QByteArray &data, QSettings::SettingsMap &map)
+{
+    QXmlStreamReader xml(data);
+    QStringList path;
+    // one entry per open element, true if it added a level to path
+    QList<bool> levels;
+    QString text;
+
+    while (!xml.atEnd()) {
+        switch (xml.readNext()) {
+        case QXmlStreamReader::StartElement: {
+            QString nodeName = decodeName(xml.name().toString());
+            bool level = (nodeName != XmlConfig::rootName);
+            if (level)
+                path.append(nodeName);
+            levels.append(level);
+            text.clear();
+            break;
+        }
+        case QXmlStreamReader::Characters:
+            text += xml.text();
+            break;
+        case QXmlStreamReader::EndElement:
+            if (!text.trimmed().isEmpty())
+                map.insert(path.join("/"), stringToVariant(text));
+            text.clear();
+            if (!levels.isEmpty() && levels.takeLast())
+                path.removeLast();
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (xml.hasError()) {
         QString err = QString(tr("GCS config")) +
                       tr("Parse error at line %1, column %2:\n%3")
-                      .arg(errorLine)
-                      .arg(errorColumn)
-                      .arg(errorStr);
+                      .arg(xml.lineNumber())
+                      .arg(xml.columnNumber())
+                      .arg(xml.errorString());
         qFatal(err.toLatin1().data());
         return false;
     }
-    root = domDoc.documentElement();
-    handleNode(&root, map);
-
     return true;
 }
 
-void XmlConfig::handleNode(QDomElement* node, QSettings::SettingsMap &map, QString path)
+QString XmlConfig::decodeName(QString nodeName)
 {
-    if ( !node ){
-        return;
-    }
-  //  qDebug() << "XmlConfig::handleNode start";
-
-    QString nodeName = node->nodeName();
     // For arrays, QT will use simple numbers as keys, which is not a valid element in XML.
     // Therefore we prefixed these.
     if ( nodeName.startsWith(NUM_PREFIX) ){
@@ -88,30 +139,69 @@ void XmlConfig::handleNode(QDomElement* node, QSettings::SettingsMap &map, QStri
     // Xml tags are restrictive with allowed characters,
     // so we urlencode and replace % with __PCT__ on file
     nodeName = nodeName.replace("__PCT__", "%");
-    nodeName = QUrl::fromPercentEncoding(nodeName.toAscii());
-
-    if ( nodeName == XmlConfig::rootName )
-        ;
-    else if ( path == "" )
-        path = nodeName;
-    else
-        path += "/" + nodeName;
-
-//    qDebug() << "Node: " << ": " << path << " Children: " << node->childNodes().length();
-    for ( uint i = 0; i < node->childNodes().length(); ++i ){
-        QDomNode child = node->childNodes().item(i);
-        if ( child.isElement() ){
-            handleNode( static_cast<QDomElement*>(&child), map, path);
-        }
-        else if ( child.isText() ){
-//            qDebug() << "Key: " << path << " Value:" << node->text();
-            map.insert(path, stringToVariant(node->text()));
-        }
-        else{
-            qDebug() << "Child not Element or text!" << child.nodeType();
-        }
-    }
-//    qDebug() << "XmlConfig::handleNode end";
+    return QUrl::fromPercentEncoding(nodeName.toAscii());
+}
+
+QString XmlConfig::cacheFileName(const QString &fileName)
+{
+    QString dir = QDesktopServices::storageLocation(QDesktopServices::CacheLocation);
+    if (dir.isEmpty())
+        return QString();
+    QByteArray hash = QCryptographicHash::hash(fileName.toUtf8(), QCryptographicHash::Md5).toHex();
+    return dir + "/settings/" + QString::fromLatin1(hash) + ".bin";
+}
+
+/**
+ * The cache holds the parsed settings map of one config file, keyed by
+ * the SHA1 hash of the file's content. Any mismatch (or a cache written
+ * by another version) makes us fall back to parsing the XML.
+ */
+bool XmlConfig::readCache(const QString &fileName, const QByteArray &hash, QSettings::SettingsMap &map)
+{
+    QString cacheName = cacheFileName(fileName);
+    if (cacheName.isEmpty())
+        return false;
+
+    QFile cache(cacheName);
+    if (!cache.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&cache);
+    stream.setVersion(QDataStream::Qt_4_6);
+    quint32 magic, version;
+    QString name;
+    QByteArray contentHash;
+    stream >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION)
+        return false;
+    stream >> name >> contentHash;
+    if (name != fileName || contentHash != hash)
+        return false;
+
+    QSettings::SettingsMap cached;
+    stream >> cached;
+    if (stream.status() != QDataStream::Ok)
+        return false;
+    map.unite(cached);
+    return true;
+}
+
+void XmlConfig::writeCache(const QString &fileName, const QByteArray &hash, const QSettings::SettingsMap &map)
+{
+    QString cacheName = cacheFileName(fileName);
+    if (cacheName.isEmpty())
+        return;
+
+    QDir().mkpath(QFileInfo(cacheName).path());
+    QFile cache(cacheName);
+    if (!cache.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+
+    QDataStream stream(&cache);
+    stream.setVersion(QDataStream::Qt_4_6);
+    stream << quint32(CACHE_MAGIC) << quint32(CACHE_VERSION);
+    stream << fileName << hash;
+    stream << map;
 }
 
 bool XmlConfig::writeXmlFile(QIODevice &device, const QSettings::SettingsMap &map)
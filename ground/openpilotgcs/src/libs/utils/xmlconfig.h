@@ -49,7 +49,11 @@ public:
 private:
     static QString rootName;
 
-    static void handleNode(QDomElement* node, QSettings::SettingsMap &map, QString path = "");
+    static bool parseXml(const QByteArray &data, QSettings::SettingsMap &map);
+    static QString decodeName(QString name);
+    static QString cacheFileName(const QString &fileName);
+    static bool readCache(const QString &fileName, const QByteArray &hash, QSettings::SettingsMap &map);
+    static void writeCache(const QString &fileName, const QByteArray &hash, const QSettings::SettingsMap &map);
     static QSettings::SettingsMap settingsToMap(QSettings& qs);
     static QString variantToString(const QVariant &v);
     static QVariant stringToVariant(const QString &s);
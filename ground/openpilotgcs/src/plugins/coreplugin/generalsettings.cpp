@@ -49,7 +49,8 @@ GeneralSettings::GeneralSettings():
     m_autoConnect(true),
     m_autoSelect(true),
     m_useUDPMirror(false),
-    m_useExpertMode(false)
+    m_useExpertMode(false),
+    m_useSharedMemoryExport(false)
 {
 }
 
@@ -121,6 +122,7 @@ QWidget *GeneralSettings::createPage(QWidget *parent)
     m_page->checkAutoSelect->setChecked(m_autoSelect);
     m_page->cbUseUDPMirror->setChecked(m_useUDPMirror);
     m_page->cbExpertMode->setChecked(m_useExpertMode);
+    m_page->cbSharedMemoryExport->setChecked(m_useSharedMemoryExport);
     m_page->colorButton->setColor(StyleHelper::baseColor());
 
     connect(m_page->resetButton, SIGNAL(clicked()),
@@ -139,6 +141,7 @@ void GeneralSettings::apply()
     m_saveSettingsOnExit = m_page->checkBoxSaveOnExit->isChecked();
     m_useUDPMirror=m_page->cbUseUDPMirror->isChecked();
     m_useExpertMode=m_page->cbExpertMode->isChecked();
+    m_useSharedMemoryExport = m_page->cbSharedMemoryExport->isChecked();
     m_autoConnect = m_page->checkAutoConnect->isChecked();
     m_autoSelect = m_page->checkAutoSelect->isChecked();
 }
@@ -157,6 +160,7 @@ void GeneralSettings::readSettings(QSettings* qs)
     m_autoSelect = qs->value(QLatin1String("AutoSelect"),m_autoSelect).toBool();
     m_useUDPMirror = qs->value(QLatin1String("UDPMirror"),m_useUDPMirror).toBool();
     m_useExpertMode = qs->value(QLatin1String("ExpertMode"),m_useExpertMode).toBool();
+    m_useSharedMemoryExport = qs->value(QLatin1String("SharedMemoryExport"),m_useSharedMemoryExport).toBool();
     qs->endGroup();
 }
 
@@ -174,6 +178,7 @@ void GeneralSettings::saveSettings(QSettings* qs)
     qs->setValue(QLatin1String("AutoSelect"), m_autoSelect);
     qs->setValue(QLatin1String("UDPMirror"), m_useUDPMirror);
     qs->setValue(QLatin1String("ExpertMode"), m_useExpertMode);
+    qs->setValue(QLatin1String("SharedMemoryExport"), m_useSharedMemoryExport);
     qs->endGroup();
 }
 
@@ -249,6 +254,11 @@ bool GeneralSettings::useExpertMode() const
     return m_useExpertMode;
 }
 
+bool GeneralSettings::useSharedMemoryExport() const
+{
+    return m_useSharedMemoryExport;
+}
+
 void GeneralSettings::slotAutoConnect(int value)
 {
     if (value==Qt::Checked)
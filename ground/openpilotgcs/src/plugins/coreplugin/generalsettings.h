@@ -62,6 +62,7 @@ public:
     void readSettings(QSettings* qs);
     void saveSettings(QSettings* qs);
     bool useExpertMode() const;
+    bool useSharedMemoryExport() const;
 signals:
 
 private slots:
@@ -81,6 +82,7 @@ private:
     bool m_autoSelect;
     bool m_useUDPMirror;
     bool m_useExpertMode;
+    bool m_useSharedMemoryExport;
     QPointer<QWidget> m_dialog;
     QList<QTextCodec *> m_codecs;
 
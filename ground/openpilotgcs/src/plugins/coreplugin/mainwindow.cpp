@@ -42,6 +42,7 @@
 #include "plugindialog.h"
 #include "qxtlogger.h"
 #include "qxtbasicstdloggerengine.h"
+#include "qxtasyncloggerengine.h"
 #include "shortcutsettings.h"
 #include "uavgadgetmanager.h"
 #include "uavgadgetinstancemanager.h"
@@ -71,6 +72,7 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QSettings>
 #include <QtCore/QTimer>
+#include <QtCore/QTime>
 #include <QtCore/QtPlugin>
 #include <QtCore/QUrl>
 
@@ -190,7 +192,8 @@ MainWindow::MainWindow() :
     setAcceptDrops(true);
     foreach (QString engine, qxtLog->allLoggerEngines())
         qxtLog->removeLoggerEngine(engine);
-    qxtLog->addLoggerEngine("std", new QxtBasicSTDLoggerEngine());
+    // Console output is written from a background thread
+    qxtLog->addLoggerEngine("std", new QxtAsyncLoggerEngine(new QxtBasicSTDLoggerEngine()));
     qxtLog->installAsMessageHandler();
     qxtLog->enableAllLogLevels();
 }
@@ -266,6 +269,10 @@ void MainWindow::modeChanged(Core::IMode */*mode*/)
 
 void MainWindow::extensionsInitialized()
 {
+    // Time each startup phase, large configurations make these add up
+    QTime phaseTime;
+    phaseTime.start();
+
     QSettings *qs = m_settings;
     QSettings *settings;
     QString commandLine;
@@ -316,17 +323,22 @@ void MainWindow::extensionsInitialized()
     m_config_stylesheet=qs->value("StyleSheet", "none").toString();
     loadStyleSheet(m_config_stylesheet);
     qs->endGroup();
+    qDebug() << "Startup: settings loaded in" << phaseTime.restart() << "ms";
+
     m_uavGadgetInstanceManager = new UAVGadgetInstanceManager(this);
     m_uavGadgetInstanceManager->readSettings(qs);
+    qDebug() << "Startup: gadget configurations read in" << phaseTime.restart() << "ms";
 
     m_messageManager->init();
     readSettings(qs);
+    qDebug() << "Startup: workspaces created in" << phaseTime.restart() << "ms";
 
     updateContext();
 
     emit m_coreImpl->coreAboutToOpen();
     show();
     emit m_coreImpl->coreOpened();
+    qDebug() << "Startup: main window shown in" << phaseTime.elapsed() << "ms";
 }
 
 void MainWindow::loadStyleSheet(QString name) {
@@ -886,6 +898,8 @@ bool MainWindow::showOptionsDialog(const QString &category,
     emit m_coreImpl->optionsDialogRequested();
     if (!parent)
         parent = this;
+    // the dialog lists the options pages of every gadget configuration
+    m_uavGadgetInstanceManager->readAllConfigurations();
     SettingsDialog dlg(parent, category, page);
     return dlg.execDialog();
 }
@@ -47,7 +47,8 @@ using namespace Core;
 static const UAVConfigVersion m_versionUAVGadgetConfigurations = UAVConfigVersion("1.2.0");
 
 UAVGadgetInstanceManager::UAVGadgetInstanceManager(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_pendingSettings(0)
 {
     m_pm = ExtensionSystem::PluginManager::instance();
     QList<IUAVGadgetFactory*> factories = m_pm->getObjects<IUAVGadgetFactory>();
@@ -69,7 +70,7 @@ UAVGadgetInstanceManager::~UAVGadgetInstanceManager()
         m_pm->removeObject(page);
         delete page;
     }
-
+    delete m_pendingSettings;
 }
 
 void UAVGadgetInstanceManager::readSettings(QSettings *qs)
@@ -77,6 +78,9 @@ void UAVGadgetInstanceManager::readSettings(QSettings *qs)
     while ( !m_configurations.isEmpty() ){
        emit configurationToBeDeleted(m_configurations.takeLast());
     }
+    delete m_pendingSettings;
+    m_pendingSettings = 0;
+    m_pendingClassIds.clear();
     qs->beginGroup("UAVGadgetConfigurations");
     UAVConfigInfo configInfo(qs);
     configInfo.setNameOfConfigurable("UAVGadgetConfigurations");
@@ -98,63 +102,96 @@ void UAVGadgetInstanceManager::readSettings(QSettings *qs)
                 tr("You might want to save your old config NOW since it might be replaced by broken one when you exit the GCS!")
                 );
     }
+    else if ( qs->fileName().isEmpty() ){
+        foreach (QString classId, m_classIdNameMap.keys())
+            readConfigs_1_2_0(qs, classId);
+    }
     else{
-        readConfigs_1_2_0(qs);
+        // The caller's settings object may be gone by the time a gadget
+        // needs its configuration, so keep our own on the same file.
+        // QSettings shares the parsed file between both objects.
+        m_pendingSettings = new QSettings(qs->fileName(), qs->format());
+        m_pendingClassIds = m_classIdNameMap.keys();
     }
 
     qs->endGroup();
     createOptionsPages();
 }
 
-void UAVGadgetInstanceManager::readConfigs_1_2_0(QSettings *qs)
+/**
+  * Reads the configurations of a gadget class which were left pending
+  * by readSettings(), and creates their options pages.
+  */
+void UAVGadgetInstanceManager::readConfigurations(QString classId)
+{
+    if (!m_pendingClassIds.removeOne(classId))
+        return;
+
+    int first = m_configurations.count();
+    m_pendingSettings->beginGroup("UAVGadgetConfigurations");
+    readConfigs_1_2_0(m_pendingSettings, classId);
+    m_pendingSettings->endGroup();
+    for (int i = first; i < m_configurations.count(); ++i)
+        createOptionsPage(m_configurations.at(i));
+
+    if (m_pendingClassIds.isEmpty()) {
+        delete m_pendingSettings;
+        m_pendingSettings = 0;
+    }
+}
+
+void UAVGadgetInstanceManager::readAllConfigurations()
+{
+    foreach (QString classId, m_pendingClassIds)
+        readConfigurations(classId);
+}
+
+void UAVGadgetInstanceManager::readConfigs_1_2_0(QSettings *qs, QString classId)
 {
     UAVConfigInfo configInfo;
 
-    foreach (QString classId, m_classIdNameMap.keys())
-    {
-        IUAVGadgetFactory *f = factory(classId);
-        qs->beginGroup(classId);
+    IUAVGadgetFactory *f = factory(classId);
+    qs->beginGroup(classId);
 
-        QStringList configs = QStringList();
+    QStringList configs = QStringList();
 
-        configs = qs->childGroups();
-        foreach (QString configName, configs) {
-            qDebug() << "Loading config: " << classId << "," <<  configName;
-            qs->beginGroup(configName);
-            configInfo.read(qs);
-            configInfo.setNameOfConfigurable(classId+"-"+configName);
-            qs->beginGroup("data");
-            IUAVGadgetConfiguration *config = f->createConfiguration(qs, &configInfo);
-            if (config){
-                config->setName(configName);
-                config->setProvisionalName(configName);
-                config->setLocked(configInfo.locked());
-                int idx = indexForConfig(m_configurations, classId, configName);
-                if ( idx >= 0 ){
-                    // We should replace the config, but it might be used, so just
-                    // throw it out of the list. The GCS should be reinitialised soon.
-                    m_configurations[idx] = config;
-                }
-                else{
-                    m_configurations.append(config);
-                }
+    configs = qs->childGroups();
+    foreach (QString configName, configs) {
+        qDebug() << "Loading config: " << classId << "," <<  configName;
+        qs->beginGroup(configName);
+        configInfo.read(qs);
+        configInfo.setNameOfConfigurable(classId+"-"+configName);
+        qs->beginGroup("data");
+        IUAVGadgetConfiguration *config = f->createConfiguration(qs, &configInfo);
+        if (config){
+            config->setName(configName);
+            config->setProvisionalName(configName);
+            config->setLocked(configInfo.locked());
+            int idx = indexForConfig(m_configurations, classId, configName);
+            if ( idx >= 0 ){
+                // We should replace the config, but it might be used, so just
+                // throw it out of the list. The GCS should be reinitialised soon.
+                m_configurations[idx] = config;
             }
-            qs->endGroup();
-            qs->endGroup();
-        }
-
-        if (configs.count() == 0) {
-            IUAVGadgetConfiguration *config = f->createConfiguration(0, 0);
-            // it is not mandatory for uavgadgets to have any configurations (settings)
-            // and therefore we have to check for that
-            if (config) {
-                config->setName(tr("default"));
-                config->setProvisionalName(tr("default"));
+            else{
                 m_configurations.append(config);
             }
         }
         qs->endGroup();
+        qs->endGroup();
+    }
+
+    if (configs.count() == 0) {
+        IUAVGadgetConfiguration *config = f->createConfiguration(0, 0);
+        // it is not mandatory for uavgadgets to have any configurations (settings)
+        // and therefore we have to check for that
+        if (config) {
+            config->setName(tr("default"));
+            config->setProvisionalName(tr("default"));
+            m_configurations.append(config);
+        }
     }
+    qs->endGroup();
 }
 
 void UAVGadgetInstanceManager::readConfigs_1_1_0(QSettings *qs)
@@ -209,6 +246,7 @@ void UAVGadgetInstanceManager::readConfigs_1_1_0(QSettings *qs)
 void UAVGadgetInstanceManager::saveSettings(QSettings *qs)
 {
     UAVConfigInfo *configInfo;
+    readAllConfigurations();
     qs->beginGroup("UAVGadgetConfigurations");
     qs->remove(""); // Remove existing configurations
     configInfo = new UAVConfigInfo(m_versionUAVGadgetConfigurations, "UAVGadgetConfigurations");
@@ -240,15 +278,18 @@ void UAVGadgetInstanceManager::createOptionsPages()
     }
 
     foreach (IUAVGadgetConfiguration *config, m_configurations)
-    {
-        IUAVGadgetFactory *f = factory(config->classId());
-        IOptionsPage *p = f->createOptionsPage(config);
-        if (p) {
-            IOptionsPage *page = new UAVGadgetOptionsPageDecorator(p, config, f->isSingleConfigurationGadget());
-            page->setIcon(f->icon());
-            m_optionsPages.append(page);
-            m_pm->addObject(page);
-        }
+        createOptionsPage(config);
+}
+
+void UAVGadgetInstanceManager::createOptionsPage(IUAVGadgetConfiguration *config)
+{
+    IUAVGadgetFactory *f = factory(config->classId());
+    IOptionsPage *p = f->createOptionsPage(config);
+    if (p) {
+        IOptionsPage *page = new UAVGadgetOptionsPageDecorator(p, config, f->isSingleConfigurationGadget());
+        page->setIcon(f->icon());
+        m_optionsPages.append(page);
+        m_pm->addObject(page);
     }
 }
 
@@ -473,8 +514,9 @@ IUAVGadgetFactory *UAVGadgetInstanceManager::factory(QString classId) const
     return 0;
 }
 
-QList<IUAVGadgetConfiguration*> *UAVGadgetInstanceManager::configurations(QString classId) const
+QList<IUAVGadgetConfiguration*> *UAVGadgetInstanceManager::configurations(QString classId)
 {
+    readConfigurations(classId);
     QList<IUAVGadgetConfiguration*> *configs = new QList<IUAVGadgetConfiguration*>;
     foreach (IUAVGadgetConfiguration *config, m_configurations) {
         if (config->classId() == classId)
@@ -61,6 +61,7 @@ public:
     ~UAVGadgetInstanceManager();
     void readSettings(QSettings *qs);
     void saveSettings(QSettings *qs);
+    void readAllConfigurations();
     IUAVGadget *createGadget(QString classId, QWidget *parent);
     void removeGadget(IUAVGadget *gadget);
     void removeAllGadgets();
@@ -87,7 +88,9 @@ public slots:
 private:
     IUAVGadgetFactory *factory(QString classId) const;
     void createOptionsPages();
-    QList<IUAVGadgetConfiguration*> *configurations(QString classId) const;
+    void createOptionsPage(IUAVGadgetConfiguration *config);
+    void readConfigurations(QString classId);
+    QList<IUAVGadgetConfiguration*> *configurations(QString classId);
     QString suggestName(QString classId, QString name);
     QList<IUAVGadget*> m_gadgetInstances;
     QList<IUAVGadgetFactory*> m_factories;
@@ -101,10 +104,14 @@ private:
     QList<IOptionsPage*> m_provisionalOptionsPages;
     Core::Internal::SettingsDialog *m_settingsDialog;
     ExtensionSystem::PluginManager *m_pm;
+    // Configurations are only read once a gadget of their class is
+    // created (or all of them are needed), until then they stay here
+    QSettings *m_pendingSettings;
+    QStringList m_pendingClassIds;
     int indexForConfig(QList<IUAVGadgetConfiguration*> configurations,
                        QString classId, QString configName);
     void readConfigs_1_1_0(QSettings *qs);
-    void readConfigs_1_2_0(QSettings *qs);
+    void readConfigs_1_2_0(QSettings *qs, QString classId);
 };
 
 } // namespace Core
@@ -12,6 +12,7 @@ include(../../libs/sdlgamepad/sdlgamepad.pri)
 HEADERS += gcscontrolgadget.h \
     gcscontrolgadgetconfiguration.h \
     gcscontrolgadgetoptionspage.h
+HEADERS += gcscontrolinput.h
 HEADERS += joystickcontrol.h
 HEADERS += gcscontrolgadgetwidget.h
 HEADERS += gcscontrolgadgetfactory.h
@@ -24,6 +25,7 @@ SOURCES += gcscontrolgadgetwidget.cpp
 SOURCES += gcscontrolgadgetfactory.cpp
 SOURCES += gcscontrolplugin.cpp
 SOURCES += joystickcontrol.cpp
+SOURCES += gcscontrolinput.cpp
 
 OTHER_FILES += GCSControl.pluginspec
 
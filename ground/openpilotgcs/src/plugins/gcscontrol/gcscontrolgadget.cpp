@@ -32,32 +32,44 @@
 #include "uavobject.h"
 #include <QDebug>
 
-#define JOYSTICK_UPDATE_RATE 50
-
 GCSControlGadget::GCSControlGadget(QString classId, GCSControlGadgetWidget *widget, QWidget *parent, QObject *plugin) :
         IUAVGadget(classId, parent),
-        m_widget(widget)
+        m_widget(widget),
+        inputDelay(-1)
 {
-    connect(getManualControlCommand(),SIGNAL(objectUpdated(UAVObject*)),this,SLOT(manualControlCommandUpdated(UAVObject*)));
+    mcc = getManualControlCommand();
+    connect(mcc,SIGNAL(objectUpdated(UAVObject*)),this,SLOT(manualControlCommandUpdated(UAVObject*)));
     connect(widget,SIGNAL(sticksChanged(double,double,double,double)),this,SLOT(sticksChangedLocally(double,double,double,double)));
     connect(this,SIGNAL(sticksChangedRemotely(double,double,double,double)),widget,SLOT(updateSticks(double,double,double,double)));
 
-    manualControlCommandUpdated(getManualControlCommand());
+    manualControlCommandUpdated(mcc);
 
     control_sock = new QUdpSocket(this);
 
     connect(control_sock,SIGNAL(readyRead()),this,SLOT(readUDPCommand()));
 
-    joystickTime.start();
     GCSControlPlugin *pl = dynamic_cast<GCSControlPlugin*>(plugin);
-    connect(pl->sdlGamepad,SIGNAL(gamepads(quint8)),this,SLOT(gamepads(quint8)));
-    connect(pl->sdlGamepad,SIGNAL(buttonState(ButtonNumber,bool)),this,SLOT(buttonState(ButtonNumber,bool)));
-    connect(pl->sdlGamepad,SIGNAL(axesValues(QListInt16)),this,SLOT(axesValues(QListInt16)));
-
+    sdlGamepad = pl->sdlGamepad;
+    connect(sdlGamepad,SIGNAL(gamepads(quint8)),this,SLOT(gamepads(quint8)));
+    connect(sdlGamepad,SIGNAL(buttonState(ButtonNumber,bool)),this,SLOT(buttonState(ButtonNumber,bool)));
+
+    // The axes are processed on the gamepad thread, see GCSControlInput
+    input = new GCSControlInput(mcc);
+    input->setEnabled(widget->getGCSControl() && !widget->getUDPControl());
+    connect(widget,SIGNAL(joystickControlChanged(bool)),input,SLOT(setEnabled(bool)));
+    connect(sdlGamepad,SIGNAL(axesValues(QListInt16)),input,SLOT(axesValues(QListInt16)),Qt::DirectConnection);
+    connect(input,SIGNAL(commandUpdated(int)),this,SLOT(joystickCommandUpdated(int)),Qt::QueuedConnection);
 }
 
 GCSControlGadget::~GCSControlGadget()
 {
+    // The gamepad thread calls the input directly, stop it so that no call is
+    // in flight while the input is deleted
+    bool gamepadRunning = sdlGamepad->suspend();
+    disconnect(sdlGamepad,0,input,0);
+    delete input;
+    if (gamepadRunning)
+        sdlGamepad->resume();
     delete m_widget;
 }
 
@@ -89,6 +101,18 @@ void GCSControlGadget::loadConfiguration(IUAVGadgetConfiguration* config)
         channelReverse[i]=GCSControlConfig->getChannelsReverse().at(i);
     }
 
+    //check if buttons have control over an axis, the joystick leaves those alone
+    bool buttonControl[5] = { false, false, false, false, false };
+    for (i=0;i<8;i++)
+    {
+        if ((buttonSettings[i].FunctionID>=1)&&(buttonSettings[i].FunctionID<=4)&&((buttonSettings[i].ActionID==1)||(buttonSettings[i].ActionID==2)))
+            buttonControl[buttonSettings[i].FunctionID]=true;
+    }
+
+    input->setChannels(rollChannel, pitchChannel, yawChannel, throttleChannel, GCSControlConfig->getChannelsReverse());
+    input->setCurves(GCSControlConfig->getInputDeadband(), GCSControlConfig->getInputExpo());
+    input->setButtonAxes(buttonControl[1], buttonControl[2], buttonControl[3], buttonControl[4]);
+    sdlGamepad->setTickRate(GCSControlConfig->getInputRate());
 }
 
 ManualControlCommand* GCSControlGadget::getManualControlCommand() {
@@ -127,7 +151,7 @@ void GCSControlGadget::manualControlCommandUpdated(UAVObject * obj) {
   Update the manual commands - maps depending on mode
   */
 void GCSControlGadget::sticksChangedLocally(double leftX, double leftY, double rightX, double rightY) {
-    ManualControlCommand * obj = getManualControlCommand();
+    ManualControlCommand * obj = mcc;
     double oldRoll = obj->getField("Roll")->getDouble();
     double oldPitch = obj->getField("Pitch")->getDouble();
     double oldYaw = obj->getField("Yaw")->getDouble();
@@ -253,7 +277,7 @@ void GCSControlGadget::readUDPCommand()
         }
         if(!badPack && ((GCSControlGadgetWidget *)m_widget)->getUDPControl())
         {
-             ManualControlCommand * obj = getManualControlCommand();
+             ManualControlCommand * obj = mcc;
              bool update = false;
 
              if(pitch != obj->getField("Pitch")->getDouble()){
@@ -295,9 +319,7 @@ void GCSControlGadget::buttonState(ButtonNumber number, bool pressed)
 {
     if ((buttonSettings[number].ActionID>0)&&(buttonSettings[number].FunctionID>0)&&(pressed))
     {//this button is configured
-        ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
-        UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
-        UAVDataObject* obj = dynamic_cast<UAVDataObject*>( objManager->getObject(QString("ManualControlCommand")) );
+        UAVDataObject* obj = mcc;
         bool currentCGSControl = ((GCSControlGadgetWidget *)m_widget)->getGCSControl();
         bool currentUDPControl = ((GCSControlGadgetWidget *)m_widget)->getUDPControl();
 
@@ -385,52 +407,18 @@ void GCSControlGadget::buttonState(ButtonNumber number, bool pressed)
         //buttonSettings[number].Amount
 }
 
-void GCSControlGadget::axesValues(QListInt16 values)
+/**
+  Called on the GUI thread after the joystick updated the command, shows
+  how long the queued notification took to get here
+  */
+void GCSControlGadget::joystickCommandUpdated(int sampleTime)
 {
-    int chMax = values.length();
-    if (rollChannel >= chMax || pitchChannel >= chMax ||
-            yawChannel >= chMax || throttleChannel >= chMax ) {
-        qDebug() << "GCSControl: configuration is inconsistent with current joystick! Aborting update.";
-        return;
-    }
-
-    double rValue = (rollChannel > -1) ? values[rollChannel] : 0;
-    double pValue = (pitchChannel > -1) ? values[pitchChannel] : 0;
-    double yValue = (yawChannel > -1) ? values[yawChannel] : 0;
-    double tValue = (throttleChannel > -1) ? values[throttleChannel] : 0;
-    double max = 32767;
-
-    if (rollChannel > -1) if(channelReverse[rollChannel]==true)rValue = -rValue;
-    if (pitchChannel > -1) if(channelReverse[pitchChannel]==true)pValue = -pValue;
-    if (yawChannel > -1) if(channelReverse[yawChannel]==true)yValue = -yValue;
-    if (throttleChannel > -1) if(channelReverse[throttleChannel]==true)tValue = -tValue;
-
-
-     if(joystickTime.elapsed() > JOYSTICK_UPDATE_RATE) {
-        joystickTime.restart();
-        // Remap RPYT to left X/Y and right X/Y depending on mode
-        // Mode 1: LeftX = Yaw, LeftY = Pitch, RightX = Roll, RightY = Throttle
-        // Mode 2: LeftX = Yaw, LeftY = THrottle, RightX = Roll, RightY = Pitch
-        // Mode 3: LeftX = Roll, LeftY = Pitch, RightX = Yaw, RightY = Throttle
-        // Mode 4: LeftX = Roll, LeftY = Throttle, RightX = Yaw, RightY = Pitch;
-        switch (controlsMode) {
-        case 1:
-            sticksChangedLocally(yValue/max,-pValue/max,rValue/max,-tValue/max);
-            break;
-        case 2:
-            sticksChangedLocally(yValue/max,-tValue/max,rValue/max,-pValue/max);
-            break;
-        case 3:
-            sticksChangedLocally(rValue/max,-pValue/max,yValue/max,-tValue/max);
-            break;
-        case 4:
-            sticksChangedLocally(rValue/max,-tValue/max,yValue/max,-pValue/max);
-            break;
-        }
-    }
+    int elapsed = GCSControlInput::timestamp() - sampleTime;
+    // Smooth the value so the display is readable at high sample rates
+    inputDelay = (inputDelay < 0) ? elapsed : (inputDelay * 7 + elapsed) / 8;
+    ((GCSControlGadgetWidget *)m_widget)->setInputDelay(inputDelay);
 }
 
-
 double GCSControlGadget::bound(double input)
 {
     if (input > 1.0)return 1.0;
@@ -31,8 +31,8 @@
 #include <coreplugin/iuavgadget.h>
 #include "manualcontrolcommand.h"
 #include "gcscontrolgadgetconfiguration.h"
+#include "gcscontrolinput.h"
 #include "sdlgamepad/sdlgamepad.h"
-#include <QTime>
 #include "gcscontrolplugin.h"
 #include <QUdpSocket>
 #include <QHostAddress>
@@ -63,8 +63,11 @@ public:
 private:
     ManualControlCommand* getManualControlCommand();
     double constrain(double value);
-    QTime joystickTime;
     QWidget *m_widget;
+    ManualControlCommand *mcc;
+    SDLGamepad *sdlGamepad;
+    GCSControlInput *input;
+    int inputDelay;
     QList<int> m_context;
     UAVObject::Metadata mccInitialData;
     int rollChannel;
@@ -90,7 +93,7 @@ protected slots:
     // signals from joystick
     void gamepads(quint8 count);
     void buttonState(ButtonNumber number, bool pressed);
-    void axesValues(QListInt16 values);
+    void joystickCommandUpdated(int sampleTime);
 };
 
 
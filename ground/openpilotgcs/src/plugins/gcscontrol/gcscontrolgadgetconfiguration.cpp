@@ -36,7 +36,10 @@ GCSControlGadgetConfiguration::GCSControlGadgetConfiguration(QString classId, QS
     rollChannel(-1),
     pitchChannel(-1),
     yawChannel(-1),
-    throttleChannel(-1)
+    throttleChannel(-1),
+    inputRate(20),
+    inputDeadband(0),
+    inputExpo(0)
 {
     int i;
     for (i=0;i<8;i++)
@@ -57,6 +60,10 @@ GCSControlGadgetConfiguration::GCSControlGadgetConfiguration(QString classId, QS
         udp_port = qSettings->value("controlPortUDP").toUInt();
         udp_host = QHostAddress(qSettings->value("controlHostUDP").toString());
 
+        inputRate = qSettings->value("inputRate", inputRate).toInt();
+        inputDeadband = qSettings->value("inputDeadband", inputDeadband).toDouble();
+        inputExpo = qSettings->value("inputExpo", inputExpo).toDouble();
+
         int i;
         for (i=0;i<8;i++)
         {
@@ -123,6 +130,10 @@ IUAVGadgetConfiguration *GCSControlGadgetConfiguration::clone()
     m->udp_host = udp_host;
     m->udp_port = udp_port;
 
+    m->inputRate = inputRate;
+    m->inputDeadband = inputDeadband;
+    m->inputExpo = inputExpo;
+
     int i;
     for (i=0;i<8;i++)
     {
@@ -150,6 +161,10 @@ void GCSControlGadgetConfiguration::saveConfig(QSettings* settings) const {
     settings->setValue("controlPortUDP",QString::number(udp_port));
     settings->setValue("controlHostUDP",udp_host.toString());
 
+    settings->setValue("inputRate", inputRate);
+    settings->setValue("inputDeadband", inputDeadband);
+    settings->setValue("inputExpo", inputExpo);
+
     int i;
     for (i=0;i<8;i++)
     {
@@ -61,6 +61,12 @@ class GCSControlGadgetConfiguration : public IUAVGadgetConfiguration
     int getControlsMode() { return controlsMode; }
     QList<int>  getChannelsMapping();
     QList<bool>  getChannelsReverse();
+    void setInputRate(int ms) { inputRate = ms; }
+    int getInputRate() { return inputRate; }
+    void setInputDeadband(double deadband) { inputDeadband = deadband; }
+    double getInputDeadband() { return inputDeadband; }
+    void setInputExpo(double expo) { inputExpo = expo; }
+    double getInputExpo() { return inputExpo; }
 
     buttonSettingsStruct getbuttonSettings(int i){return buttonSettings[i];}
     void setbuttonSettingsAction(int i, int ActionID ){buttonSettings[i].ActionID=ActionID;return;}
@@ -83,6 +89,10 @@ class GCSControlGadgetConfiguration : public IUAVGadgetConfiguration
         bool channelReverse[8];
         int udp_port;
         QHostAddress udp_host;
+        // Joystick sampling period in ms, deadband and expo as fractions
+        int inputRate;
+        double inputDeadband;
+        double inputExpo;
 
 
 };
@@ -194,6 +194,10 @@ QWidget *GCSControlGadgetOptionsPage::createPage(QWidget *parent)
     options_page->udp_host->setText(m_config->getUDPControlHost().toString());
     options_page->udp_port->setText(QString::number(m_config->getUDPControlPort()));
 
+    options_page->inputRate->setValue(m_config->getInputRate());
+    options_page->inputDeadband->setValue(m_config->getInputDeadband() * 100);
+    options_page->inputExpo->setValue(m_config->getInputExpo() * 100);
+
 
     // Controls mode are from 1 to 4.
     if (m_config->getControlsMode()>0 && m_config->getControlsMode() < 5)
@@ -271,6 +275,10 @@ void GCSControlGadgetOptionsPage::apply()
 
    m_config->setUDPControlSettings(options_page->udp_port->text().toInt(),options_page->udp_host->text());
 
+   m_config->setInputRate(options_page->inputRate->value());
+   m_config->setInputDeadband(options_page->inputDeadband->value() / 100);
+   m_config->setInputExpo(options_page->inputExpo->value() / 100);
+
 
    int j;
    for (j=0;j<8;j++)
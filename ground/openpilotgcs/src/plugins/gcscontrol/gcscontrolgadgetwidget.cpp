@@ -138,6 +138,7 @@ void GCSControlGadgetWidget::toggleControl(int state)
         m_gcscontrol->checkBoxUDPControl->setEnabled(false);
     }
     obj->setMetadata(mdata);
+    emit joystickControlChanged(getGCSControl() && !getUDPControl());
 }
 
 void GCSControlGadgetWidget::toggleArmed(int state)
@@ -171,6 +172,7 @@ void GCSControlGadgetWidget::toggleUDPControl(int state)
     }else{
         setUDPControl(false);
     }
+    emit joystickControlChanged(getGCSControl() && !getUDPControl());
 }
 
 /*!
@@ -205,6 +207,15 @@ bool GCSControlGadgetWidget::getUDPControl(void)
     return m_gcscontrol->checkBoxUDPControl->isChecked();
 }
 
+/*!
+  \brief Shows the time from a joystick sample until the GUI thread handles
+  the command update, in ms
+  */
+void GCSControlGadgetWidget::setInputDelay(int ms)
+{
+    m_gcscontrol->labelInputDelay->setText(tr("Input delay: %1 ms").arg(ms));
+}
+
 
 /**
   * @}
@@ -49,6 +49,8 @@ public:
 
 signals:
     void sticksChanged(double leftX, double leftY, double rightX, double rightY);
+    // joystick input is applied only with GCS control on and UDP control off
+    void joystickControlChanged(bool enabled);
 
 public slots:
     // signals from parent gadget indicating change from flight
@@ -58,6 +60,8 @@ public slots:
     void leftStickClicked(double X, double Y);
     void rightStickClicked(double X, double Y);
 
+    void setInputDelay(int ms);
+
 protected slots:
     void toggleControl(int state);
     void toggleArmed(int state);
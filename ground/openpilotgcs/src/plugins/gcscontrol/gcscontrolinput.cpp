@@ -0,0 +1,156 @@
+/**
+ ******************************************************************************
+ *
+ * @file       gcscontrolinput.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup GCSControlGadgetPlugin GCSControl Gadget Plugin
+ * @{
+ * @brief Joystick to ManualControlCommand path, runs on the gamepad thread
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "gcscontrolinput.h"
+#include <QTime>
+#include <QDebug>
+#include <string.h>
+
+#define JOYSTICK_MAX 32767.0
+
+// Common time base of the gamepad thread and the GUI thread
+static QTime inputClock;
+
+GCSControlInput::GCSControlInput(ManualControlCommand *mcc, QObject *parent) :
+        QObject(parent),
+        mcc(mcc),
+        enabled(false),
+        rollChannel(-1),
+        pitchChannel(-1),
+        yawChannel(-1),
+        throttleChannel(-1),
+        deadband(0),
+        expo(0),
+        buttonRoll(false),
+        buttonPitch(false),
+        buttonYaw(false),
+        buttonThrottle(false)
+{
+    if (inputClock.isNull())
+        inputClock.start();
+}
+
+/**
+ * Milliseconds on the clock used for the sample times
+ */
+int GCSControlInput::timestamp()
+{
+    return inputClock.elapsed();
+}
+
+void GCSControlInput::setChannels(int roll, int pitch, int yaw, int throttle, const QList<bool> &reverse)
+{
+    QMutexLocker locker(&mutex);
+    rollChannel = roll;
+    pitchChannel = pitch;
+    yawChannel = yaw;
+    throttleChannel = throttle;
+    channelReverse = reverse;
+}
+
+void GCSControlInput::setCurves(double deadband, double expo)
+{
+    QMutexLocker locker(&mutex);
+    this->deadband = qBound(0.0, deadband, 0.99);
+    this->expo = qBound(0.0, expo, 1.0);
+}
+
+void GCSControlInput::setButtonAxes(bool roll, bool pitch, bool yaw, bool throttle)
+{
+    QMutexLocker locker(&mutex);
+    buttonRoll = roll;
+    buttonPitch = pitch;
+    buttonYaw = yaw;
+    buttonThrottle = throttle;
+}
+
+/**
+ * Only update the command while GCS control is on and UDP control is off
+ */
+void GCSControlInput::setEnabled(bool enabled)
+{
+    QMutexLocker locker(&mutex);
+    this->enabled = enabled;
+}
+
+/**
+ * Deadband around the center followed by a blend of a linear and a cubic
+ * response, the full range stays -1 to 1
+ */
+double GCSControlInput::applyCurve(double value)
+{
+    double magnitude = qAbs(value);
+    if (magnitude <= deadband)
+        return 0;
+    magnitude = (magnitude - deadband) / (1 - deadband);
+    magnitude = (1 - expo) * magnitude + expo * magnitude * magnitude * magnitude;
+    return (value < 0) ? -magnitude : magnitude;
+}
+
+/**
+ * Called on the gamepad thread for each sample
+ */
+void GCSControlInput::axesValues(QListInt16 values)
+{
+    int sampleTime = timestamp();
+    QMutexLocker locker(&mutex);
+    if (!enabled)
+        return;
+
+    int chMax = values.length();
+    if (rollChannel >= chMax || pitchChannel >= chMax ||
+            yawChannel >= chMax || throttleChannel >= chMax ) {
+        qDebug() << "GCSControl: configuration is inconsistent with current joystick! Aborting update.";
+        return;
+    }
+
+    double rValue = (rollChannel > -1) ? values[rollChannel] / JOYSTICK_MAX : 0;
+    double pValue = (pitchChannel > -1) ? values[pitchChannel] / JOYSTICK_MAX : 0;
+    double yValue = (yawChannel > -1) ? values[yawChannel] / JOYSTICK_MAX : 0;
+    double tValue = (throttleChannel > -1) ? values[throttleChannel] / JOYSTICK_MAX : 0;
+
+    if (rollChannel > -1 && channelReverse.value(rollChannel)) rValue = -rValue;
+    if (pitchChannel > -1 && channelReverse.value(pitchChannel)) pValue = -pValue;
+    if (yawChannel > -1 && channelReverse.value(yawChannel)) yValue = -yValue;
+    if (throttleChannel > -1 && channelReverse.value(throttleChannel)) tValue = -tValue;
+
+    // The stick mode only changes where the axes are drawn, the joystick
+    // channels map to roll, pitch, yaw and throttle directly. The object
+    // stays locked so button changes from the GUI thread are not lost.
+    QMutexLocker objectLocker(mcc->getMutex());
+    ManualControlCommand::DataFields data = mcc->getData();
+    ManualControlCommand::DataFields old = data;
+    if (!buttonRoll) data.Roll = applyCurve(rValue);
+    if (!buttonPitch) data.Pitch = applyCurve(pValue);
+    if (!buttonYaw) data.Yaw = applyCurve(yValue);
+    if (!buttonThrottle) data.Throttle = -tValue;
+
+    if (memcmp(&data, &old, sizeof(data)) != 0) {
+        mcc->setData(data);
+        emit commandUpdated(sampleTime);
+    }
+}
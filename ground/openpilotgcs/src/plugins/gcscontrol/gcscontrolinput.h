@@ -0,0 +1,89 @@
+/**
+ ******************************************************************************
+ *
+ * @file       gcscontrolinput.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup GCSControlGadgetPlugin GCSControl Gadget Plugin
+ * @{
+ * @brief Joystick to ManualControlCommand path, runs on the gamepad thread
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef GCSCONTROLINPUT_H
+#define GCSCONTROLINPUT_H
+
+#include <QObject>
+#include <QMutex>
+#include "manualcontrolcommand.h"
+#include "sdlgamepad/sdlgamepad.h"
+
+/**
+ * Turns gamepad samples into ManualControlCommand updates.
+ *
+ * axesValues() is connected directly to the SDLGamepad signal, so the channel
+ * mapping, deadband and expo are applied on the gamepad thread right after
+ * each sample and the command is written without a trip through the GUI event
+ * loop. The object update is then queued to the telemetry like any other
+ * object change, commandUpdated() carries the sample time so the GUI can show
+ * the delay until it handles the update.
+ *
+ * The gamepad thread calls axesValues() directly, the owner must stop it with
+ * SDLGamepad::suspend() before deleting this object.
+ */
+class GCSControlInput : public QObject
+{
+    Q_OBJECT
+
+public:
+    GCSControlInput(ManualControlCommand *mcc, QObject *parent = 0);
+
+    void setChannels(int roll, int pitch, int yaw, int throttle, const QList<bool> &reverse);
+    void setCurves(double deadband, double expo);
+    void setButtonAxes(bool roll, bool pitch, bool yaw, bool throttle);
+
+    static int timestamp();
+
+public slots:
+    void setEnabled(bool enabled);
+    void axesValues(QListInt16 values);
+
+signals:
+    void commandUpdated(int sampleTime);
+
+private:
+    double applyCurve(double value);
+
+    ManualControlCommand *mcc;
+    QMutex mutex;
+    bool enabled;
+    int rollChannel;
+    int pitchChannel;
+    int yawChannel;
+    int throttleChannel;
+    QList<bool> channelReverse;
+    double deadband;
+    double expo;
+    // Axes driven by buttons are left alone
+    bool buttonRoll;
+    bool buttonPitch;
+    bool buttonYaw;
+    bool buttonThrottle;
+};
+
+#endif // GCSCONTROLINPUT_H
@@ -26,6 +26,7 @@
  */
 
 #include "fgsimulator.h"
+#include "hitlpacket.h"
 #include "extensionsystem/pluginmanager.h"
 #include "coreplugin/icore.h"
 #include "coreplugin/threadmanager.h"
@@ -54,6 +55,7 @@ FGSimulator::FGSimulator(const SimulatorSettings& params) :
 {
     udpCounterFGrecv = 0;
     udpCounterGCSsend = 0;
+    binaryProtocol = false;
 }
 
 FGSimulator::~FGSimulator()
@@ -109,6 +111,8 @@ bool FGSimulator::setupProcess()
 	// Setup arguments
 	// Note: The input generic protocol is set to update at a much higher rate than the actual updates are sent by the GCS.
 	// If this is not done then a lag will be introduced by FlightGear, likelly because the receive socket buffer builds up during startup.
+	// In lockstep mode the fixed size binary protocol is used, see hitlpacket.h
+	QString protocol(settings.lockstep ? "opfgprotocolbin" : "opfgprotocol");
         QString args("--fg-root=\"" + settings.dataPath + "\" " +
                      "--timeofday=noon " +
                      "--httpd=5400 " +
@@ -117,10 +121,10 @@ bool FGSimulator::setupProcess()
                      "--altitude=3000 " +
                      "--vc=100 " +
                      "--log-level=alert " +
-                     "--generic=socket,out,20," + settings.hostAddress + "," + QString::number(settings.inPort) + ",udp,opfgprotocol");
+                     "--generic=socket,out,20," + settings.hostAddress + "," + QString::number(settings.inPort) + ",udp," + protocol);
 	if(!settings.manual)
 	{
-            args.append(" --generic=socket,in,400," + settings.remoteHostAddress + "," + QString::number(settings.outPort) + ",udp,opfgprotocol");
+            args.append(" --generic=socket,in,400," + settings.remoteHostAddress + "," + QString::number(settings.outPort) + ",udp," + protocol);
 	}
 
         // Start FlightGear - only if checkbox is selected in HITL options page
@@ -192,10 +196,29 @@ void FGSimulator::transmitUpdate()
     if(udpCounterFGrecv == udpCounterGCSsend)
         udpCounterGCSsend = 0;
     
-    if((udpCounterGCSsend < allowableDifference) || (udpCounterFGrecv==0) ) //FG udp queue is not delayed
+    if(settings.lockstep || (udpCounterGCSsend < allowableDifference) || (udpCounterFGrecv==0) ) //FG udp queue is not delayed
     {       
         udpCounterGCSsend++;
 
+        if(binaryProtocol)
+        {
+            // Fixed size record, encoded on the stack
+            HITLPacket::Control control;
+            char packet[HITLPacket::CONTROL_SIZE];
+            control.field[0] = ailerons;
+            control.field[1] = elevator;
+            control.field[2] = rudder;
+            control.field[3] = throttle;
+            control.counter = udpCounterGCSsend;
+            HITLPacket::encodeControl(control, packet);
+
+            if(outSocket->writeDatagram(packet, sizeof(packet), QHostAddress(settings.remoteHostAddress), settings.outPort) == -1)
+            {
+                emit processOutput("Error sending UDP packet to FG: " + outSocket->errorString() + "\n");
+            }
+        }
+        else
+        {
 	// Send update to FlightGear
 	QString cmd;
         cmd = QString("%1,%2,%3,%4,%5\n")
@@ -211,6 +234,7 @@ void FGSimulator::transmitUpdate()
         {
             emit processOutput("Error sending UDP packet to FG: " + outSocket->errorString() + "\n");
         }
+        }
     }
     else
     {
@@ -236,61 +260,68 @@ void FGSimulator::processUpdate(const QByteArray& inp)
 {
     //TODO: this does not use the FLIGHT_PARAM structure, it should!
         static char once=0;
-	// Split
-	QString data(inp);
-	QStringList fields = data.split(",");
+	// Decode, binary records are recognised by their size and footer, anything else is taken as a text line
+	HITLPacket::State state;
+	if(HITLPacket::decodeState(inp.constData(), inp.size(), &state))
+	{
+	    binaryProtocol = true;
+	}
+	else if(!HITLPacket::decodeStateText(inp, &state))
+	{
+	    return;
+	}
+	const float* fields = state.field;
 	// Get xRate (deg/s)
-//        float xRate = fields[0].toFloat() * 180.0/M_PI;
+//        float xRate = fields[0] * 180.0/M_PI;
 	// Get yRate (deg/s)
-//        float yRate = fields[1].toFloat() * 180.0/M_PI;
+//        float yRate = fields[1] * 180.0/M_PI;
 	// Get zRate (deg/s)
-//        float zRate = fields[2].toFloat() * 180.0/M_PI;
+//        float zRate = fields[2] * 180.0/M_PI;
 	// Get xAccel (m/s^2)
-//        float xAccel = fields[3].toFloat() * FT2M;
+//        float xAccel = fields[3] * FT2M;
 	// Get yAccel (m/s^2)
-//        float yAccel = fields[4].toFloat() * FT2M;
+//        float yAccel = fields[4] * FT2M;
 	// Get xAccel (m/s^2)
-//        float zAccel = fields[5].toFloat() * FT2M;
+//        float zAccel = fields[5] * FT2M;
 	// Get pitch (deg)
-	float pitch = fields[6].toFloat();
+	float pitch = fields[6];
 	// Get pitchRate (deg/s)
-        float pitchRate = fields[7].toFloat();
+        float pitchRate = fields[7];
 	// Get roll (deg)
-	float roll = fields[8].toFloat();
+	float roll = fields[8];
 	// Get rollRate (deg/s)
-        float rollRate = fields[9].toFloat();
+        float rollRate = fields[9];
 	// Get yaw (deg)
-	float yaw = fields[10].toFloat();
+	float yaw = fields[10];
 	// Get yawRate (deg/s)
-        float yawRate = fields[11].toFloat();
+        float yawRate = fields[11];
 	// Get latitude (deg)
-	float latitude = fields[12].toFloat();
+	float latitude = fields[12];
 	// Get longitude (deg)
-	float longitude = fields[13].toFloat();
+	float longitude = fields[13];
 	// Get heading (deg)
-	float heading = fields[14].toFloat();
+	float heading = fields[14];
 	// Get altitude (m)
-	float altitude = fields[15].toFloat() * FT2M;
+	float altitude = fields[15] * FT2M;
 	// Get altitudeAGL (m)
-	float altitudeAGL = fields[16].toFloat() * FT2M;
+	float altitudeAGL = fields[16] * FT2M;
 	// Get groundspeed (m/s)
-	float groundspeed = fields[17].toFloat() * KT2MPS;
+	float groundspeed = fields[17] * KT2MPS;
 	// Get airspeed (m/s)
-//	float airspeed = fields[18].toFloat() * KT2MPS;
+//	float airspeed = fields[18] * KT2MPS;
 	// Get temperature (degC)
-	float temperature = fields[19].toFloat();
+	float temperature = fields[19];
 	// Get pressure (kpa)
-	float pressure = fields[20].toFloat() * INHG2KPA;
+	float pressure = fields[20] * INHG2KPA;
 	// Get VelocityActual Down (cm/s)
-        float velocityActualDown = - fields[21].toFloat() * FPS2CMPS;
+        float velocityActualDown = - fields[21] * FPS2CMPS;
 	// Get VelocityActual East (cm/s)
-	float velocityActualEast = fields[22].toFloat() * FPS2CMPS;	
+	float velocityActualEast = fields[22] * FPS2CMPS;	
 	// Get VelocityActual Down (cm/s)
-	float velocityActualNorth = fields[23].toFloat() * FPS2CMPS;
+	float velocityActualNorth = fields[23] * FPS2CMPS;
 
         // Get UDP packets received by FG
-        int n = fields[24].toInt();
-        udpCounterFGrecv = n;
+        udpCounterFGrecv = state.counter;
 
         //run once
         HomeLocation::DataFields homeData = posHome->getData();
@@ -50,6 +50,7 @@ private:
 
     int udpCounterGCSsend; //keeps track of udp packets sent to FG
     int udpCounterFGrecv; //keeps track of udp packets received by FG
+    bool binaryProtocol; //FG talks opfgprotocolbin, answer in kind
 
 	void processUpdate(const QByteArray& data);
 };
@@ -35,6 +35,7 @@ HITLConfiguration::HITLConfiguration(QString classId, QSettings* qSettings, QObj
         settings.dataPath = "";
         settings.manual = false;
         settings.startSim = false;
+        settings.lockstep = false;
         settings.hostAddress = "127.0.0.1";
         settings.remoteHostAddress = "127.0.0.1";
         settings.outPort = 0;
@@ -49,6 +50,7 @@ HITLConfiguration::HITLConfiguration(QString classId, QSettings* qSettings, QObj
                 settings.dataPath = qSettings->value("dataPath").toString();
                 settings.manual = qSettings->value("manual").toBool();
                 settings.startSim = qSettings->value("startSim").toBool();
+                settings.lockstep = qSettings->value("lockstep").toBool();
                 settings.hostAddress = qSettings->value("hostAddress").toString();
                 settings.remoteHostAddress = qSettings->value("remoteHostAddress").toString();
                 settings.outPort = qSettings->value("outPort").toInt();
@@ -76,6 +78,7 @@ void HITLConfiguration::saveConfig(QSettings* qSettings) const {
     qSettings->setValue("dataPath", settings.dataPath);
     qSettings->setValue("manual", settings.manual);
     qSettings->setValue("startSim", settings.startSim);
+    qSettings->setValue("lockstep", settings.lockstep);
     qSettings->setValue("hostAddress", settings.hostAddress);
     qSettings->setValue("remoteHostAddress", settings.remoteHostAddress);
     qSettings->setValue("outPort", settings.outPort);
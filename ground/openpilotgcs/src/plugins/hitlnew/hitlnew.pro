@@ -10,6 +10,7 @@ HEADERS += hitlplugin.h \
     hitlconfiguration.h \
     hitlgadget.h \
     simulator.h \
+    hitlpacket.h \
     fgsimulator.h \
     il2simulator.h \
     xplanesimulator.h
@@ -20,10 +21,13 @@ SOURCES += hitlplugin.cpp \
     hitlconfiguration.cpp \
     hitlgadget.cpp \
     simulator.cpp \
+    hitlpacket.cpp \
     il2simulator.cpp \
     fgsimulator.cpp \
     xplanesimulator.cpp
-OTHER_FILES += hitlnew.pluginspec
+OTHER_FILES += hitlnew.pluginspec \
+    opfgprotocolbin.xml \
+    hitlstubsim.py
 FORMS += hitloptionspage.ui \
     hitlwidget.ui
 RESOURCES += hitlresources.qrc
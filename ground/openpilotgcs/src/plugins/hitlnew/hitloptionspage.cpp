@@ -78,6 +78,7 @@ QWidget *HITLOptionsPage::createPage(QWidget *parent)
 	m_optionsPage->dataPath->setPath(config->Settings().dataPath);
 	m_optionsPage->manualControl->setChecked(config->Settings().manual);
         m_optionsPage->startSim->setChecked(config->Settings().startSim);
+        m_optionsPage->lockstep->setChecked(config->Settings().lockstep);
 
         m_optionsPage->hostAddress->setText(config->Settings().hostAddress);
         m_optionsPage->remoteHostAddress->setText(config->Settings().remoteHostAddress);
@@ -99,6 +100,7 @@ void HITLOptionsPage::apply()
 	settings.dataPath = m_optionsPage->dataPath->path();
 	settings.manual = m_optionsPage->manualControl->isChecked();
         settings.startSim = m_optionsPage->startSim->isChecked();
+        settings.lockstep = m_optionsPage->lockstep->isChecked();
 	settings.hostAddress = m_optionsPage->hostAddress->text();
         settings.remoteHostAddress = m_optionsPage->remoteHostAddress->text();
 
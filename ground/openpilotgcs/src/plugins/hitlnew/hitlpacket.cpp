@@ -0,0 +1,99 @@
+/**
+ ******************************************************************************
+ *
+ * @file       hitlpacket.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup HITLPlugin HITL Plugin
+ * @{
+ * @brief Binary simulator protocol used by the Hardware In The Loop plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "hitlpacket.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QtEndian>
+#include <string.h>
+
+namespace HITLPacket
+{
+
+static inline float readFloat(const uchar* src)
+{
+    quint32 raw = qFromBigEndian<quint32>(src);
+    float value;
+    memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+static inline void writeFloat(float value, uchar* dst)
+{
+    quint32 raw;
+    memcpy(&raw, &value, sizeof(raw));
+    qToBigEndian<quint32>(raw, dst);
+}
+
+/**
+ * Decode a binary state record in place, returns false if the data is not one
+ * (wrong size, foreign footer or a different protocol version)
+ */
+bool decodeState(const char* data, int size, State* state)
+{
+    const uchar* src = reinterpret_cast<const uchar*>(data);
+
+    if ( size != STATE_SIZE || qFromBigEndian<quint32>(src + STATE_SIZE - 4) != MAGIC )
+        return false;
+
+    for ( int n = 0; n < STATE_FIELDS; ++n )
+        state->field[n] = readFloat(src + n * 4);
+    state->counter = qFromBigEndian<qint32>(src + STATE_FIELDS * 4);
+    return true;
+}
+
+/**
+ * Decode a legacy comma separated state line (opfgprotocol.xml)
+ */
+bool decodeStateText(const QByteArray& data, State* state)
+{
+    QList<QByteArray> fields = data.split(',');
+
+    if ( fields.size() < STATE_FIELDS + 1 )
+        return false;
+
+    for ( int n = 0; n < STATE_FIELDS; ++n )
+        state->field[n] = fields[n].toFloat();
+    state->counter = fields[STATE_FIELDS].trimmed().toInt();
+    return true;
+}
+
+/**
+ * Encode a control record into buffer, which must hold CONTROL_SIZE bytes
+ */
+void encodeControl(const Control& control, char* buffer)
+{
+    uchar* dst = reinterpret_cast<uchar*>(buffer);
+
+    for ( int n = 0; n < CONTROL_FIELDS; ++n )
+        writeFloat(control.field[n], dst + n * 4);
+    qToBigEndian<qint32>(control.counter, dst + CONTROL_FIELDS * 4);
+    qToBigEndian<quint32>(MAGIC, dst + CONTROL_FIELDS * 4 + 4);
+}
+
+}
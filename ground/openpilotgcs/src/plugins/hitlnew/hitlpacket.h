@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ *
+ * @file       hitlpacket.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup HITLPlugin HITL Plugin
+ * @{
+ * @brief Binary simulator protocol used by the Hardware In The Loop plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef HITLPACKET_H
+#define HITLPACKET_H
+
+#include <QtGlobal>
+
+class QByteArray;
+
+/**
+ * Fixed layout records exchanged with the simulator, matching the FlightGear
+ * generic protocol in binary mode (opfgprotocolbin.xml). Every value is 4 bytes
+ * in network byte order and each record ends with a magic footer whose last
+ * byte is the protocol version, so a record can be told apart from the legacy
+ * comma separated text format by its size and footer alone.
+ *
+ * State record (simulator -> GCS): STATE_FIELDS floats in the same order as the
+ * text protocol, followed by the number of control records the simulator has
+ * consumed and the footer.
+ *
+ * Control record (GCS -> simulator): aileron, elevator, rudder and throttle,
+ * followed by the GCS send counter and the footer.
+ */
+namespace HITLPacket
+{
+    const quint32 MAGIC = 0x4f504831; // "OPH1"
+
+    enum {
+        STATE_FIELDS = 24,
+        STATE_SIZE = (STATE_FIELDS + 2) * 4,
+        CONTROL_FIELDS = 4,
+        CONTROL_SIZE = (CONTROL_FIELDS + 2) * 4
+    };
+
+    struct State {
+        float field[STATE_FIELDS];
+        qint32 counter;
+    };
+
+    struct Control {
+        float field[CONTROL_FIELDS];
+        qint32 counter;
+    };
+
+    bool decodeState(const char* data, int size, State* state);
+    bool decodeStateText(const QByteArray& data, State* state);
+    void encodeControl(const Control& control, char* buffer);
+}
+
+#endif // HITLPACKET_H
@@ -0,0 +1,112 @@
+#!/usr/bin/env python
+#
+# Minimal stand-in for FlightGear speaking the binary HITL protocol
+# (hitlpacket.h, opfgprotocolbin.xml). Useful to exercise the HITL plugin,
+# and to measure its step latency, without a real simulator.
+#
+# The vehicle is a crude rigid body: aileron, elevator and rudder command
+# the roll, pitch and yaw rates. In lockstep mode (-l) the next state is only
+# sent once the GCS has answered the previous one, matching the "Lockstep
+# with simulator" option of the HITL gadget.
+#
+# (c) 2012, The OpenPilot Team, http://www.openpilot.org
+# See also: The GNU Public License (GPL) Version 3
+#
+
+from __future__ import print_function
+
+import optparse
+import socket
+import struct
+import sys
+import time
+
+# Must match hitlpacket.h
+MAGIC = 0x4f504831
+STATE = struct.Struct(">24fiI")
+CONTROL = struct.Struct(">4fiI")
+
+
+def main():
+    parser = optparse.OptionParser(usage="%prog [options]")
+    parser.add_option("--gcs", default="127.0.0.1",
+                      help="address of the GCS")
+    parser.add_option("-i", "--in-port", type="int", default=40100,
+                      help="port the GCS sends controls to (HITL output port)")
+    parser.add_option("-o", "--out-port", type="int", default=40200,
+                      help="port the GCS listens on (HITL input port)")
+    parser.add_option("-r", "--rate", type="float", default=50.0,
+                      help="simulation steps per second, 0 for as fast as possible in lockstep mode")
+    parser.add_option("-l", "--lockstep", action="store_true", default=False,
+                      help="wait for the GCS to answer every step")
+    (options, args) = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("", options.in_port))
+    sock.settimeout(1.0 if options.lockstep else 0.0)
+
+    dt = 1.0 / options.rate if options.rate > 0 else 0.02
+    roll = pitch = yaw = 0.0
+    controls = (0.0, 0.0, 0.0, 0.0)
+    received = 0
+    steps = 0
+    latency = []
+    report = time.time()
+
+    while True:
+        start = time.time()
+        # Aileron, elevator and rudder map to up to 90 deg/s of rotation
+        p, q, r = controls[0] * 90.0, -controls[1] * 90.0, controls[2] * 90.0
+        roll = max(-180.0, min(180.0, roll + p * dt))
+        pitch = max(-90.0, min(90.0, pitch + q * dt))
+        yaw = (yaw + r * dt) % 360.0
+        state = STATE.pack(0.0, 0.0, 0.0,
+                           0.0, 0.0, -32.17,
+                           pitch, q, roll, p, yaw, r,
+                           37.4, -122.1, yaw,
+                           3000.0, 3000.0,
+                           100.0, 100.0,
+                           15.0, 29.92,
+                           0.0, 0.0, 168.8,
+                           received, MAGIC)
+        sock.sendto(state, (options.gcs, options.out_port))
+        sent = time.time()
+        steps += 1
+
+        # Collect controls, blocking for the answer in lockstep mode
+        while True:
+            try:
+                data = sock.recv(1024)
+            except (socket.timeout, socket.error):
+                if options.lockstep:
+                    print("no answer from GCS for step %d" % steps)
+                break
+            if len(data) != CONTROL.size or CONTROL.unpack(data)[5] != MAGIC:
+                continue
+            controls = CONTROL.unpack(data)[:4]
+            received += 1
+            if options.lockstep:
+                latency.append(time.time() - sent)
+                break
+
+        now = time.time()
+        if now - report >= 5.0:
+            if latency:
+                latency.sort()
+                print("%d steps, step latency median %.2fms max %.2fms" %
+                      (steps, latency[len(latency) // 2] * 1e3, latency[-1] * 1e3))
+            else:
+                print("%d steps, %d controls received" % (steps, received))
+            latency = []
+            report = now
+        if options.rate > 0:
+            delay = dt - (now - start)
+            if delay > 0:
+                time.sleep(delay)
+    return 0
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except KeyboardInterrupt:
+        pass
@@ -54,6 +54,7 @@ Simulator::Simulator(const SimulatorSettings& params) :
 	simConnectionStatus(false),
 	txTimer(NULL),
 	simTimer(NULL),
+	stepPending(false),
 	name("")
 {
 	// move to thread
@@ -170,11 +171,15 @@ void Simulator::onStart()
 
 	connect(inSocket, SIGNAL(readyRead()), this, SLOT(receiveUpdate()),Qt::DirectConnection);
 
-	// Setup transmit timer
+	// Setup transmit timer, in lockstep mode the simulator is answered once per
+	// received step instead, as soon as the autopilot has reacted to it
 	txTimer = new QTimer();
 	connect(txTimer, SIGNAL(timeout()), this, SLOT(transmitUpdate()),Qt::DirectConnection);
 	txTimer->setInterval(updatePeriod);
-	txTimer->start();
+	if ( settings.lockstep )
+		connect(actDesired, SIGNAL(objectUnpacked(UAVObject*)), this, SLOT(onAutopilotStep(UAVObject*)));
+	else
+		txTimer->start();
 	// Setup simulator connection timer
 	simTimer = new QTimer();
 	connect(simTimer, SIGNAL(timeout()), this, SLOT(onSimulatorConnectionTimeout()),Qt::DirectConnection);
@@ -203,17 +208,34 @@ void Simulator::receiveUpdate()
 
 	// Process data
         while(inSocket->hasPendingDatagrams()) {
-		// Receive datagram
-		QByteArray datagram;
-		datagram.resize(inSocket->pendingDatagramSize());
-		QHostAddress sender;
-		quint16 senderPort;
-		inSocket->readDatagram(datagram.data(), datagram.size(),
-							   &sender, &senderPort);
-		//QString datastr(datagram);
+		// Receive datagram, the buffer is reused so that fixed size
+		// simulator packets do not cause an allocation each
+		rxBuffer.resize(inSocket->pendingDatagramSize());
+		inSocket->readDatagram(rxBuffer.data(), rxBuffer.size());
 		// Process incomming data
-		processUpdate(datagram);
+		processUpdate(rxBuffer);
 	 }
+
+	// In lockstep mode the simulator waits for our answer to this step
+	if ( settings.lockstep )
+	{
+		if ( settings.manual || !autopilotConnectionStatus )
+			transmitUpdate();
+		else
+			stepPending = true;
+	}
+}
+
+void Simulator::onAutopilotStep(UAVObject* obj)
+{
+	Q_UNUSED(obj);
+
+	// ActuatorDesired arrived from the autopilot, answer the pending step with it
+	if ( stepPending )
+	{
+		stepPending = false;
+		transmitUpdate();
+	}
 }
 
 void Simulator::setupObjects()
@@ -241,7 +263,8 @@ void Simulator::setupInputObject(UAVObject* obj, int updatePeriod)
 	UAVObject::SetFlightAccess(mdata, UAVObject::ACCESS_READWRITE);
 	UAVObject::SetGcsAccess(mdata, UAVObject::ACCESS_READWRITE);
 	UAVObject::SetFlightTelemetryAcked(mdata, false);
-	UAVObject::SetFlightTelemetryUpdateMode(mdata, UAVObject::UPDATEMODE_PERIODIC);
+	// Lockstep needs every autopilot output, not a periodic sample of them
+	UAVObject::SetFlightTelemetryUpdateMode(mdata, settings.lockstep ? UAVObject::UPDATEMODE_ONCHANGE : UAVObject::UPDATEMODE_PERIODIC);
 	mdata.flightTelemetryUpdatePeriod = updatePeriod;
 	UAVObject::SetGcsTelemetryUpdateMode(mdata, UAVObject::UPDATEMODE_MANUAL);
 	obj->setMetadata(mdata);
@@ -255,7 +278,7 @@ void Simulator::setupOutputObject(UAVObject* obj, int updatePeriod)
 	UAVObject::SetGcsAccess(mdata, UAVObject::ACCESS_READWRITE);
 	UAVObject::SetFlightTelemetryUpdateMode(mdata,UAVObject::UPDATEMODE_MANUAL);
 	UAVObject::SetGcsTelemetryAcked(mdata, false);
-	UAVObject::SetGcsTelemetryUpdateMode(mdata, UAVObject::UPDATEMODE_PERIODIC);
+	UAVObject::SetGcsTelemetryUpdateMode(mdata, settings.lockstep ? UAVObject::UPDATEMODE_ONCHANGE : UAVObject::UPDATEMODE_PERIODIC);
 	mdata.gcsTelemetryUpdatePeriod = updatePeriod;
 	obj->setMetadata(mdata);
 }
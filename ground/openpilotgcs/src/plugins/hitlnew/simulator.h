@@ -104,6 +104,7 @@ typedef struct _CONNECTION
 	int inPort;
 	bool manual;
         bool startSim;
+        bool lockstep;
 	QString latitude;
 	QString longitude;
 } SimulatorSettings;
@@ -152,6 +153,7 @@ private slots:
 	void onAutopilotDisconnect();
 	void onSimulatorConnectionTimeout();
 	void telStatsUpdated(UAVObject* obj);
+	void onAutopilotStep(UAVObject* obj);
 	Q_INVOKABLE void onDeleteSimulator(void);
 
 	virtual void transmitUpdate() = 0;
@@ -197,6 +199,8 @@ private:
 	volatile bool simConnectionStatus;
 	QTimer* txTimer;
 	QTimer* simTimer;
+	QByteArray rxBuffer;
+	bool stepPending;
 	QString name;
 	QString simulatorId;
 	volatile static bool isStarted;
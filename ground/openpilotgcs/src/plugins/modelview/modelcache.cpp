@@ -0,0 +1,179 @@
+/**
+ ******************************************************************************
+ *
+ * @file       modelcache.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ModelViewPlugin ModelView Plugin
+ * @{
+ * @brief Binary cache of the models displayed by the gadget
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "modelcache.h"
+
+#include "glc_exception.h"
+#include "geometry/glc_bsrep.h"
+#include "geometry/glc_mesh.h"
+#include "io/glc_bsreptoworld.h"
+#include "io/glc_fileloader.h"
+#include "sceneGraph/glc_structoccurence.h"
+#include "sceneGraph/glc_structreference.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QtDebug>
+
+ModelCache::ModelCache(const QString& cacheDir) :
+    m_CacheDir(cacheDir)
+{
+}
+
+/**
+ * Load a model, from the cache when its entry is current. Otherwise the
+ * model is parsed and the entry is written again. Errors while parsing the
+ * model are thrown as GLC_Exception.
+ */
+GLC_World ModelCache::loadWorld(const QString& fileName)
+{
+    QString entry = entryName(fileName);
+
+    if (isCurrent(fileName)) {
+        try {
+            QFile entryFile(entry + ".BSRep");
+            GLC_BSRepToWorld bsRepToWorld;
+            GLC_World* pWorld = bsRepToWorld.CreateWorldFromBSRep(entryFile);
+            GLC_World world(*pWorld);
+            delete pWorld;
+            return world;
+        }
+        catch(GLC_Exception e)
+        {
+            qDebug() << "ModelView: model cache entry" << entry << "is not usable.";
+        }
+    }
+    QFile::remove(entry + ".key");
+    QFile::remove(entry + ".BSRep");
+
+    // The factory lives on the GUI thread, use a loader of our own
+    QFile file(fileName);
+    QStringList attachedFiles;
+    GLC_FileLoader loader;
+    GLC_World world = loader.createWorldFromFile(file, &attachedFiles);
+    if (!save(world, fileName, attachedFiles))
+        qDebug() << "ModelView: model" << fileName << "could not be cached.";
+    return world;
+}
+
+/**
+ * True if the cache holds an entry for the model and neither the model nor
+ * any of the files it references has changed since it was written.
+ */
+bool ModelCache::isCurrent(const QString& fileName) const
+{
+    QString entry = entryName(fileName);
+    QFile keyFile(entry + ".key");
+    if (!QFile::exists(entry + ".BSRep") || !keyFile.open(QFile::ReadOnly | QFile::Text))
+        return false;
+
+    QTextStream key(&keyFile);
+    key.setCodec("UTF-8");
+    int files = 0;
+    while (!key.atEnd()) {
+        QString line = key.readLine();
+        if (line != fileKey(line.section('\t', 2)))
+            return false;
+        ++files;
+    }
+    return files > 0;
+}
+
+/**
+ * Path of a cache entry without its extension, named after the model path.
+ */
+QString ModelCache::entryName(const QString& fileName) const
+{
+    QString path = QFileInfo(fileName).absoluteFilePath();
+    return m_CacheDir + QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+/**
+ * Size, modification time and path of a file, as stored in the key of an
+ * entry. Missing files get an empty key.
+ */
+QString ModelCache::fileKey(const QString& fileName)
+{
+    QFileInfo info(fileName);
+    if (!info.exists())
+        return QString();
+    return QString("%1\t%2\t%3").arg(info.size()).arg(info.lastModified().toTime_t()).arg(info.absoluteFilePath());
+}
+
+/**
+ * Write all meshes of a world into a single representation in the cache,
+ * followed by the key of the entry. The occurence matrices are applied to
+ * the meshes, the attitude is set on the root occurence which is kept when
+ * the entry is loaded.
+ */
+bool ModelCache::save(const GLC_World& world, const QString& fileName, const QStringList& attachedFiles) const
+{
+    GLC_3DRep rep;
+    foreach (GLC_StructOccurence* occurence, world.listOfOccurence()) {
+        if (!occurence->hasRepresentation())
+            continue;
+        GLC_3DRep* occurenceRep = dynamic_cast<GLC_3DRep*>(occurence->structReference()->representationHandle());
+        if (occurenceRep == NULL)
+            return false;
+        for (int i = 0; i < occurenceRep->numberOfBody(); ++i) {
+            // Only meshes can be serialized
+            GLC_Mesh* mesh = dynamic_cast<GLC_Mesh*>(occurenceRep->geomAt(i));
+            if (mesh == NULL)
+                return false;
+            GLC_Mesh* copy = new GLC_Mesh(*mesh);
+            copy->transformVertice(occurence->absoluteMatrix());
+            rep.addGeom(copy);
+        }
+    }
+    if (rep.isEmpty())
+        return false;
+    rep.setLastModified(QFileInfo(fileName).lastModified());
+
+    QDir cacheDir(m_CacheDir);
+    if (!cacheDir.exists() && !cacheDir.mkpath("."))
+        return false;
+
+    // Uncompressed, the entry is read on every load of the gadget
+    QString entry = entryName(fileName);
+    GLC_BSRep bsRep(entry + ".BSRep", false);
+    if (!bsRep.save(rep))
+        return false;
+
+    // The key is written last, an entry without one is never used
+    QFile keyFile(entry + ".key");
+    if (!keyFile.open(QFile::WriteOnly | QFile::Truncate | QFile::Text))
+        return false;
+    QTextStream key(&keyFile);
+    key.setCodec("UTF-8");
+    key << fileKey(fileName) << "\n";
+    foreach (QString attachedFile, attachedFiles)
+        key << fileKey(attachedFile) << "\n";
+    return key.status() == QTextStream::Ok;
+}
@@ -0,0 +1,62 @@
+/**
+ ******************************************************************************
+ *
+ * @file       modelcache.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ModelViewPlugin ModelView Plugin
+ * @{
+ * @brief Binary cache of the models displayed by the gadget
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef MODELCACHE_H_
+#define MODELCACHE_H_
+
+#include <QString>
+#include <QStringList>
+
+#include "sceneGraph/glc_world.h"
+
+/**
+ * Keeps loaded models in GLC's binary format. Parsing a model and building
+ * its meshes takes seconds for large models, reading the binary entry back
+ * does not.
+ *
+ * An entry is named after the model path. Next to it a key lists the path,
+ * size and modification time of the model and of every file it references
+ * (material libraries, textures). The entry is only used while all of them
+ * are unchanged, so checking it never reads the model itself.
+ */
+class ModelCache
+{
+public:
+    ModelCache(const QString& cacheDir);
+
+    GLC_World loadWorld(const QString& fileName);
+    bool isCurrent(const QString& fileName) const;
+
+private:
+    QString entryName(const QString& fileName) const;
+    static QString fileKey(const QString& fileName);
+    bool save(const GLC_World& world, const QString& fileName, const QStringList& attachedFiles) const;
+
+    QString m_CacheDir;
+};
+
+#endif /* MODELCACHE_H_ */
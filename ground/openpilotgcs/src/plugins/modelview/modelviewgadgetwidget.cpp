@@ -32,9 +32,28 @@
 #include "glc_exception.h"
 #include "glc_openglexception.h"
 #include "viewport/glc_userinput.h"
+#include "modelcache.h"
+#include "utils/pathutils.h"
 
+#include <QtConcurrentRun>
 #include <iostream>
 
+/**
+ * Load a model on a worker thread, through the model cache in the GCS
+ * storage path. An empty world is returned on errors.
+ */
+static GLC_World loadWorld(QString fileName)
+{
+    try {
+        ModelCache cache(Utils::PathUtils().GetStoragePath() + "modelcache/");
+        return cache.loadWorld(fileName);
+    }
+    catch(GLC_Exception e)
+    {
+        return GLC_World();
+    }
+}
+
 ModelViewGadgetWidget::ModelViewGadgetWidget(QWidget *parent) 
 : QGLWidget(new GLC_Context(QGLFormat(QGL::SampleBuffers)),parent)
 , m_Light()
@@ -61,6 +80,7 @@ ModelViewGadgetWidget::ModelViewGadgetWidget(QWidget *parent)
     attActual = AttitudeActual::GetInstance(objManager);
 
     connect(&m_MotionTimer, SIGNAL(timeout()), this, SLOT(updateAttitude()));
+    connect(&m_WorldLoader, SIGNAL(finished()), this, SLOT(worldLoaded()));
 }
 
 ModelViewGadgetWidget::~ModelViewGadgetWidget()
@@ -202,22 +222,28 @@ void ModelViewGadgetWidget::CreateScene()
         qDebug("ModelView: background image file loading failed.");
     }
 
-    try
-    {
-        if(QFile::exists(acFilename))
-        {
-            QFile aircraft(acFilename);
-            m_World= GLC_Factory::instance()->createWorldFromFile(aircraft);
-            m_ModelBoundingBox= m_World.boundingBox();
-            m_GlView.reframe(m_ModelBoundingBox); // center 3D model in the scene
-        } else {
-        	qDebug("ModelView: aircraft file not found.");
-        }
-    }
-    catch(GLC_Exception e)
-    {
+    // The current model stays on screen until the new one is loaded
+    if(QFile::exists(acFilename))
+        m_WorldLoader.setFuture(QtConcurrent::run(loadWorld, acFilename));
+    else
+        qDebug("ModelView: aircraft file not found.");
+}
+
+/**
+ * Swap the loaded model in, called on the GUI thread
+ */
+void ModelViewGadgetWidget::worldLoaded()
+{
+    GLC_World world = m_WorldLoader.result();
+    if (world.isEmpty()) {
         qDebug("ModelView: aircraft file loading failed.");
+        return;
     }
+    m_World = world;
+    m_World.collection()->setVboUsage(vboEnable);
+    m_ModelBoundingBox= m_World.boundingBox();
+    m_GlView.reframe(m_ModelBoundingBox); // center 3D model in the scene
+    updateGL();
 }
 
 void ModelViewGadgetWidget::wheelEvent(QWheelEvent * e)
@@ -30,6 +30,7 @@
 
 #include <QtOpenGL/QGLWidget>
 #include <QTimer>
+#include <QFutureWatcher>
 
 #include "glc_factory.h"
 #include "viewport/glc_viewport.h"
@@ -76,6 +77,7 @@ private:
 //////////////////////////////////////////////////////////////////////
 private slots:
     void updateAttitude();
+    void worldLoaded();
 
 private:
     GLC_Factory* m_pFactory;
@@ -86,6 +88,8 @@ private:
     GLC_BoundingBox m_ModelBoundingBox;
     //! The timer used for motion
     QTimer m_MotionTimer;
+    //! Loads the model in the background
+    QFutureWatcher<GLC_World> m_WorldLoader;
 
     QString acFilename;
     QString bgFilename;
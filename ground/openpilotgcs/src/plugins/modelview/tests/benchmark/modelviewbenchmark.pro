@@ -0,0 +1,17 @@
+# Benchmarks of the ModelView model loading: parsing an OBJ model and loading
+# it back from the model cache. Build it from the GCS build tree after the
+# GLC library, it runs headless as nothing is rendered. Use
+# "-xml -o results.xml" to get the results in a form that can be compared
+# between releases.
+TARGET = modelviewbenchmark
+CONFIG += qtestlib console
+CONFIG -= app_bundle
+TEMPLATE = app
+include(../../../../../openpilotgcs.pri)
+include(../../../../libs/glc_lib/glc_lib.pri)
+LIBS += -L$$GCS_LIBRARY_PATH
+INCLUDEPATH += ../.. ../../../../libs/glc_lib
+
+SOURCES += tst_modelviewbenchmark.cpp \
+    ../../modelcache.cpp
+HEADERS += ../../modelcache.h
@@ -0,0 +1,168 @@
+/**
+ ******************************************************************************
+ *
+ * @file       tst_modelviewbenchmark.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ModelViewPlugin ModelView Plugin
+ * @{
+ * @brief Benchmarks of the model loading of the ModelView gadget
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include <QtTest/QtTest>
+#include <QtGui/QApplication>
+#include <QtGui/QImage>
+#include "modelcache.h"
+#include "io/glc_fileloader.h"
+
+// Number of quads along each side of the generated model
+#define MODEL_GRID 200
+
+class tst_ModelViewBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void parseObj();
+    void loadCached();
+    void keyCoversAttachedFiles();
+
+private:
+    void writeTexture(int size);
+    static void removeDir(const QString& path);
+
+    QString workDir;
+    QString modelFile;
+};
+
+/**
+ * Generate a textured OBJ model: a grid of quads with a material library
+ * and a texture next to it.
+ */
+void tst_ModelViewBenchmark::initTestCase()
+{
+    workDir = QDir::temp().absoluteFilePath(QString("modelviewbenchmark-%1").arg(QCoreApplication::applicationPid()));
+    QVERIFY(QDir().mkpath(workDir));
+    modelFile = workDir + "/model.obj";
+
+    QFile mtl(workDir + "/model.mtl");
+    QVERIFY(mtl.open(QFile::WriteOnly | QFile::Text));
+    QTextStream(&mtl) << "newmtl skin\nKa 0.2 0.2 0.2\nKd 0.8 0.8 0.8\nmap_Kd texture.png\n";
+    mtl.close();
+    writeTexture(8);
+
+    QFile obj(modelFile);
+    QVERIFY(obj.open(QFile::WriteOnly | QFile::Text));
+    QTextStream out(&obj);
+    out << "mtllib model.mtl\n";
+    for (int y = 0; y <= MODEL_GRID; ++y) {
+        for (int x = 0; x <= MODEL_GRID; ++x) {
+            out << "v " << x << " " << y << " " << ((x * y) % 7) * 0.1 << "\n";
+            out << "vt " << double(x) / MODEL_GRID << " " << double(y) / MODEL_GRID << "\n";
+        }
+    }
+    out << "vn 0 0 1\nusemtl skin\n";
+    for (int y = 0; y < MODEL_GRID; ++y) {
+        for (int x = 0; x < MODEL_GRID; ++x) {
+            int v = y * (MODEL_GRID + 1) + x + 1;
+            int w = v + MODEL_GRID + 1;
+            out << "f " << v << "/" << v << "/1 " << v + 1 << "/" << v + 1 << "/1 "
+                << w + 1 << "/" << w + 1 << "/1 " << w << "/" << w << "/1\n";
+        }
+    }
+    QVERIFY(out.status() == QTextStream::Ok);
+}
+
+void tst_ModelViewBenchmark::cleanupTestCase()
+{
+    removeDir(workDir);
+}
+
+void tst_ModelViewBenchmark::parseObj()
+{
+    QBENCHMARK {
+        QFile file(modelFile);
+        GLC_FileLoader loader;
+        GLC_World world = loader.createWorldFromFile(file);
+        QVERIFY(!world.isEmpty());
+    }
+}
+
+void tst_ModelViewBenchmark::loadCached()
+{
+    ModelCache cache(workDir + "/cache/");
+    cache.loadWorld(modelFile);
+    QVERIFY(cache.isCurrent(modelFile));
+
+    QBENCHMARK {
+        GLC_World world = cache.loadWorld(modelFile);
+        QVERIFY(!world.isEmpty());
+    }
+}
+
+/**
+ * Changing a file the model references drops the entry, even though the
+ * model itself is unchanged.
+ */
+void tst_ModelViewBenchmark::keyCoversAttachedFiles()
+{
+    ModelCache cache(workDir + "/cache/");
+    cache.loadWorld(modelFile);
+    QVERIFY(cache.isCurrent(modelFile));
+
+    writeTexture(64);
+    QVERIFY(!cache.isCurrent(modelFile));
+    cache.loadWorld(modelFile);
+    QVERIFY(cache.isCurrent(modelFile));
+
+    QVERIFY(QFile::remove(workDir + "/model.mtl"));
+    QVERIFY(!cache.isCurrent(modelFile));
+}
+
+void tst_ModelViewBenchmark::writeTexture(int size)
+{
+    QImage texture(size, size, QImage::Format_RGB32);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x)
+            texture.setPixel(x, y, qRgb(x * 255 / size, y * 255 / size, 0));
+    }
+    QVERIFY(texture.save(workDir + "/texture.png"));
+}
+
+void tst_ModelViewBenchmark::removeDir(const QString& path)
+{
+    QDir dir(path);
+    foreach (QString entry, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+        removeDir(dir.absoluteFilePath(entry));
+    foreach (QString entry, dir.entryList(QDir::Files))
+        dir.remove(entry);
+    dir.rmdir(path);
+}
+
+int main(int argc, char *argv[])
+{
+    // Nothing is rendered, no display is needed
+    QApplication app(argc, argv, false);
+    tst_ModelViewBenchmark test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "tst_modelviewbenchmark.moc"
@@ -65,6 +65,7 @@ NotificationItem::NotificationItem(QObject *parent)
     , _sayOrder(never)
     , _singleValue(0)
     , _valueRange2(0)
+    , _hysteresis(0)
     , _repeatValue(repeatInstantly)
     , _expireTimeout(eDefaultTimeout)
     , _mute(false)
@@ -102,6 +103,7 @@ void NotificationItem::copyTo(NotificationItem* that) const
     that->_sayOrder = _sayOrder;
     that->_singleValue = _singleValue;
     that->_valueRange2 = _valueRange2;
+    that->_hysteresis = _hysteresis;
     that->_repeatValue = _repeatValue;
     that->_expireTimeout = _expireTimeout;
     that->_mute = _mute;
@@ -118,6 +120,7 @@ void NotificationItem::saveState(QSettings* settings) const
     settings->setValue(QLatin1String("RangeLimit"), getCondition());
     settings->setValue(QLatin1String("Value1"), singleValue());
     settings->setValue(QLatin1String("Value2"), valueRange2());
+    settings->setValue(QLatin1String("Hysteresis"), hysteresis());
     settings->setValue(QLatin1String("Sound1"), getSound1());
     settings->setValue(QLatin1String("Sound2"), getSound2());
     settings->setValue(QLatin1String("Sound3"), getSound3());
@@ -142,6 +145,7 @@ void NotificationItem::restoreState(QSettings* settings)
     QVariant value = settings->value(QLatin1String("Value1"), tr(""));
     setSingleValue(value);
     setValueRange2(settings->value(QLatin1String("Value2"), tr("")).toDouble());
+    setHysteresis(settings->value(QLatin1String("Hysteresis"), 0).toDouble());
     setRetryValue(settings->value(QLatin1String("Repeat"), tr("")).toInt());
     setLifetime(settings->value(QLatin1String("ExpireTimeout"), tr("")).toInt());
     setMute(settings->value(QLatin1String("Mute"), tr("")).toInt());
@@ -164,6 +168,7 @@ void NotificationItem::serialize(QDataStream& stream)
     stream << this->_repeatValue;
     stream << this->_expireTimeout;
     stream << this->_mute;
+    stream << this->_hysteresis;
 }
 
 void NotificationItem::deserialize(QDataStream& stream)
@@ -182,6 +187,7 @@ void NotificationItem::deserialize(QDataStream& stream)
     stream >> this->_repeatValue;
     stream >> this->_expireTimeout;
     stream >> this->_mute;
+    stream >> this->_hysteresis;
 }
 
 void NotificationItem::startTimer(int msec)
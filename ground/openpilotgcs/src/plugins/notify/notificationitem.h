@@ -76,6 +76,9 @@ public:
     double valueRange2() const { return _valueRange2; }
     void setValueRange2(double value) { _valueRange2 = value; }
 
+    double hysteresis() const { return _hysteresis; }
+    void setHysteresis(double value) { _hysteresis = value; }
+
     QString getDataObject() const { return _dataObject; }
     void setDataObject(QString text) { _dataObject = text; }
 
@@ -201,6 +204,10 @@ private:
     //double _valueRange1;
     double _valueRange2;
 
+    //! margin by which a numeric value has to leave the condition
+    //! before the notification is released and may fire again
+    double _hysteresis;
+
     //! how often or what periodicaly notification should be played
     int _repeatValue;
 
@@ -33,6 +33,7 @@
 #include <QDebug>
 #include <QtPlugin>
 #include <QStringList>
+#include <QtEndian>
 
 #include <extensionsystem/pluginmanager.h>
 
@@ -176,6 +177,7 @@ void SoundNotifyPlugin::connectNotifications()
         if (obj != NULL)
             disconnect(obj,SIGNAL(objectUpdated(UAVObject*)),this,SLOT(on_arrived_Notification(UAVObject*)));
     }
+    _notificationRules.clear();
     if (phonon.mo != NULL) {
         delete phonon.mo;
         phonon.mo = NULL;
@@ -203,6 +205,11 @@ void SoundNotifyPlugin::connectNotifications()
 
         UAVDataObject* obj = dynamic_cast<UAVDataObject*>( objManager->getObject(notify->getDataObject()) );
         if (obj != NULL ) {
+            NotificationRule rule;
+            if (!compileNotificationRule(notify, obj, &rule))
+                continue;
+            _notificationRules[obj].append(rule);
+
             if (!lstNotifiedUAVObjects.contains(obj)) {
                 lstNotifiedUAVObjects.append(obj);
 
@@ -231,26 +238,26 @@ void SoundNotifyPlugin::connectNotifications()
 
 void SoundNotifyPlugin::on_arrived_Notification(UAVObject *object)
 {
-    foreach(NotificationItem* ntf, _notificationList) {
-        if (object->getName() != ntf->getDataObject())
-            continue;
+    QHash<UAVObject*, QList<NotificationRule> >::iterator rules = _notificationRules.find(object);
+    if (rules == _notificationRules.end())
+        return;
+
+    // take one snapshot of the object and check all its rules against it
+    _objectData.resize(object->getNumBytes());
+    object->pack(reinterpret_cast<quint8*>(_objectData.data()));
+    const quint8* data = reinterpret_cast<const quint8*>(_objectData.constData());
 
+    for (int i = 0; i < rules->size(); ++i) {
+        NotificationRule& rule = (*rules)[i];
+        NotificationItem* ntf = rule.notify;
 
         // skip duplicate notifications
         if (_nowPlayingNotification == ntf)
             continue;
 
-        // skip periodical notifications
-        // this condition accepts:
-        // 1. Periodical notifications played firstly;
-        //    NOTE: At first time it will be played, then it played only by timer,
-        //          when conditions became false firstStart flag has been cleared and
-        //          notification can be accepted again;
-        // 2. Once time notifications, they removed immediately after first playing;
-        // 3. Instant notifications(played one by one without interval);
-        if (ntf->retryValue() != NotificationItem::repeatInstantly && ntf->retryValue() != NotificationItem::repeatOncePerUpdate &&
-                ntf->retryValue() != NotificationItem::repeatOnce && ntf->_isPlayed)
-           continue;
+        // skip notifications which were played once and removed
+        if (_toRemoveNotifications.contains(ntf))
+            continue;
 
         qNotifyDebug() << QString("new notification: | %1 | %2 | val1: %3 | val2: %4")
                                       .arg(ntf->getDataObject())
@@ -258,10 +265,8 @@ void SoundNotifyPlugin::on_arrived_Notification(UAVObject *object)
                                         .arg(ntf->singleValue().toString())
                                         .arg(ntf->valueRange2());
 
-        checkNotificationRule(ntf, object);
+        checkNotificationRule(rule, data, false);
     }
-    connect(object, SIGNAL(objectUpdated(UAVObject*)),
-            this, SLOT(on_arrived_Notification(UAVObject*)), Qt::UniqueConnection);
 }
 
 
@@ -283,11 +288,18 @@ void SoundNotifyPlugin::on_timerRepeated_Notification()
                                                     .arg(notification->getObjectField())
                                                     .arg(notification->toString());
 
-    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
-    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
-    UAVObject* object = objManager->getObject(notification->getDataObject());
-    if (object)
-        checkNotificationRule(notification,object);
+    QHash<UAVObject*, QList<NotificationRule> >::iterator rules;
+    for (rules = _notificationRules.begin(); rules != _notificationRules.end(); ++rules) {
+        for (int i = 0; i < rules->size(); ++i) {
+            NotificationRule& rule = (*rules)[i];
+            if (rule.notify != notification)
+                continue;
+            _objectData.resize(rule.object->getNumBytes());
+            rule.object->pack(reinterpret_cast<quint8*>(_objectData.data()));
+            checkNotificationRule(rule, reinterpret_cast<const quint8*>(_objectData.constData()), true);
+            return;
+        }
+    }
 }
 
 
@@ -349,96 +361,136 @@ void SoundNotifyPlugin::stateChanged(Phonon::State newstate, Phonon::State oldst
     }
 }
 
-bool checkRange(QString fieldValue, QString enumValue, QStringList /* values */, int direction)
+/*!
+    resolve notification against the field it watches;
+    returns false if the field can't be watched
+ */
+bool SoundNotifyPlugin::compileNotificationRule(NotificationItem* notification, UAVObject* object, NotificationRule* rule)
 {
+    UAVObjectField* field = object->getField(notification->getObjectField());
+    if (field == NULL || field->getType() == UAVObjectField::STRING) {
+        qNotifyDebug() << "Error: Field is unknown (" << notification->getObjectField() << ").";
+        return false;
+    }
 
-    bool ret = false;
-    switch(direction)
-    {
-    case NotifyPluginOptionsPage::equal:
-        ret = !QString::compare(enumValue, fieldValue, Qt::CaseInsensitive) ? true : false;
-        break;
+    rule->notify = notification;
+    rule->object = object;
+    rule->type = field->getType();
+    rule->offset = field->getDataOffset();
+    rule->condition = notification->getCondition();
+    rule->value1 = notification->singleValue().toDouble();
+    rule->value2 = notification->valueRange2();
+    rule->hysteresis = qAbs(notification->hysteresis());
+    rule->active = false;
+
+    if (rule->type == UAVObjectField::ENUM) {
+        QStringList options = field->getOptions();
+        rule->value1 = -1;
+        for (int n = 0; n < options.size(); ++n) {
+            if (!QString::compare(options.at(n), notification->singleValue().toString(), Qt::CaseInsensitive)) {
+                rule->value1 = n;
+                break;
+            }
+        }
+        rule->hysteresis = 0;
+    }
+    return true;
+}
 
+/*!
+    read first element of a field from packed (little endian) object data
+ */
+static double fieldValue(UAVObjectField::FieldType type, const quint8* data)
+{
+    switch(type)
+    {
+    case UAVObjectField::INT8:
+        return static_cast<qint8>(data[0]);
+    case UAVObjectField::INT16:
+        return qFromLittleEndian<qint16>(data);
+    case UAVObjectField::INT32:
+        return qFromLittleEndian<qint32>(data);
+    case UAVObjectField::UINT16:
+        return qFromLittleEndian<quint16>(data);
+    case UAVObjectField::UINT32:
+        return qFromLittleEndian<quint32>(data);
+    case UAVObjectField::FLOAT32:
+    {
+        quint32 raw = qFromLittleEndian<quint32>(data);
+        float value;
+        memcpy(&value, &raw, sizeof(value));
+        return value;
+    }
     default:
-        ret = true;
-        break;
+        return data[0];
     };
-    return ret;
 }
 
-bool checkRange(double fieldValue, double min, double max, int direction)
+/*!
+    update rule state from object data;
+    once the rule is active it is released only when the value leaves
+    the condition by more than the configured hysteresis
+ */
+bool SoundNotifyPlugin::evaluateNotificationRule(NotificationRule& rule, const quint8* data)
 {
-    bool ret = false;
-    //Q_ASSERT(min < max);
-    switch(direction)
+    double value = fieldValue(rule.type, &data[rule.offset]);
+    double hysteresis = rule.active ? rule.hysteresis : 0;
+
+    if (rule.type == UAVObjectField::ENUM) {
+        rule.active = (rule.condition != NotifyPluginOptionsPage::equal) || (value == rule.value1);
+        return rule.active;
+    }
+
+    switch(rule.condition)
     {
     case NotifyPluginOptionsPage::equal:
-        ret = (fieldValue == min);
+        rule.active = (qAbs(value - rule.value1) <= hysteresis);
         break;
 
     case NotifyPluginOptionsPage::bigger:
-        ret = (fieldValue > min);
+        rule.active = (value > rule.value1 - hysteresis);
         break;
 
     case NotifyPluginOptionsPage::smaller:
-        ret = (fieldValue < min);
+        rule.active = (value < rule.value1 + hysteresis);
         break;
 
     default:
-        ret = (fieldValue > min) && (fieldValue < max);
+        rule.active = (value > rule.value1 - hysteresis) && (value < rule.value2 + hysteresis);
         break;
     };
-
-    return ret;
+    return rule.active;
 }
 
-void SoundNotifyPlugin::checkNotificationRule(NotificationItem* notification, UAVObject* object)
+/*!
+    notifications fire on the rising edge of their rule; while the rule
+    stays active only repeat timers (repeat == true), "Repeat Instantly"
+    and a not yet played "Repeat Once per update" fire again
+ */
+void SoundNotifyPlugin::checkNotificationRule(NotificationRule& rule, const quint8* data, bool repeat)
 {
-    if(notification->getDataObject()!=object->getName() || object->getField(notification->getObjectField())==NULL)
-        return;
-    bool condition=false;
-
+    NotificationItem* notification = rule.notify;
     if (notification->mute())
         return;
 
-    int direction = notification->getCondition();
-    QString fieldName = notification->getObjectField();
-    UAVObjectField* field = object->getField(fieldName);
+    bool wasActive = rule.active;
+    notification->_isPlayed = evaluateNotificationRule(rule, data);
+    qNotifyDebug() << "Check rule" << notification->getDataObject() << notification->getObjectField()
+                   << wasActive << "->" << rule.active;
 
-    if (field->getName().isEmpty())
-        return;
-
-    QVariant value = field->getValue();
-    if(UAVObjectField::ENUM == field->getType()) {
-        qNotifyDebug()<<"Check range ENUM"<<value.toString()<<"|"<<notification->singleValue().toString()<<"|"<<field->getOptions()<<"|"<<
-                  direction<<checkRange(value.toString(),
-                                        notification->singleValue().toString(),
-                                        field->getOptions(),
-                                        direction);;
-        condition = checkRange(value.toString(),
-                               notification->singleValue().toString(),
-                               field->getOptions(),
-                               direction);
-    } else {
-        qNotifyDebug()<<"Check range VAL"<<value.toString()<<"|"<<notification->singleValue().toString()<<"|"<<field->getOptions()<<"|"<<
-                  direction<<checkRange(value.toDouble(),
-                                        notification->singleValue().toDouble(),
-                                        notification->valueRange2(),
-                                        direction);
-        condition = checkRange(value.toDouble(),
-                               notification->singleValue().toDouble(),
-                               notification->valueRange2(),
-                               direction);
-    }
-
-    notification->_isPlayed = condition;
     // if condition has been changed, and already in false state
     // we should reset _isPlayed flag and stop repeat timer
     if (!notification->_isPlayed) {
-        notification->stopTimer();
-        notification->setCurrentUpdatePlayed(false);
+        if (wasActive) {
+            notification->stopTimer();
+            notification->setCurrentUpdatePlayed(false);
+        }
         return;
     }
+    if (wasActive && !repeat
+            && notification->retryValue() != NotificationItem::repeatInstantly
+            && notification->retryValue() != NotificationItem::repeatOncePerUpdate)
+        return;
     if(notification->retryValue() == NotificationItem::repeatOncePerUpdate && notification->getCurrentUpdatePlayed())
         return;
 
@@ -32,6 +32,7 @@
 #include "uavtalk/telemetrymanager.h"
 #include "uavobjectmanager.h"
 #include "uavobject.h"
+#include "uavobjectfield.h"
 #include "notificationitem.h"
 
 #include <QSettings>
@@ -48,6 +49,21 @@ typedef struct {
 	bool firstPlay;
 } PhononObject, *pPhononObject;
 
+//! Notification rule resolved against the field it watches when the
+//! notifications are connected, so that an object update is checked
+//! straight from the packed object data, without any name lookups.
+typedef struct {
+	NotificationItem* notify;
+	UAVObject* object;
+	UAVObjectField::FieldType type;
+	quint32 offset;
+	int condition;
+	double value1;     // enum rules hold the option index here
+	double value2;
+	double hysteresis;
+	bool active;
+} NotificationRule;
+
 
 class SoundNotifyPlugin : public Core::IConfigurablePlugin
 {
@@ -73,7 +89,9 @@ private:
     Q_DISABLE_COPY(SoundNotifyPlugin)
 
     bool playNotification(NotificationItem* notification);
-    void checkNotificationRule(NotificationItem* notification, UAVObject* object);
+    bool compileNotificationRule(NotificationItem* notification, UAVObject* object, NotificationRule* rule);
+    bool evaluateNotificationRule(NotificationRule& rule, const quint8* data);
+    void checkNotificationRule(NotificationRule& rule, const quint8* data, bool repeat);
 
 private slots:
 
@@ -91,6 +109,8 @@ private:
     bool enableSound;
 
     QList<UAVDataObject*> lstNotifiedUAVObjects;
+    QHash<UAVObject*, QList<NotificationRule> > _notificationRules;
+    QByteArray _objectData;
     QList<NotificationItem*> _notificationList;
     QList<NotificationItem*> _pendingNotifications;
     QList<NotificationItem*> _toRemoveNotifications;
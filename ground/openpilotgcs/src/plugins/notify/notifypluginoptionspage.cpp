@@ -57,6 +57,7 @@ NotifyPluginOptionsPage::NotifyPluginOptionsPage(QObject *parent)
     , _dynamicFieldWidget(NULL)
     , _dynamicFieldType(-1)
     , _sayOrder(NULL)
+    , _hysteresis(NULL)
     , _form(NULL)
     , _selectedNotification(NULL)
 {
@@ -228,6 +229,14 @@ void NotifyPluginOptionsPage::addDynamicFieldLayout()
 
     _dynamicFieldCondition = new QComboBox(_form);
     _optionsPage->dynamicValueLayout->addWidget(_dynamicFieldCondition);
+
+    QLabel* labelHysteresis = new QLabel("Hysteresis ", _form);
+    labelHysteresis->setSizePolicy(labelSizePolicy);
+    _optionsPage->dynamicValueLayout->addWidget(labelHysteresis);
+    _hysteresis = new QDoubleSpinBox(_form);
+    _hysteresis->setRange(0, 999.99);
+    _optionsPage->dynamicValueLayout->addWidget(_hysteresis);
+
     UAVObjectField* field = getObjectFieldFromSelected();
     addDynamicField(field);
 }
@@ -313,7 +322,10 @@ void NotifyPluginOptionsPage::addDynamicFieldWidget(UAVObjectField* objField)
     enum { eDynamicFieldWidth = 100 };
     _dynamicFieldWidget->setSizePolicy(sizePolicy);
     _dynamicFieldWidget->setFixedWidth(eDynamicFieldWidth);
-    _optionsPage->dynamicValueLayout->addWidget(_dynamicFieldWidget);
+    // value goes right after the condition, in front of hysteresis
+    _optionsPage->dynamicValueLayout->insertWidget(
+                _optionsPage->dynamicValueLayout->indexOf(_dynamicFieldCondition) + 1, _dynamicFieldWidget);
+    _hysteresis->setEnabled(_dynamicFieldType != UAVObjectField::ENUM);
 }
 
 void NotifyPluginOptionsPage::setDynamicFieldValue(NotificationItem* notification)
@@ -354,6 +366,7 @@ void NotifyPluginOptionsPage::getOptionsPageValues(NotificationItem* notificatio
     notification->setSound3(_optionsPage->Sound3->currentText());
     notification->setSayOrder(_sayOrder->currentIndex());
     notification->setCondition(NotifyPluginOptionsPage::conditionValues.indexOf(_dynamicFieldCondition->currentText()));
+    notification->setHysteresis(_hysteresis->value());
     if (QDoubleSpinBox* spinValue = dynamic_cast<QDoubleSpinBox*>(_dynamicFieldWidget))
         notification->setSingleValue(spinValue->value());
     else {
@@ -443,6 +456,7 @@ void NotifyPluginOptionsPage::updateConfigView(NotificationItem* notification)
     _dynamicFieldCondition->setCurrentIndex(_dynamicFieldCondition->findText(NotifyPluginOptionsPage::conditionValues.at(cond)));
 
     _sayOrder->setCurrentIndex(notification->getSayOrder());
+    _hysteresis->setValue(notification->hysteresis());
 
     setDynamicFieldValue(notification);
 
@@ -169,6 +169,10 @@ private:
     //! between sounds[1..3]
     QComboBox* _sayOrder;
 
+    //! Margin by which a numeric value has to leave the condition
+    //! before notification may fire again
+    QDoubleSpinBox* _hysteresis;
+
     //! Actualy reference to optionsPageWidget,
     //! we MUST hold it beyond the scope of createPage func
     //! to have possibility change dynamic parts of options page layout in future
@@ -354,6 +354,32 @@ Qt::ItemFlags flightDataModel::flags(const QModelIndex & /*index*/) const
     return Qt::ItemIsSelectable |  Qt::ItemIsEditable | Qt::ItemIsEnabled ;
 }
 
+void flightDataModel::initPathPlanData(pathPlanData *data)
+{
+    data->latPosition=0;
+    data->lngPosition=0;
+    data->disRelative=0;
+    data->beaRelative=0;
+    data->altitudeRelative=0;
+    data->isRelative=0;
+    data->altitude=0;
+    data->velocity=0;
+    data->mode=0;
+    data->mode_params[0]=0;
+    data->mode_params[1]=0;
+    data->mode_params[2]=0;
+    data->mode_params[3]=0;
+    data->condition=0;
+    data->condition_params[0]=0;
+    data->condition_params[1]=0;
+    data->condition_params[2]=0;
+    data->condition_params[3]=0;
+    data->command=0;
+    data->jumpdestination=0;
+    data->errordestination=0;
+    data->locked=false;
+}
+
 bool flightDataModel::insertRows(int row, int count, const QModelIndex &/*parent*/)
 {
     pathPlanData * data;
@@ -361,31 +387,27 @@ bool flightDataModel::insertRows(int row, int count, const QModelIndex &/*parent
     for(int x=0; x<count;++x)
     {
         data=new pathPlanData;
-        data->latPosition=0;
-        data->lngPosition=0;
-        data->disRelative=0;
-        data->beaRelative=0;
-        data->altitudeRelative=0;
-        data->isRelative=0;
-        data->altitude=0;
-        data->velocity=0;
-        data->mode=0;
-        data->mode_params[0]=0;
-        data->mode_params[1]=0;
-        data->mode_params[2]=0;
-        data->mode_params[3]=0;
-        data->condition=0;
-        data->condition_params[0]=0;
-        data->condition_params[1]=0;
-        data->condition_params[2]=0;
-        data->condition_params[3]=0;
-        data->command=0;
-        data->jumpdestination=0;
-        data->errordestination=0;
-        data->locked=false;
+        initPathPlanData(data);
         dataStorage.insert(row,data);
     }
     endInsertRows();
+    return true;
+}
+
+/**
+ * Insert complete rows with a single rowsInserted() notification, used for
+ * generated plans that would otherwise take one insert and a dataChanged()
+ * per cell
+ */
+bool flightDataModel::insertPathPlan(int row, const QList<pathPlanData> &plan)
+{
+    if(plan.isEmpty() || row<0 || row>dataStorage.length())
+        return false;
+    beginInsertRows(QModelIndex(),row,row+plan.length()-1);
+    for(int x=0; x<plan.length();++x)
+        dataStorage.insert(row+x,new pathPlanData(plan.at(x)));
+    endInsertRows();
+    return true;
 }
 
 bool flightDataModel::removeRows(int row, int count, const QModelIndex &/*parent*/)
@@ -71,6 +71,8 @@ public:
     Qt::ItemFlags flags(const QModelIndex & index) const ;
     bool insertRows ( int row, int count, const QModelIndex & parent = QModelIndex() );
     bool removeRows ( int row, int count, const QModelIndex & parent = QModelIndex() );
+    bool insertPathPlan(int row, const QList<pathPlanData> &plan);
+    static void initPathPlanData(pathPlanData *data);
     bool writeToFile(QString filename);
     void readFromFile(QString fileName);
 private:
@@ -148,6 +148,8 @@ void modelMapProxy::refreshOverlays()
     myMap->deleteAllOverlays();
     if(model->rowCount()<1)
         return;
+    // Look the waypoints up once instead of searching the map for each row
+    QMap<int,WayPointItem*> waypoints=myMap->WPAll();
     WayPointItem * wp_current=NULL;
     WayPointItem * wp_next=NULL;
     int wp_jump;
@@ -155,40 +157,40 @@ void modelMapProxy::refreshOverlays()
     overlayType wp_next_overlay;
     overlayType wp_jump_overlay;
     overlayType wp_error_overlay;
-    wp_current=findWayPointNumber(0);
+    wp_current=waypoints.value(0);
     overlayType wp_current_overlay=overlayTranslate(model->data(model->index(0,flightDataModel::MODE)).toInt());
     createOverlay(wp_current,myMap->Home,wp_current_overlay,Qt::green);
     for(int x=0;x<model->rowCount();++x)
     {
-        wp_current=findWayPointNumber(x);
+        wp_current=waypoints.value(x);
         wp_jump=model->data(model->index(x,flightDataModel::JUMPDESTINATION)).toInt()-1;
         wp_error=model->data(model->index(x,flightDataModel::ERRORDESTINATION)).toInt()-1;
         wp_next_overlay=overlayTranslate(model->data(model->index(x+1,flightDataModel::MODE)).toInt());
         wp_jump_overlay=overlayTranslate(model->data(model->index(wp_jump,flightDataModel::MODE)).toInt());
         wp_error_overlay=overlayTranslate(model->data(model->index(wp_error,flightDataModel::MODE)).toInt());
-        createOverlay(wp_current,findWayPointNumber(wp_error),wp_error_overlay,Qt::red);
+        createOverlay(wp_current,waypoints.value(wp_error),wp_error_overlay,Qt::red);
         switch(model->data(model->index(x,flightDataModel::COMMAND)).toInt())
         {
         case MapDataDelegate::COMMAND_ONCONDITIONNEXTWAYPOINT:
-            wp_next=findWayPointNumber(x+1);
+            wp_next=waypoints.value(x+1);
             createOverlay(wp_current,wp_next,wp_next_overlay,Qt::green);
             break;
         case MapDataDelegate::COMMAND_ONCONDITIONJUMPWAYPOINT:
-            wp_next=findWayPointNumber(wp_jump);
+            wp_next=waypoints.value(wp_jump);
             createOverlay(wp_current,wp_next,wp_jump_overlay,Qt::green);
             break;
         case MapDataDelegate::COMMAND_ONNOTCONDITIONJUMPWAYPOINT:
-            wp_next=findWayPointNumber(wp_jump);
+            wp_next=waypoints.value(wp_jump);
             createOverlay(wp_current,wp_next,wp_jump_overlay,Qt::yellow);
             break;
         case MapDataDelegate::COMMAND_ONNOTCONDITIONNEXTWAYPOINT:
-            wp_next=findWayPointNumber(x+1);
+            wp_next=waypoints.value(x+1);
             createOverlay(wp_current,wp_next,wp_next_overlay,Qt::yellow);
             break;
         case MapDataDelegate::COMMAND_IFCONDITIONJUMPWAYPOINTELSENEXTWAYPOINT:
-            wp_next=findWayPointNumber(wp_jump);
+            wp_next=waypoints.value(wp_jump);
             createOverlay(wp_current,wp_next,wp_jump_overlay,Qt::green);
-            wp_next=findWayPointNumber(x+1);
+            wp_next=waypoints.value(x+1);
             createOverlay(wp_current,wp_next,wp_next_overlay,Qt::green);
             break;
         }
@@ -294,6 +296,7 @@ void modelMapProxy::dataChanged(const QModelIndex &topLeft, const QModelIndex &b
 void modelMapProxy::rowsInserted(const QModelIndex &parent, int first, int last)
 {
     Q_UNUSED(parent);
+    myMap->WPBeginInsert();
     for(int x=first;x<last+1;x++)
     {
         QModelIndex index;
@@ -323,6 +326,7 @@ void modelMapProxy::rowsInserted(const QModelIndex &parent, int first, int last)
         else
             item=myMap->WPInsert(latlng,altitude,desc,x);
     }
+    myMap->WPEndInsert();
     refreshOverlays();
 }
 void modelMapProxy::deleteWayPoint(int number)
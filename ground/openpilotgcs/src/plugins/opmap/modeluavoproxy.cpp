@@ -27,7 +27,15 @@
 #include "modeluavoproxy.h"
 #include "extensionsystem/pluginmanager.h"
 #include <math.h>
-modelUavoProxy::modelUavoProxy(QObject *parent,flightDataModel * model):QObject(parent),myModel(model)
+#include <string.h>
+#include <QHash>
+
+// Objects handed to the telemetry per batch and the time between batches,
+// the telemetry event queue only holds 20 events
+#define UPLOAD_BATCH_SIZE 10
+#define UPLOAD_BATCH_INTERVAL_MS 20
+
+modelUavoProxy::modelUavoProxy(QObject *parent,flightDataModel * model):QObject(parent),myModel(model),uploadSent(0),uploadTotal(0)
 {
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     Q_ASSERT(pm != NULL);
@@ -37,121 +45,254 @@ modelUavoProxy::modelUavoProxy(QObject *parent,flightDataModel * model):QObject(
     Q_ASSERT(waypointObj != NULL);
     pathactionObj=PathAction::GetInstance(objManager);
     Q_ASSERT(pathactionObj != NULL);
+
+    rowsInserted(QModelIndex(),0,myModel->rowCount()-1);
+    connect(myModel,SIGNAL(dataChanged(QModelIndex,QModelIndex)),this,SLOT(rowsChanged(QModelIndex,QModelIndex)));
+    connect(myModel,SIGNAL(rowsInserted(QModelIndex,int,int)),this,SLOT(rowsInserted(QModelIndex,int,int)));
+    connect(myModel,SIGNAL(rowsRemoved(QModelIndex,int,int)),this,SLOT(rowsRemoved(QModelIndex,int,int)));
+
+    uploadTimer.setInterval(UPLOAD_BATCH_INTERVAL_MS);
+    connect(&uploadTimer,SIGNAL(timeout()),this,SLOT(uploadBatch()));
 }
-void modelUavoProxy::modelToObjects()
+
+void modelUavoProxy::rowsChanged(const QModelIndex &topLeft,const QModelIndex &bottomRight)
+{
+    for(int x=topLeft.row();x<=bottomRight.row() && x<rows.length();++x)
+        rows[x].dirty=true;
+}
+
+void modelUavoProxy::rowsInserted(const QModelIndex &parent,int start,int end)
+{
+    Q_UNUSED(parent);
+    RowData data;
+    memset(&data,0,sizeof(data));
+    data.dirty=true;
+    for(int x=start;x<=end;++x)
+        rows.insert(x,data);
+}
+
+void modelUavoProxy::rowsRemoved(const QModelIndex &parent,int start,int end)
+{
+    Q_UNUSED(parent);
+    for(int x=start;x<=end && start<rows.length();++x)
+        rows.removeAt(start);
+}
+
+/**
+ * Read the waypoint and action data of a row from the model, the action
+ * number of the waypoint is assigned later
+ */
+void modelUavoProxy::readRow(int x,RowData &data)
 {
-    PathAction * act=NULL;
-    Waypoint * wp=NULL;
     QModelIndex index;
     double distance;
     double bearing;
     double altitude;
-    int lastaction=-1;
-    for(int x=0;x<myModel->rowCount();++x)
+
+    ///Waypoint object data
+    index=myModel->index(x,flightDataModel::DISRELATIVE);
+    distance=myModel->data(index).toDouble();
+    index=myModel->index(x,flightDataModel::BEARELATIVE);
+    bearing=myModel->data(index).toDouble();
+    index=myModel->index(x,flightDataModel::ALTITUDERELATIVE);
+    altitude=myModel->data(index).toFloat();
+    index=myModel->index(x,flightDataModel::VELOCITY);
+    data.waypoint.Velocity=myModel->data(index).toFloat();
+
+    data.waypoint.Position[Waypoint::POSITION_NORTH]=distance*cos(bearing/180*M_PI);
+    data.waypoint.Position[Waypoint::POSITION_EAST]=distance*sin(bearing/180*M_PI);
+    data.waypoint.Position[Waypoint::POSITION_DOWN]=(-1.0f)*altitude;
+
+    ///PathAction object data
+    index=myModel->index(x,flightDataModel::MODE);
+    data.action.Mode=myModel->data(index).toInt();
+    index=myModel->index(x,flightDataModel::MODE_PARAMS0);
+    data.action.ModeParameters[0]=myModel->data(index).toFloat();
+    index=myModel->index(x,flightDataModel::MODE_PARAMS1);
+    data.action.ModeParameters[1]=myModel->data(index).toFloat();
+    index=myModel->index(x,flightDataModel::MODE_PARAMS2);
+    data.action.ModeParameters[2]=myModel->data(index).toFloat();
+    index=myModel->index(x,flightDataModel::MODE_PARAMS3);
+    data.action.ModeParameters[3]=myModel->data(index).toFloat();
+
+    index=myModel->index(x,flightDataModel::CONDITION);
+    data.action.EndCondition=myModel->data(index).toInt();
+    index=myModel->index(x,flightDataModel::CONDITION_PARAMS0);
+    data.action.ConditionParameters[0]=myModel->data(index).toFloat();
+    index=myModel->index(x,flightDataModel::CONDITION_PARAMS1);
+    data.action.ConditionParameters[1]=myModel->data(index).toFloat();
+    index=myModel->index(x,flightDataModel::CONDITION_PARAMS2);
+    data.action.ConditionParameters[2]=myModel->data(index).toFloat();
+    index=myModel->index(x,flightDataModel::CONDITION_PARAMS3);
+    data.action.ConditionParameters[3]=myModel->data(index).toFloat();
+
+    index=myModel->index(x,flightDataModel::COMMAND);
+    data.action.Command=myModel->data(index).toInt();
+    index=myModel->index(x,flightDataModel::JUMPDESTINATION);
+    data.action.JumpDestination=myModel->data(index).toInt()-1;
+    index=myModel->index(x,flightDataModel::ERRORDESTINATION);
+    data.action.ErrorDestination=myModel->data(index).toInt()-1;
+}
+
+Waypoint *modelUavoProxy::getWaypoint(int instance)
+{
+    if(instance<objManager->getNumInstances(waypointObj->getObjID()))
+        return Waypoint::GetInstance(objManager,instance);
+    Waypoint *wp=new Waypoint;
+    wp->initialize(instance,wp->getMetaObject());
+    objManager->registerObject(wp);
+    return wp;
+}
+
+PathAction *modelUavoProxy::getAction(int instance)
+{
+    if(instance<objManager->getNumInstances(pathactionObj->getObjID()))
+        return PathAction::GetInstance(objManager,instance);
+    PathAction *act=new PathAction;
+    act->initialize(instance,act->getMetaObject());
+    objManager->registerObject(act);
+    qDebug()<<"ModelUAVProxy:"<<"created new action instance:"<<instance;
+    return act;
+}
+
+void modelUavoProxy::modelToObjects()
+{
+    // Only the rows edited since the last sync are read from the model
+    for(int x=0;x<rows.length();++x)
     {
-        int instances=objManager->getNumInstances(waypointObj->getObjID());
-        if(x>instances-1)
+        if(rows[x].dirty)
         {
-            wp=new Waypoint;
-            wp->initialize(x,wp->getMetaObject());
-            objManager->registerObject(wp);
+            readRow(x,rows[x]);
+            rows[x].dirty=false;
         }
-        else
+    }
+
+    // Identical actions share one instance
+    QHash<QByteArray,int> actionNumbers;
+    QList<PathAction::DataFields> actions;
+    for(int x=0;x<rows.length();++x)
+    {
+        QByteArray key((const char *)&rows[x].action,sizeof(PathAction::DataFields));
+        int actionNumber=actionNumbers.value(key,-1);
+        if(actionNumber<0)
         {
-            wp=Waypoint::GetInstance(objManager,x);
+            actionNumber=actions.length();
+            actionNumbers.insert(key,actionNumber);
+            actions.append(rows[x].action);
         }
-        act=new PathAction;
+        rows[x].waypoint.Action=actionNumber;
+    }
+
+    // Queue the instances that differ, the actions go first as the
+    // waypoints refer to them
+    for(int x=0;x<actions.length();++x)
+    {
+        PathAction *act=getAction(x);
         Q_ASSERT(act);
+        PathAction::DataFields current=act->getData();
+        if(memcmp(&current,&actions[x],sizeof(current))!=0 || unsent.contains(act))
+        {
+            act->setData(actions[x]);
+            queueUpload(act);
+        }
+    }
+    for(int x=0;x<rows.length();++x)
+    {
+        Waypoint *wp=getWaypoint(x);
         Q_ASSERT(wp);
-        Waypoint::DataFields waypoint = wp->getData();
-        PathAction::DataFields action = act->getData();
-
-        ///Waypoint object data
-        index=myModel->index(x,flightDataModel::DISRELATIVE);
-        distance=myModel->data(index).toDouble();
-        index=myModel->index(x,flightDataModel::BEARELATIVE);
-        bearing=myModel->data(index).toDouble();
-        index=myModel->index(x,flightDataModel::ALTITUDERELATIVE);
-        altitude=myModel->data(index).toFloat();
-        index=myModel->index(x,flightDataModel::VELOCITY);
-        waypoint.Velocity=myModel->data(index).toFloat();
-
-        waypoint.Position[Waypoint::POSITION_NORTH]=distance*cos(bearing/180*M_PI);
-        waypoint.Position[Waypoint::POSITION_EAST]=distance*sin(bearing/180*M_PI);
-        waypoint.Position[Waypoint::POSITION_DOWN]=(-1.0f)*altitude;
-
-        ///PathAction object data
-        index=myModel->index(x,flightDataModel::MODE);
-        action.Mode=myModel->data(index).toInt();
-        index=myModel->index(x,flightDataModel::MODE_PARAMS0);
-        action.ModeParameters[0]=myModel->data(index).toFloat();
-        index=myModel->index(x,flightDataModel::MODE_PARAMS1);
-        action.ModeParameters[1]=myModel->data(index).toFloat();
-        index=myModel->index(x,flightDataModel::MODE_PARAMS2);
-        action.ModeParameters[2]=myModel->data(index).toFloat();
-        index=myModel->index(x,flightDataModel::MODE_PARAMS3);
-        action.ModeParameters[3]=myModel->data(index).toFloat();
-
-        index=myModel->index(x,flightDataModel::CONDITION);
-        action.EndCondition=myModel->data(index).toInt();
-        index=myModel->index(x,flightDataModel::CONDITION_PARAMS0);
-        action.ConditionParameters[0]=myModel->data(index).toFloat();
-        index=myModel->index(x,flightDataModel::CONDITION_PARAMS1);
-        action.ConditionParameters[1]=myModel->data(index).toFloat();
-        index=myModel->index(x,flightDataModel::CONDITION_PARAMS2);
-        action.ConditionParameters[2]=myModel->data(index).toFloat();
-        index=myModel->index(x,flightDataModel::CONDITION_PARAMS3);
-        action.ConditionParameters[3]=myModel->data(index).toFloat();
-
-        index=myModel->index(x,flightDataModel::COMMAND);
-        action.Command=myModel->data(index).toInt();
-        index=myModel->index(x,flightDataModel::JUMPDESTINATION);
-        action.JumpDestination=myModel->data(index).toInt()-1;
-        index=myModel->index(x,flightDataModel::ERRORDESTINATION);
-        action.ErrorDestination=myModel->data(index).toInt()-1;
-
-        int actionNumber=addAction(act,action,lastaction);
-        if(actionNumber>lastaction)
-            lastaction=actionNumber;
-        waypoint.Action=actionNumber;
-        wp->setData(waypoint);
-        wp->updated();
+        Waypoint::DataFields current=wp->getData();
+        if(memcmp(&current,&rows[x].waypoint,sizeof(current))!=0 || unsent.contains(wp))
+        {
+            wp->setData(rows[x].waypoint);
+            queueUpload(wp);
+        }
+    }
+
+    if(uploadQueue.isEmpty())
+        emit uploadProgress(uploadSent,uploadTotal);
+    else if(!uploadTimer.isActive())
+        uploadTimer.start();
+}
+
+void modelUavoProxy::queueUpload(UAVObject *obj)
+{
+    if(uploadQueue.contains(obj))
+        return;
+    uploadQueue.append(obj);
+    ++uploadTotal;
+}
+
+void modelUavoProxy::uploadBatch()
+{
+    for(int x=0;x<UPLOAD_BATCH_SIZE && !uploadQueue.isEmpty();++x)
+    {
+        UAVObject *obj=uploadQueue.takeFirst();
+        unsent.remove(obj);
+        connect(obj,SIGNAL(transactionCompleted(UAVObject*,bool)),this,SLOT(uploadCompleted(UAVObject*,bool)),Qt::UniqueConnection);
+        obj->updated();
+        ++uploadSent;
+    }
+    emit uploadProgress(uploadSent,uploadTotal);
+    if(uploadQueue.isEmpty())
+    {
+        uploadTimer.stop();
+        uploadSent=0;
+        uploadTotal=0;
     }
 }
 
+/**
+ * Updates the telemetry could not send are repeated on the next sync
+ * even if the data is unchanged
+ */
+void modelUavoProxy::uploadCompleted(UAVObject *obj,bool success)
+{
+    if(!success)
+    {
+        qDebug()<<"ModelUAVProxy:"<<"failed to send"<<obj->getName()<<obj->getInstID();
+        unsent.insert(obj);
+    }
+}
+
+void modelUavoProxy::setModelData(int row,int column,const QVariant &value)
+{
+    QModelIndex index=myModel->index(row,column);
+    if(myModel->data(index)!=value)
+        myModel->setData(index,value);
+}
+
 void modelUavoProxy::objectsToModel()
 {
     Waypoint * wp;
     Waypoint::DataFields wpfields;
     PathAction * action;
-    QModelIndex index;
     double distance;
     double bearing;
 
     PathAction::DataFields actionfields;
 
-    myModel->removeRows(0,myModel->rowCount());
-    for(int x=0;x<objManager->getNumInstances(waypointObj->getObjID());++x)
+    // Existing rows are reused, only the cells that differ are written
+    int instances=objManager->getNumInstances(waypointObj->getObjID());
+    if(myModel->rowCount()>instances)
+        myModel->removeRows(instances,myModel->rowCount()-instances);
+    else if(myModel->rowCount()<instances)
+        myModel->insertRows(myModel->rowCount(),instances-myModel->rowCount());
+    for(int x=0;x<instances;++x)
     {
         wp=Waypoint::GetInstance(objManager,x);
         Q_ASSERT(wp);
         if(!wp)
             continue;
         wpfields=wp->getData();
-        myModel->insertRow(x);
-        index=myModel->index(x,flightDataModel::VELOCITY);
-        myModel->setData(index,wpfields.Velocity);
+        setModelData(x,flightDataModel::VELOCITY,wpfields.Velocity);
         distance=sqrt(wpfields.Position[Waypoint::POSITION_NORTH]*wpfields.Position[Waypoint::POSITION_NORTH]+
                       wpfields.Position[Waypoint::POSITION_EAST]*wpfields.Position[Waypoint::POSITION_EAST]);
-        bearing=acos(wpfields.Position[Waypoint::POSITION_NORTH]/wpfields.Position[Waypoint::POSITION_EAST])*180/M_PI;
+        bearing=atan2(wpfields.Position[Waypoint::POSITION_EAST],wpfields.Position[Waypoint::POSITION_NORTH])*180/M_PI;
         if(bearing!=bearing)
             bearing=0;
-        index=myModel->index(x,flightDataModel::DISRELATIVE);
-        myModel->setData(index,distance);
-        index=myModel->index(x,flightDataModel::BEARELATIVE);
-        myModel->setData(index,bearing);
-        index=myModel->index(x,flightDataModel::ALTITUDERELATIVE);
-        myModel->setData(index,(-1.0f)*wpfields.Position[Waypoint::POSITION_DOWN]);
+        setModelData(x,flightDataModel::DISRELATIVE,distance);
+        setModelData(x,flightDataModel::BEARELATIVE,bearing);
+        setModelData(x,flightDataModel::ALTITUDERELATIVE,(-1.0f)*wpfields.Position[Waypoint::POSITION_DOWN]);
 
         action=PathAction::GetInstance(objManager,wpfields.Action);
         Q_ASSERT(action);
@@ -159,90 +300,32 @@ void modelUavoProxy::objectsToModel()
             continue;
         actionfields=action->getData();
 
-        index=myModel->index(x,flightDataModel::ISRELATIVE);
-        myModel->setData(index,true);
-
-        index=myModel->index(x,flightDataModel::COMMAND);
-        myModel->setData(index,actionfields.Command);
-
-        index=myModel->index(x,flightDataModel::CONDITION_PARAMS0);
-        myModel->setData(index,actionfields.ConditionParameters[0]);
-        index=myModel->index(x,flightDataModel::CONDITION_PARAMS1);
-        myModel->setData(index,actionfields.ConditionParameters[1]);
-        index=myModel->index(x,flightDataModel::CONDITION_PARAMS2);
-        myModel->setData(index,actionfields.ConditionParameters[2]);
-        index=myModel->index(x,flightDataModel::CONDITION_PARAMS3);
-        myModel->setData(index,actionfields.ConditionParameters[3]);
-
-        index=myModel->index(x,flightDataModel::CONDITION);
-        myModel->setData(index,actionfields.EndCondition);
-
-        index=myModel->index(x,flightDataModel::ERRORDESTINATION);
-        myModel->setData(index,actionfields.ErrorDestination+1);
-
-        index=myModel->index(x,flightDataModel::JUMPDESTINATION);
-        myModel->setData(index,actionfields.JumpDestination+1);
-
-        index=myModel->index(x,flightDataModel::MODE);
-        myModel->setData(index,actionfields.Mode);
-
-        index=myModel->index(x,flightDataModel::MODE_PARAMS0);
-        myModel->setData(index,actionfields.ModeParameters[0]);
-        index=myModel->index(x,flightDataModel::MODE_PARAMS1);
-        myModel->setData(index,actionfields.ModeParameters[1]);
-        index=myModel->index(x,flightDataModel::MODE_PARAMS2);
-        myModel->setData(index,actionfields.ModeParameters[2]);
-        index=myModel->index(x,flightDataModel::MODE_PARAMS3);
-        myModel->setData(index,actionfields.ModeParameters[3]);
-    }
-}
-int modelUavoProxy::addAction(PathAction * actionObj,PathAction::DataFields actionFields,int lastaction)
-{
-    //check if a similar action already exhists
-    int instances=objManager->getNumInstances(pathactionObj->getObjID());
-    for(int x=0;x<lastaction+1;++x)
-    {
-        PathAction * action=PathAction::GetInstance(objManager,x);
-        Q_ASSERT(action);
-        if(!action)
-            continue;
-        PathAction::DataFields fields=action->getData();
-        if(fields.Command==actionFields.Command
-                && fields.ConditionParameters[0]==actionFields.ConditionParameters[0]
-                && fields.ConditionParameters[1]==actionFields.ConditionParameters[1]
-                && fields.ConditionParameters[2]==actionFields.ConditionParameters[2]
-                &&fields.EndCondition==actionFields.EndCondition
-                &&fields.ErrorDestination==actionFields.ErrorDestination
-                &&fields.JumpDestination==actionFields.JumpDestination
-                &&fields.Mode==actionFields.Mode
-                &&fields.ModeParameters[0]==actionFields.ModeParameters[0]
-                &&fields.ModeParameters[1]==actionFields.ModeParameters[1]
-                &&fields.ModeParameters[2]==actionFields.ModeParameters[2])
-        {
-            qDebug()<<"ModelUAVProxy:"<<"found similar action instance:"<<x;
-            actionObj->deleteLater();
-            return x;
-        }
-    }
-    //if we get here it means no similar action was found, we have to create it
-    if(instances<lastaction+2)
-    {
-        actionObj->initialize(instances,actionObj->getMetaObject());
-        objManager->registerObject(actionObj);
-        actionObj->setData(actionFields);
-        actionObj->updated();
-        qDebug()<<"ModelUAVProxy:"<<"created new action instance:"<<instances;
-        return lastaction+1;
-    }
-    else
-    {
-        PathAction * action=PathAction::GetInstance(objManager,lastaction+1);
-        Q_ASSERT(action);
-        action->setData(actionFields);
-        action->updated();
-        actionObj->deleteLater();
-        qDebug()<<"ModelUAVProxy:"<<"reused action instance:"<<lastaction+1;
-        return lastaction+1;
+        setModelData(x,flightDataModel::ISRELATIVE,true);
+
+        setModelData(x,flightDataModel::COMMAND,actionfields.Command);
+
+        setModelData(x,flightDataModel::CONDITION_PARAMS0,actionfields.ConditionParameters[0]);
+        setModelData(x,flightDataModel::CONDITION_PARAMS1,actionfields.ConditionParameters[1]);
+        setModelData(x,flightDataModel::CONDITION_PARAMS2,actionfields.ConditionParameters[2]);
+        setModelData(x,flightDataModel::CONDITION_PARAMS3,actionfields.ConditionParameters[3]);
+
+        setModelData(x,flightDataModel::CONDITION,actionfields.EndCondition);
+
+        setModelData(x,flightDataModel::ERRORDESTINATION,actionfields.ErrorDestination+1);
+
+        setModelData(x,flightDataModel::JUMPDESTINATION,actionfields.JumpDestination+1);
+
+        setModelData(x,flightDataModel::MODE,actionfields.Mode);
+
+        setModelData(x,flightDataModel::MODE_PARAMS0,actionfields.ModeParameters[0]);
+        setModelData(x,flightDataModel::MODE_PARAMS1,actionfields.ModeParameters[1]);
+        setModelData(x,flightDataModel::MODE_PARAMS2,actionfields.ModeParameters[2]);
+        setModelData(x,flightDataModel::MODE_PARAMS3,actionfields.ModeParameters[3]);
+
+        // The row now matches the objects, cache their data so the
+        // next sync does not send them back
+        rows[x].waypoint=wpfields;
+        rows[x].action=actionfields;
+        rows[x].dirty=false;
     }
-    return -1;//error we should never get here
 }
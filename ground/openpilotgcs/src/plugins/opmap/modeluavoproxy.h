@@ -28,24 +28,60 @@
 #define MODELUAVOPROXY_H
 
 #include <QObject>
+#include <QTimer>
+#include <QSet>
 #include "flightdatamodel.h"
 #include "pathaction.h"
 #include "waypoint.h"
 
+/**
+ * Keeps the flight plan model and the Waypoint/PathAction instances in sync.
+ *
+ * The waypoint and action data of every row is cached and only re-read from
+ * the model when the row was edited. Identical actions share one PathAction
+ * instance and only instances whose data differs from the local object are
+ * uploaded. The uploads are sent in small batches so the telemetry queue is
+ * never flooded, uploadProgress() reports how many of them were sent.
+ */
 class modelUavoProxy:public QObject
 {
     Q_OBJECT
 public:
     explicit modelUavoProxy(QObject *parent, flightDataModel *model);
-    int addAction(PathAction *actionObj, PathAction::DataFields actionFields,int lastaction);
 public slots:
     void modelToObjects();
     void objectsToModel();
+signals:
+    void uploadProgress(int sent,int total);
+private slots:
+    void rowsChanged(const QModelIndex &topLeft,const QModelIndex &bottomRight);
+    void rowsInserted(const QModelIndex &parent,int start,int end);
+    void rowsRemoved(const QModelIndex &parent,int start,int end);
+    void uploadBatch();
+    void uploadCompleted(UAVObject *obj,bool success);
 private:
+    typedef struct {
+        Waypoint::DataFields waypoint;
+        PathAction::DataFields action;
+        bool dirty;
+    } RowData;
+
+    void readRow(int row,RowData &data);
+    void setModelData(int row,int column,const QVariant &value);
+    Waypoint *getWaypoint(int instance);
+    PathAction *getAction(int instance);
+    void queueUpload(UAVObject *obj);
+
     UAVObjectManager *objManager;
     Waypoint * waypointObj;
     PathAction * pathactionObj;
     flightDataModel * myModel;
+    QList<RowData> rows;
+    QList<UAVObject *> uploadQueue;
+    QSet<UAVObject *> unsent;
+    QTimer uploadTimer;
+    int uploadSent;
+    int uploadTotal;
 };
 
 #endif // MODELUAVOPROXY_H
@@ -23,7 +23,9 @@ HEADERS += opmapplugin.h \
     widgetdelegates.h \
     pathplanner.h \
     modeluavoproxy.h \
-    homeeditor.h
+    homeeditor.h \
+    surveygenerator.h \
+    surveydialog.h
 
 SOURCES += opmapplugin.cpp \
     opmapgadgetwidget.cpp \
@@ -39,7 +41,9 @@ SOURCES += opmapplugin.cpp \
     widgetdelegates.cpp \
     pathplanner.cpp \
     modeluavoproxy.cpp \
-    homeeditor.cpp
+    homeeditor.cpp \
+    surveygenerator.cpp \
+    surveydialog.cpp
 
 OTHER_FILES += OPMapGadget.pluginspec
 
@@ -50,6 +54,7 @@ FORMS += opmapgadgetoptionspage.ui \
     opmap_statusbar_widget.ui \
     opmap_overlay_widget.ui \
     pathplanner.ui \
-    homeeditor.ui
+    homeeditor.ui \
+    surveydialog.ui
 
 RESOURCES += opmap.qrc
@@ -225,6 +225,7 @@ OPMapGadgetWidget::OPMapGadgetWidget(QWidget *parent) : QWidget(parent)
     UAVProxy=new modelUavoProxy(this,model);
     connect(table,SIGNAL(sendPathPlanToUAV()),UAVProxy,SLOT(modelToObjects()));
     connect(table,SIGNAL(receivePathPlanFromUAV()),UAVProxy,SLOT(objectsToModel()));
+    connect(UAVProxy,SIGNAL(uploadProgress(int,int)),table,SLOT(uploadProgress(int,int)));
 #endif
     magicWayPoint=m_map->magicWPCreate();
     magicWayPoint->setVisible(false);
@@ -505,7 +506,10 @@ void OPMapGadgetWidget::contextMenuEvent(QContextMenuEvent *event)
             }
 
             if (m_map->WPPresent())
+            {
                 contextMenu.addAction(clearWayPointsAct);	// we have waypoints
+                contextMenu.addAction(surveyAct);
+            }
 
             break;
 
@@ -1367,6 +1371,10 @@ void OPMapGadgetWidget::createActions()
     clearWayPointsAct->setShortcut(tr("Ctrl+C"));
     clearWayPointsAct->setStatusTip(tr("Clear waypoints"));
     connect(clearWayPointsAct, SIGNAL(triggered()), this, SLOT(onClearWayPointsAct_triggered()));
+
+    surveyAct = new QAction(tr("&Survey the waypoint area..."), this);
+    surveyAct->setStatusTip(tr("Replace the waypoints with a survey of the area they outline"));
+    connect(surveyAct, SIGNAL(triggered()), this, SLOT(onSurveyAct_triggered()));
 #endif
     overlayOpacityActGroup = new QActionGroup(this);
     connect(overlayOpacityActGroup, SIGNAL(triggered(QAction *)), this, SLOT(onOverlayOpacityActGroup_triggered(QAction *)));
@@ -1874,6 +1882,17 @@ void OPMapGadgetWidget::onClearWayPointsAct_triggered()
 
  }
 
+void OPMapGadgetWidget::onSurveyAct_triggered()
+{
+    if (!m_widget || !m_map)
+        return;
+
+    if (m_map_mode != Normal_MapMode)
+        return;
+
+    new surveyDialog(model, m_map->Home, this);
+}
+
 
 void OPMapGadgetWidget::onHomeMagicWaypointAct_triggered()
 {
@@ -2062,7 +2081,9 @@ bool OPMapGadgetWidget::getUAVPosition(double &latitude, double &longitude, doub
     NED[1] = positionActualData.East;
     NED[2] = positionActualData.Down;
 
-    Utils::CoordinateConversions().NED2LLA_HomeLLA(homeLLA, NED, LLA);
+    Utils::CoordinateConversions::HomeReference home;
+    Utils::CoordinateConversions().SetHome(homeLLA, home);
+    Utils::CoordinateConversions().NED2LLA(home, 1, &NED[0], &NED[1], &NED[2], &LLA[0], &LLA[1], &LLA[2]);
 
     latitude = LLA[0];
     longitude = LLA[1];
@@ -61,6 +61,7 @@
 #include "opmap_edit_waypoint_dialog.h"
 
 #include "homeeditor.h"
+#include "surveydialog.h"
 
 // ******************************************************
 
@@ -197,6 +198,7 @@ private slots:
     void onLockWayPointAct_triggered();
     void onDeleteWayPointAct_triggered();
     void onClearWayPointsAct_triggered();
+    void onSurveyAct_triggered();
 
     void onMapModeActGroup_triggered(QAction *action);
     void onZoomActGroup_triggered(QAction *action);
@@ -267,6 +269,7 @@ private:
     QAction *lockWayPointAct;
     QAction *deleteWayPointAct;
     QAction *clearWayPointsAct;
+    QAction *surveyAct;
 
     QAction *homeMagicWaypointAct;
 
@@ -36,6 +36,7 @@ pathPlanner::pathPlanner(QWidget *parent) :
     ui(new Ui::pathPlannerUI),wid(NULL),myModel(NULL)
 {
     ui->setupUi(this);
+    ui->progressUpload->setVisible(false);
 }
 
 pathPlanner::~pathPlanner()
@@ -117,3 +118,10 @@ void pathPlanner::on_tbFetchFromUAV_clicked()
 {
     emit receivePathPlanFromUAV();
 }
+
+void pathPlanner::uploadProgress(int sent,int total)
+{
+    ui->progressUpload->setVisible(sent<total);
+    ui->progressUpload->setMaximum(total);
+    ui->progressUpload->setValue(sent);
+}
@@ -44,6 +44,8 @@ public:
     ~pathPlanner();
     
     void setModel(flightDataModel *model,QItemSelectionModel *selection);
+public slots:
+    void uploadProgress(int sent,int total);
 private slots:
         void rowsInserted ( const QModelIndex & parent, int start, int end );
 
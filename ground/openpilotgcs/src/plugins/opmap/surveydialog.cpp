@@ -0,0 +1,119 @@
+/**
+ ******************************************************************************
+ *
+ * @file       surveydialog.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup OPMapPlugin OpenPilot Map Plugin
+ * @{
+ * @brief The OpenPilot Map plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "surveydialog.h"
+#include "ui_surveydialog.h"
+#include <QMessageBox>
+#include <QPushButton>
+
+surveyDialog::surveyDialog(flightDataModel *model,HomeItem *home,QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::surveyDialog),
+    myModel(model),
+    myHome(home)
+{
+    ui->setupUi(this);
+    this->setAttribute(Qt::WA_DeleteOnClose,true);
+    if(!model || !home)
+    {
+        deleteLater();
+        return;
+    }
+
+    int rows=myModel->rowCount();
+    for(int x=0;x<rows;++x)
+    {
+        area.append(internals::PointLatLng(myModel->data(myModel->index(x,flightDataModel::LATPOSITION)).toDouble(),
+                                           myModel->data(myModel->index(x,flightDataModel::LNGPOSITION)).toDouble()));
+    }
+    if(rows<2)
+    {
+        QMessageBox::information(parent,tr("Survey mission"),tr("Add two waypoints at opposite corners of the area or three or more around it first."));
+        deleteLater();
+        return;
+    }
+    if(rows==2)
+    {
+        area=surveyGenerator::rectangle(area.at(0),area.at(1));
+        ui->area->setText(tr("Rectangle of the two waypoints"));
+    }
+    else
+    {
+        ui->area->setText(tr("Polygon of the %1 waypoints").arg(rows));
+    }
+
+    connect(ui->swathWidth,SIGNAL(valueChanged(double)),this,SLOT(updatePreview()));
+    connect(ui->overlap,SIGNAL(valueChanged(int)),this,SLOT(updatePreview()));
+    connect(ui->laneBearing,SIGNAL(valueChanged(double)),this,SLOT(updatePreview()));
+    connect(ui->pointSpacing,SIGNAL(valueChanged(double)),this,SLOT(updatePreview()));
+    updatePreview();
+    this->show();
+}
+
+surveyDialog::~surveyDialog()
+{
+    delete ui;
+}
+
+surveyGenerator::surveyParameters surveyDialog::parameters()
+{
+    surveyGenerator::surveyParameters p;
+    p.swathWidth=ui->swathWidth->value();
+    p.overlap=ui->overlap->value()/100.0;
+    p.laneBearing=ui->laneBearing->value();
+    p.pointSpacing=ui->pointSpacing->value();
+    p.altitude=ui->altitude->value();
+    p.velocity=ui->velocity->value();
+    return p;
+}
+
+/**
+ * The pattern is generated on every change so the waypoint count is
+ * always up to date
+ */
+void surveyDialog::updatePreview()
+{
+    points=surveyGenerator::coverPolygon(area,parameters());
+    if(points.isEmpty())
+        ui->waypoints->setText(tr("None, check the area or increase the spacing"));
+    else
+        ui->waypoints->setText(QString::number(points.length()));
+    ui->buttonBox->button(QDialogButtonBox::Ok)->setEnabled(!points.isEmpty());
+}
+
+void surveyDialog::on_buttonBox_accepted()
+{
+    // The altitude and velocity are not part of the preview
+    QList<pathPlanData> plan=surveyGenerator::pathPlan(points,parameters(),myHome->Coord(),myHome->Altitude());
+    myModel->removeRows(0,myModel->rowCount());
+    myModel->insertPathPlan(0,plan);
+    this->close();
+}
+
+void surveyDialog::on_buttonBox_rejected()
+{
+    this->close();
+}
@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ *
+ * @file       surveydialog.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup OPMapPlugin OpenPilot Map Plugin
+ * @{
+ * @brief The OpenPilot Map plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef SURVEYDIALOG_H
+#define SURVEYDIALOG_H
+
+#include <QDialog>
+#include "opmapcontrol/opmapcontrol.h"
+#include "flightdatamodel.h"
+#include "surveygenerator.h"
+
+using namespace mapcontrol;
+
+namespace Ui {
+class surveyDialog;
+}
+
+/**
+ * Replaces the flight plan with a survey of the area outlined by its
+ * waypoints, two waypoints are taken as opposite corners of a rectangle
+ */
+class surveyDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit surveyDialog(flightDataModel *model,HomeItem *home,QWidget *parent = 0);
+    ~surveyDialog();
+
+private slots:
+    void updatePreview();
+    void on_buttonBox_accepted();
+    void on_buttonBox_rejected();
+
+private:
+    surveyGenerator::surveyParameters parameters();
+
+    Ui::surveyDialog *ui;
+    flightDataModel *myModel;
+    HomeItem *myHome;
+    QList<internals::PointLatLng> area;
+    QList<internals::PointLatLng> points;
+};
+
+#endif // SURVEYDIALOG_H
@@ -0,0 +1,224 @@
+/**
+ ******************************************************************************
+ *
+ * @file       surveygenerator.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup OPMapPlugin OpenPilot Map Plugin
+ * @{
+ * @brief The OpenPilot Map plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "surveygenerator.h"
+#include <math.h>
+#include <algorithm>
+
+#define DEG2RAD (M_PI/180.0)
+#define RAD2DEG (180.0/M_PI)
+
+// WGS-84 ellipsoid
+#define WGS84_A 6378137.0
+#define WGS84_E2 6.69437999014e-3
+
+/**
+ * The local frame is a sinusoidal projection around the origin: north is the
+ * arc length along the meridian using the meridional radius of the origin,
+ * east is the arc length along the parallel of the point itself. This keeps
+ * the east scale right over areas of tens of kilometres where a single flat
+ * tangent plane would drift.
+ */
+static double meridionalRadius(double latRad)
+{
+    double s=sin(latRad);
+    double w=1.0-WGS84_E2*s*s;
+    return WGS84_A*(1.0-WGS84_E2)/(w*sqrt(w));
+}
+
+static double parallelRadius(double latRad)
+{
+    double s=sin(latRad);
+    return WGS84_A/sqrt(1.0-WGS84_E2*s*s)*cos(latRad);
+}
+
+void surveyGenerator::latLngToNE(const internals::PointLatLng &origin, const double *lat, const double *lng,
+                                 double *north, double *east, int count)
+{
+    const double lat0=origin.Lat();
+    const double lng0=origin.Lng();
+    const double northScale=meridionalRadius(lat0*DEG2RAD)*DEG2RAD;
+    for(int x=0;x<count;++x)
+    {
+        north[x]=(lat[x]-lat0)*northScale;
+        east[x]=(lng[x]-lng0)*DEG2RAD*parallelRadius(lat[x]*DEG2RAD);
+    }
+}
+
+void surveyGenerator::NEToLatLng(const internals::PointLatLng &origin, const double *north, const double *east,
+                                 double *lat, double *lng, int count)
+{
+    const double lat0=origin.Lat();
+    const double lng0=origin.Lng();
+    const double latScale=1.0/(meridionalRadius(lat0*DEG2RAD)*DEG2RAD);
+    for(int x=0;x<count;++x)
+    {
+        lat[x]=lat0+north[x]*latScale;
+        lng[x]=lng0+east[x]/parallelRadius(lat[x]*DEG2RAD)*RAD2DEG;
+    }
+}
+
+/**
+ * The corners of the latitude/longitude box spanned by two opposite corners
+ */
+QList<internals::PointLatLng> surveyGenerator::rectangle(const internals::PointLatLng &corner1, const internals::PointLatLng &corner2)
+{
+    QList<internals::PointLatLng> corners;
+    corners.append(corner1);
+    corners.append(internals::PointLatLng(corner1.Lat(),corner2.Lng()));
+    corners.append(corner2);
+    corners.append(internals::PointLatLng(corner2.Lat(),corner1.Lng()));
+    return corners;
+}
+
+/**
+ * Lay parallel lanes over the polygon and return the waypoints flying them
+ * back and forth. Concave polygons give several segments per lane, each one
+ * is flown in the direction of the lane. An empty list is returned if the
+ * polygon can not be covered or the pattern would be too large.
+ */
+QList<internals::PointLatLng> surveyGenerator::coverPolygon(const QList<internals::PointLatLng> &polygon, const surveyParameters &parameters)
+{
+    QList<internals::PointLatLng> points;
+    double spacing=parameters.swathWidth*(1.0-parameters.overlap);
+    int corners=polygon.length();
+    if(corners<3 || spacing<=0)
+        return points;
+
+    // Polygon in the lane frame, u along and w across the lanes
+    QVector<double> lat(corners),lng(corners),north(corners),east(corners);
+    for(int x=0;x<corners;++x)
+    {
+        lat[x]=polygon.at(x).Lat();
+        lng[x]=polygon.at(x).Lng();
+    }
+    internals::PointLatLng origin=polygon.first();
+    latLngToNE(origin,lat.constData(),lng.constData(),north.data(),east.data(),corners);
+
+    const double cosB=cos(parameters.laneBearing*DEG2RAD);
+    const double sinB=sin(parameters.laneBearing*DEG2RAD);
+    QVector<double> u(corners),w(corners);
+    double wMin=0;
+    double wMax=0;
+    for(int x=0;x<corners;++x)
+    {
+        u[x]=north[x]*cosB+east[x]*sinB;
+        w[x]=-north[x]*sinB+east[x]*cosB;
+        if(x==0 || w[x]<wMin)
+            wMin=w[x];
+        if(x==0 || w[x]>wMax)
+            wMax=w[x];
+    }
+
+    // Lanes are centred on the swaths, a narrow area gets one lane in the middle
+    QVector<double> laneU,laneW;
+    double first=wMin+spacing/2;
+    if(first>wMax)
+        first=(wMin+wMax)/2;
+    int lane=0;
+    for(double laneOffset=first;laneOffset<=wMax;laneOffset+=spacing,++lane)
+    {
+        QList<double> crossings;
+        for(int x=0;x<corners;++x)
+        {
+            int y=(x+1)%corners;
+            if((w[x]<=laneOffset)!=(w[y]<=laneOffset))
+                crossings.append(u[x]+(laneOffset-w[x])*(u[y]-u[x])/(w[y]-w[x]));
+        }
+        qSort(crossings);
+        if(lane%2)
+            std::reverse(crossings.begin(),crossings.end());
+
+        for(int x=0;x+1<crossings.length();x+=2)
+        {
+            double start=crossings.at(x);
+            double length=crossings.at(x+1)-start;
+            int steps=1;
+            if(parameters.pointSpacing>0)
+                steps=qMax(1,(int)ceil(fabs(length)/parameters.pointSpacing));
+            if(laneU.size()+steps+1>maxWaypoints)
+                return points;
+            for(int step=0;step<=steps;++step)
+            {
+                laneU.append(start+length*step/steps);
+                laneW.append(laneOffset);
+            }
+        }
+    }
+
+    // Back to north/east and then to latitude/longitude in one pass
+    int count=laneU.size();
+    north.resize(count);
+    east.resize(count);
+    lat.resize(count);
+    lng.resize(count);
+    for(int x=0;x<count;++x)
+    {
+        north[x]=laneU[x]*cosB-laneW[x]*sinB;
+        east[x]=laneU[x]*sinB+laneW[x]*cosB;
+    }
+    NEToLatLng(origin,north.constData(),east.constData(),lat.data(),lng.data(),count);
+    for(int x=0;x<count;++x)
+        points.append(internals::PointLatLng(lat[x],lng[x]));
+    return points;
+}
+
+/**
+ * Turn the points into rows for the flight data model, the relative
+ * distance and bearing are filled in as they are used for the upload
+ */
+QList<pathPlanData> surveyGenerator::pathPlan(const QList<internals::PointLatLng> &points, const surveyParameters &parameters,
+                                              const internals::PointLatLng &home, double homeAltitude)
+{
+    int count=points.length();
+    QVector<double> lat(count),lng(count),north(count),east(count);
+    for(int x=0;x<count;++x)
+    {
+        lat[x]=points.at(x).Lat();
+        lng[x]=points.at(x).Lng();
+    }
+    latLngToNE(home,lat.constData(),lng.constData(),north.data(),east.data(),count);
+
+    QList<pathPlanData> plan;
+    pathPlanData data;
+    flightDataModel::initPathPlanData(&data);
+    data.isRelative=false;
+    data.altitude=homeAltitude+parameters.altitude;
+    data.altitudeRelative=parameters.altitude;
+    data.velocity=parameters.velocity;
+    data.jumpdestination=1;
+    data.errordestination=1;
+    for(int x=0;x<count;++x)
+    {
+        data.wpDescritption=QString("Survey %1").arg(x+1);
+        data.latPosition=lat[x];
+        data.lngPosition=lng[x];
+        data.disRelative=sqrt(north[x]*north[x]+east[x]*east[x]);
+        data.beaRelative=atan2(east[x],north[x])*RAD2DEG;
+        plan.append(data);
+    }
+    return plan;
+}
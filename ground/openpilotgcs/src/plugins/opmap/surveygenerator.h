@@ -0,0 +1,70 @@
+/**
+ ******************************************************************************
+ *
+ * @file       surveygenerator.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup OPMapPlugin OpenPilot Map Plugin
+ * @{
+ * @brief The OpenPilot Map plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef SURVEYGENERATOR_H
+#define SURVEYGENERATOR_H
+
+#include <QList>
+#include <QVector>
+#include "flightdatamodel.h"
+
+/**
+ * Generates lawnmower survey patterns covering a polygon.
+ *
+ * The pattern is laid out in metres in a local frame around the first polygon
+ * vertex and converted to latitude/longitude at the end. The conversions work
+ * on arrays of coordinates with the meridional radius of the origin hoisted
+ * out of the loops. Each point still needs the radius of its own parallel,
+ * a sin, a cos and a sqrt.
+ */
+class surveyGenerator
+{
+public:
+    // coverPolygon() gives up on patterns with more waypoints
+    static const int maxWaypoints=20000;
+
+    struct surveyParameters
+    {
+        double swathWidth;   // [m] ground width covered by one lane
+        double overlap;      // [0..1) overlap between neighbouring lanes
+        double laneBearing;  // [deg] direction of the lanes, clockwise from north
+        double pointSpacing; // [m] distance between waypoints on a lane, 0 for the lane ends only
+        double altitude;     // [m] above the home location
+        float velocity;      // [m/s]
+    };
+
+    static QList<internals::PointLatLng> rectangle(const internals::PointLatLng &corner1, const internals::PointLatLng &corner2);
+    static QList<internals::PointLatLng> coverPolygon(const QList<internals::PointLatLng> &polygon, const surveyParameters &parameters);
+    static QList<pathPlanData> pathPlan(const QList<internals::PointLatLng> &points, const surveyParameters &parameters,
+                                        const internals::PointLatLng &home, double homeAltitude);
+
+    static void latLngToNE(const internals::PointLatLng &origin, const double *lat, const double *lng,
+                           double *north, double *east, int count);
+    static void NEToLatLng(const internals::PointLatLng &origin, const double *north, const double *east,
+                           double *lat, double *lng, int count);
+};
+
+#endif // SURVEYGENERATOR_H
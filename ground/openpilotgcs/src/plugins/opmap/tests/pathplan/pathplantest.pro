@@ -0,0 +1,21 @@
+# Inserts generated path plans through the model and map proxy used by the
+# path planner and checks the rows are not modified by the map. Build it from
+# the GCS build tree after the UAVObjects plugin and the opmapcontrol library.
+QT += xml
+TARGET = tst_pathplan
+CONFIG += qtestlib
+CONFIG -= app_bundle
+TEMPLATE = app
+include(../../../../../openpilotgcs.pri)
+include(../../../../libs/opmapcontrol/opmapcontrol.pri)
+include(../../../uavobjects/uavobjects.pri)
+LIBS += -L$$GCS_PLUGIN_PATH/OpenPilot -L$$GCS_LIBRARY_PATH
+INCLUDEPATH += $$GCS_SOURCE_TREE/src/plugins ../..
+
+SOURCES += tst_pathplan.cpp \
+    ../../flightdatamodel.cpp \
+    ../../modelmapproxy.cpp \
+    ../../surveygenerator.cpp
+HEADERS += ../../flightdatamodel.h \
+    ../../modelmapproxy.h \
+    ../../surveygenerator.h
@@ -0,0 +1,158 @@
+/**
+ ******************************************************************************
+ *
+ * @file       tst_pathplan.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup OPMapPlugin OpenPilot Map Plugin
+ * @{
+ * @brief Tests of the path plan insertion into the model and the map
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include <QtTest/QtTest>
+#include <QItemSelectionModel>
+#include <math.h>
+#include "flightdatamodel.h"
+#include "modelmapproxy.h"
+#include "surveygenerator.h"
+
+using namespace mapcontrol;
+
+class tst_PathPlan : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void surveyKeepsCoordinates();
+    void surveyInsertedAtEnd();
+    void insertSurvey();
+
+private:
+    QList<pathPlanData> survey(double size);
+    void compareRows(const QList<pathPlanData> &plan, int first);
+
+    OPMapWidget *map;
+    flightDataModel *model;
+    QItemSelectionModel *selection;
+    modelMapProxy *proxy;
+    internals::PointLatLng home;
+};
+
+void tst_PathPlan::init()
+{
+    map = new OPMapWidget();
+    model = new flightDataModel(this);
+    selection = new QItemSelectionModel(model);
+    proxy = new modelMapProxy(this, map, model, selection);
+
+    // The map centre is away from the survey so a waypoint moved to it shows
+    home = internals::PointLatLng(47.0, 8.0);
+    map->Home->SetCoord(home);
+    map->Home->SetAltitude(400);
+    map->SetCurrentPosition(internals::PointLatLng(46.5, 7.5));
+}
+
+void tst_PathPlan::cleanup()
+{
+    delete proxy;
+    delete selection;
+    delete model;
+    delete map;
+}
+
+/**
+ * A survey of a square with sides of about size metres north east of home
+ */
+QList<pathPlanData> tst_PathPlan::survey(double size)
+{
+    surveyGenerator::surveyParameters parameters;
+    parameters.swathWidth = 20;
+    parameters.overlap = 0.2;
+    parameters.laneBearing = 30;
+    parameters.pointSpacing = 10;
+    parameters.altitude = 50;
+    parameters.velocity = 10;
+
+    internals::PointLatLng corner(home.Lat() + size / 111320.0,
+                                  home.Lng() + size / (111320.0 * cos(home.Lat() * M_PI / 180.0)));
+    QList<internals::PointLatLng> points =
+            surveyGenerator::coverPolygon(surveyGenerator::rectangle(home, corner), parameters);
+    return surveyGenerator::pathPlan(points, parameters, home, map->Home->Altitude());
+}
+
+/**
+ * The model rows from first on and their map waypoints must hold the plan
+ */
+void tst_PathPlan::compareRows(const QList<pathPlanData> &plan, int first)
+{
+    QMap<int, WayPointItem*> items = map->WPAll();
+    QCOMPARE(items.size(), model->rowCount());
+    for (int n = 0; n < plan.length(); ++n) {
+        int row = first + n;
+        QCOMPARE(model->data(model->index(row, flightDataModel::LATPOSITION)).toDouble(), plan[n].latPosition);
+        QCOMPARE(model->data(model->index(row, flightDataModel::LNGPOSITION)).toDouble(), plan[n].lngPosition);
+        QCOMPARE(model->data(model->index(row, flightDataModel::ALTITUDE)).toDouble(), plan[n].altitude);
+        QCOMPARE(model->data(model->index(row, flightDataModel::DISRELATIVE)).toDouble(), plan[n].disRelative);
+        QCOMPARE(model->data(model->index(row, flightDataModel::BEARELATIVE)).toDouble(), plan[n].beaRelative);
+
+        WayPointItem *item = items.value(row);
+        QVERIFY(item);
+        QCOMPARE(item->Coord().Lat(), plan[n].latPosition);
+        QCOMPARE(item->Coord().Lng(), plan[n].lngPosition);
+    }
+}
+
+void tst_PathPlan::surveyKeepsCoordinates()
+{
+    QList<pathPlanData> plan = survey(300);
+    QVERIFY(plan.length() > 100);
+    QVERIFY(model->insertPathPlan(0, plan));
+    compareRows(plan, 0);
+}
+
+void tst_PathPlan::surveyInsertedAtEnd()
+{
+    QList<pathPlanData> first = survey(100);
+    QList<pathPlanData> second = survey(200);
+    QVERIFY(model->insertPathPlan(0, first));
+    QVERIFY(model->insertPathPlan(model->rowCount(), second));
+    compareRows(first, 0);
+    compareRows(second, first.length());
+}
+
+/**
+ * Replacing the plan with a survey of about 5000 waypoints, as the survey dialog does
+ */
+void tst_PathPlan::insertSurvey()
+{
+    QList<pathPlanData> plan = survey(850);
+    QVERIFY(plan.length() > 4000);
+    QBENCHMARK {
+        if (model->rowCount() > 0)
+            model->removeRows(0, model->rowCount());
+        model->insertPathPlan(0, plan);
+    }
+    compareRows(plan, 0);
+}
+
+QTEST_MAIN(tst_PathPlan)
+
+#include "tst_pathplan.moc"
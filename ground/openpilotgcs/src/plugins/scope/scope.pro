@@ -11,6 +11,7 @@ HEADERS += scopegadgetconfiguration.h
 HEADERS += scopegadget.h
 HEADERS += scopegadgetwidget.h
 HEADERS += scopegadgetfactory.h
+HEADERS += scopelogwriter.h
 SOURCES += scopeplugin.cpp \
     plotdata.cpp
 SOURCES += scopegadgetoptionspage.cpp
@@ -18,5 +19,6 @@ SOURCES += scopegadgetconfiguration.cpp
 SOURCES += scopegadget.cpp
 SOURCES += scopegadgetfactory.cpp
 SOURCES += scopegadgetwidget.cpp
+SOURCES += scopelogwriter.cpp
 OTHER_FILES += ScopeGadget.pluginspec
 FORMS += scopegadgetoptionspage.ui
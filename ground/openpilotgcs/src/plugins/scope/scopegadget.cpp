@@ -83,6 +83,7 @@ void ScopeGadget::loadConfiguration(IUAVGadgetConfiguration* config)
     widget->setLoggingEnabled(sgConfig->getLoggingEnabled());
     widget->setLoggingNewFileOnConnect(sgConfig->getLoggingNewFileOnConnect());
     widget->setLoggingPath(sgConfig->getLoggingPath());
+    widget->setLoggingCsvOnClose(sgConfig->getLoggingCsvOnClose());
 
     widget->csvLoggingStop();
     widget->csvLoggingSetName(sgConfig->name());
@@ -32,7 +32,8 @@ ScopeGadgetConfiguration::ScopeGadgetConfiguration(QString classId, QSettings* q
         m_plotType((int)ChronoPlot),
         m_dataSize(60),
         m_refreshInterval(1000),
-        m_mathFunctionType(0)
+        m_mathFunctionType(0),
+        m_LoggingCsvOnClose(true)
 {
     uint currentStreamVersion = 0;
     int plotCurveCount = 0;
@@ -82,6 +83,7 @@ ScopeGadgetConfiguration::ScopeGadgetConfiguration(QString classId, QSettings* q
         m_LoggingEnabled = qSettings->value("LoggingEnabled").toBool();
         m_LoggingNewFileOnConnect = qSettings->value("LoggingNewFileOnConnect").toBool();
         m_LoggingPath = qSettings->value("LoggingPath").toString();
+        m_LoggingCsvOnClose = qSettings->value("LoggingCsvOnClose", true).toBool();
 
     }
 }
@@ -137,6 +139,7 @@ IUAVGadgetConfiguration *ScopeGadgetConfiguration::clone()
     m->setLoggingEnabled(m_LoggingEnabled);
     m->setLoggingNewFileOnConnect(m_LoggingNewFileOnConnect);
     m->setLoggingPath(m_LoggingPath);
+    m->setLoggingCsvOnClose(m_LoggingCsvOnClose);
 
 
 
@@ -179,6 +182,7 @@ void ScopeGadgetConfiguration::saveConfig(QSettings* qSettings) const {
     qSettings->setValue("LoggingEnabled",  m_LoggingEnabled);
     qSettings->setValue("LoggingNewFileOnConnect",  m_LoggingNewFileOnConnect);
     qSettings->setValue("LoggingPath",  m_LoggingPath);
+    qSettings->setValue("LoggingCsvOnClose",  m_LoggingCsvOnClose);
 
 
 }
@@ -77,9 +77,11 @@ public:
     bool getLoggingEnabled(){return m_LoggingEnabled;};
     bool getLoggingNewFileOnConnect(){return m_LoggingNewFileOnConnect;};
     QString getLoggingPath(){return m_LoggingPath;};
+    bool getLoggingCsvOnClose(){return m_LoggingCsvOnClose;};
     void setLoggingEnabled(bool value){m_LoggingEnabled=value;};
     void setLoggingNewFileOnConnect(bool value){m_LoggingNewFileOnConnect=value;};
     void setLoggingPath(QString value){m_LoggingPath=value;};
+    void setLoggingCsvOnClose(bool value){m_LoggingCsvOnClose=value;};
 
 private:
 
@@ -94,6 +96,7 @@ private:
     bool m_LoggingEnabled;
     bool m_LoggingNewFileOnConnect;
     QString m_LoggingPath;
+    bool m_LoggingCsvOnClose;
 
 };
 
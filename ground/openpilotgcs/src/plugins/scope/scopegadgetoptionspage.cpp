@@ -131,6 +131,7 @@ QWidget* ScopeGadgetOptionsPage::createPage(QWidget *parent)
     options_page->LoggingPath->setPath(m_config->getLoggingPath());
     options_page->LoggingConnect->setChecked(m_config->getLoggingNewFileOnConnect());
     options_page->LoggingEnable->setChecked(m_config->getLoggingEnabled());
+    options_page->LoggingCsvOnClose->setChecked(m_config->getLoggingCsvOnClose());
     connect(options_page->LoggingEnable, SIGNAL(clicked()), this, SLOT(on_loggingEnable_clicked()));
     on_loggingEnable_clicked();
 
@@ -307,6 +308,7 @@ void ScopeGadgetOptionsPage::apply()
     m_config->setLoggingPath(options_page->LoggingPath->path());
     m_config->setLoggingNewFileOnConnect(options_page->LoggingConnect->isChecked());
     m_config->setLoggingEnabled(options_page->LoggingEnable->isChecked());
+    m_config->setLoggingCsvOnClose(options_page->LoggingCsvOnClose->isChecked());
 
 }
 
@@ -402,6 +404,7 @@ void ScopeGadgetOptionsPage::on_loggingEnable_clicked()
     bool en = options_page->LoggingEnable->isChecked();
     options_page->LoggingPath->setEnabled(en);
     options_page->LoggingConnect->setEnabled(en);
+    options_page->LoggingCsvOnClose->setEnabled(en);
     options_page->LoggingLabel->setEnabled(en);
 
  }
@@ -73,16 +73,13 @@ ScopeGadgetWidget::ScopeGadgetWidget(QWidget *parent) : QwtPlot(parent)
     connect(cm, SIGNAL(deviceAboutToDisconnect()), this, SLOT(stopPlotting()));
     connect(cm, SIGNAL(deviceConnected(QIODevice*)), this, SLOT(startPlotting()));
 
-    m_csvLoggingStarted=0;
     m_csvLoggingEnabled=0;
-    m_csvLoggingHeaderSaved=0;
-    m_csvLoggingDataSaved=0;
-    m_csvLoggingDataUpdated=0;
     m_csvLoggingNameSet=0;
     m_csvLoggingConnected=0;
     m_csvLoggingNewFileOnConnect=0;
+    m_csvLoggingCsvOnClose=1;
     m_csvLoggingPath = QString("./csvlogging/");
-    m_csvLoggingStartTime = QDateTime::currentDateTime();
+    m_csvLoggingWriter = NULL;
 
     //Listen to autopilot connection events
     connect(cm, SIGNAL(deviceAboutToDisconnect()), this, SLOT(csvLoggingDisconnect()));
@@ -91,6 +88,8 @@ ScopeGadgetWidget::ScopeGadgetWidget(QWidget *parent) : QwtPlot(parent)
 
 ScopeGadgetWidget::~ScopeGadgetWidget()
 {
+    csvLoggingStop();
+
 	if (replotTimer)
 	{
 		replotTimer->stop();
@@ -475,9 +474,8 @@ void ScopeGadgetWidget::addCurvePlot(QString uavObject, QString uavFieldSubField
 void ScopeGadgetWidget::uavObjectReceived(UAVObject* obj)
 {
     foreach(PlotData* plotData, m_curvesData.values()) {
-        if (plotData->append(obj)) m_csvLoggingDataUpdated=1;
+        plotData->append(obj);
     }
-    csvLoggingAddData();
 }
 
 void ScopeGadgetWidget::replotNewData()
@@ -498,8 +496,6 @@ void ScopeGadgetWidget::replotNewData()
 
 //	qDebug() << "replotNewData from " << NOW.addSecs(- m_xWindowSize) << " to " << NOW;
 
-    csvLoggingInsertData();
-
 	replot();
 }
 
@@ -563,156 +559,74 @@ void ScopeGadgetWidget::clearCurvePlots()
 }
 
 
-/*
-int csvLoggingEnable;
-int csvLoggingHeaderSaved;
-int csvLoggingDataSaved;
-QString csvLoggingPath;
-QFile csvLoggingFile;
-*/
+/*!
+  \brief Start logging the raw values of the plotted fields. The samples are
+  taken when the objects are updated and written by a ScopeLogWriter thread.
+  */
 int ScopeGadgetWidget::csvLoggingStart()
 {
-    if (!m_csvLoggingStarted)
+    if (!m_csvLoggingWriter)
     if (m_csvLoggingEnabled)
     if ((!m_csvLoggingNewFileOnConnect)||(m_csvLoggingNewFileOnConnect && m_csvLoggingConnected))
     {
         QDateTime NOW = QDateTime::currentDateTime();
-        m_csvLoggingStartTime = NOW;
-        m_csvLoggingHeaderSaved=0;
-        m_csvLoggingDataSaved=0;
-        m_csvLoggingBuffer.clear();
         QDir PathCheck(m_csvLoggingPath);
         if (!PathCheck.exists())
         {
             PathCheck.mkpath("./");
         }
 
-
+        QString fileName;
         if (m_csvLoggingNameSet)
         {
-            m_csvLoggingFile.setFileName(QString("%1/%2_%3_%4.csv").arg(m_csvLoggingPath).arg(m_csvLoggingName).arg(NOW.toString("yyyy-MM-dd")).arg(NOW.toString("hh-mm-ss")));
+            fileName = QString("%1/%2_%3_%4.scopelog").arg(m_csvLoggingPath).arg(m_csvLoggingName).arg(NOW.toString("yyyy-MM-dd")).arg(NOW.toString("hh-mm-ss"));
         }
         else
         {
-            m_csvLoggingFile.setFileName(QString("%1/Log_%2_%3.csv").arg(m_csvLoggingPath).arg(NOW.toString("yyyy-MM-dd")).arg(NOW.toString("hh-mm-ss")));
-        }
-        QDir FileCheck(m_csvLoggingFile.fileName());
-        if (FileCheck.exists())
-        {
-            m_csvLoggingFile.setFileName("");
+            fileName = QString("%1/Log_%2_%3.scopelog").arg(m_csvLoggingPath).arg(NOW.toString("yyyy-MM-dd")).arg(NOW.toString("hh-mm-ss"));
         }
-        else
-        {
-            m_csvLoggingStarted=1;
-            csvLoggingInsertHeader();
-        }
-
-    }
-
-    return 0;
-}
+        if (QFile::exists(fileName))
+            return -1;
 
-int ScopeGadgetWidget::csvLoggingStop()
-{
-    m_csvLoggingStarted=0;
-
-    return 0;
-}
-
-int ScopeGadgetWidget::csvLoggingInsertHeader()
-{
-    if (!m_csvLoggingStarted) return -1;
-    if (m_csvLoggingHeaderSaved) return -2;
-    if (m_csvLoggingDataSaved) return -3;
-
-    m_csvLoggingHeaderSaved=1;
-    if(m_csvLoggingFile.open(QIODevice::WriteOnly | QIODevice::Append)== FALSE)
-    {
-        qDebug() << "Unable to open " << m_csvLoggingFile.fileName() << " for csv logging Header";
-    }
-    else
-    {
-        QTextStream ts( &m_csvLoggingFile );
-        ts << "date" << ", " << "Time"<< ", " << "Sec since start"<< ", " << "Connected" << ", " << "Data changed";
-
-        foreach(PlotData* plotData2, m_curvesData.values())
+        ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+        UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+        m_csvLoggingWriter = new ScopeLogWriter(fileName);
+        foreach(PlotData* plotData, m_curvesData.values())
         {
-            ts  << ", ";
-            ts  << plotData2->uavObject;
-            ts  << "." << plotData2->uavField;
-            if (plotData2->haveSubField) ts  << "." << plotData2->uavSubField;
-        }
-        ts << endl;
-        m_csvLoggingFile.close();
-    }
-    return 0;
-}
-
-int ScopeGadgetWidget::csvLoggingAddData()
-{
-    if (!m_csvLoggingStarted) return -1;
-    m_csvLoggingDataValid=0;
-    QDateTime NOW = QDateTime::currentDateTime();
-    QString tempString;
-
-    QTextStream ss( &tempString );
-    ss << NOW.toString("yyyy-MM-dd") << ", " << NOW.toString("hh:mm:ss.z") << ", " ;
-
-#if QT_VERSION >= 0x040700
-    ss <<(NOW.toMSecsSinceEpoch() - m_csvLoggingStartTime.toMSecsSinceEpoch())/1000.00;
-#else
-    ss <<(NOW.toTime_t() - m_csvLoggingStartTime.toTime_t());
-#endif
-    ss << ", " << m_csvLoggingConnected << ", " << m_csvLoggingDataUpdated;
-    m_csvLoggingDataUpdated=0;
-
-    foreach(PlotData* plotData2, m_curvesData.values())
-    {
-        ss  << ", ";
-        if (plotData2->xData->isEmpty ())
-        {
-            ss  << ", ";
-            if (plotData2->xData->isEmpty ())
-            {
-            }
-            else
+            UAVObject* obj = objManager->getObject(plotData->uavObject);
+            UAVObjectField* field = obj ? obj->getField(plotData->uavField) : NULL;
+            if (!field)
+                continue;
+
+            QString name = plotData->uavObject + "." + plotData->uavField;
+            int element = 0;
+            if (plotData->haveSubField)
             {
-                ss  << QString().sprintf("%3.10g",plotData2->yData->last());
-                m_csvLoggingDataValid=1;
+                name += "." + plotData->uavSubField;
+                element = field->getElementNames().indexOf(QRegExp(plotData->uavSubField, Qt::CaseSensitive, QRegExp::FixedString));
             }
+            m_csvLoggingWriter->addColumn(obj, field, element, name);
         }
-        else
+
+        if (!m_csvLoggingWriter->open())
         {
-            ss  << QString().sprintf("%3.10g",plotData2->yData->last());
-            m_csvLoggingDataValid=1;
+            delete m_csvLoggingWriter;
+            m_csvLoggingWriter = NULL;
+            return -2;
         }
     }
-    ss << endl;
-    if (m_csvLoggingDataValid)
-    {
-        QTextStream ts( &m_csvLoggingBuffer );
-        ts << tempString;
-    }
 
     return 0;
 }
 
-int ScopeGadgetWidget::csvLoggingInsertData()
+int ScopeGadgetWidget::csvLoggingStop()
 {
-    if (!m_csvLoggingStarted) return -1;
-    m_csvLoggingDataSaved=1;
-
-    if(m_csvLoggingFile.open(QIODevice::WriteOnly | QIODevice::Append)== FALSE)
-    {
-        qDebug() << "Unable to open " << m_csvLoggingFile.fileName() << " for csv logging Data";
-    }
-    else
+    if (m_csvLoggingWriter)
     {
-        QTextStream ts( &m_csvLoggingFile );
-        ts << m_csvLoggingBuffer;
-        m_csvLoggingFile.close();
+        m_csvLoggingWriter->close(m_csvLoggingCsvOnClose);
+        delete m_csvLoggingWriter;
+        m_csvLoggingWriter = NULL;
     }
-    m_csvLoggingBuffer.clear();
 
     return 0;
 }
@@ -731,7 +645,6 @@ void ScopeGadgetWidget::csvLoggingConnect()
 }
 void ScopeGadgetWidget::csvLoggingDisconnect()
 {
-    m_csvLoggingHeaderSaved=0;
     m_csvLoggingConnected=0;
     if (m_csvLoggingNewFileOnConnect)csvLoggingStop();
     return;
@@ -29,6 +29,7 @@
 #define SCOPEGADGETWIDGET_H_
 
 #include "plotdata.h"
+#include "scopelogwriter.h"
 
 #include "qwt/src/qwt.h"
 #include "qwt/src/qwt_plot.h"
@@ -90,6 +91,7 @@ public:
     void setLoggingEnabled(bool value){m_csvLoggingEnabled=value;};
     void setLoggingNewFileOnConnect(bool value){m_csvLoggingNewFileOnConnect=value;};
     void setLoggingPath(QString value){m_csvLoggingPath=value;};
+    void setLoggingCsvOnClose(bool value){m_csvLoggingCsvOnClose=value;};
 
 protected:
 	void mousePressEvent(QMouseEvent *e);
@@ -121,29 +123,18 @@ private:
 
     QTimer *replotTimer;
 
-    bool m_csvLoggingStarted;
     bool m_csvLoggingEnabled;
-    bool m_csvLoggingHeaderSaved;
-    bool m_csvLoggingDataSaved;
     bool m_csvLoggingNameSet;
-    bool m_csvLoggingDataValid;
-    bool m_csvLoggingDataUpdated;
     bool m_csvLoggingConnected;
     bool m_csvLoggingNewFileOnConnect;
-
-    QDateTime m_csvLoggingStartTime;
+    bool m_csvLoggingCsvOnClose;
 
     QString m_csvLoggingName;
     QString m_csvLoggingPath;
-    QString m_csvLoggingBuffer;
-    QFile m_csvLoggingFile;
+    ScopeLogWriter* m_csvLoggingWriter;
 
 	QMutex mutex;
 
-    int csvLoggingInsertHeader();
-    int csvLoggingAddData();
-    int csvLoggingInsertData();
-
 	void deleteLegend();
 	void addLegend();
 };
@@ -0,0 +1,437 @@
+/**
+ ******************************************************************************
+ *
+ * @file       scopelogwriter.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ScopePlugin Scope Gadget Plugin
+ * @{
+ * @brief Background writer for the scope data logs
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "scopelogwriter.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QVarLengthArray>
+#include <QtAlgorithms>
+#include <QtConcurrentRun>
+#include <QDebug>
+
+// File header, "OPSL" and the format version
+#define SCOPELOG_MAGIC 0x4f50534c
+#define SCOPELOG_VERSION 1
+
+#define SCOPELOG_RECORD_COLUMN 1
+#define SCOPELOG_RECORD_BLOCK 2
+
+// A block is written once this many samples are buffered or after the flush interval
+#define SCOPELOG_BLOCK_SAMPLES 8192
+#define SCOPELOG_FLUSH_INTERVAL 1000
+
+struct ScopeLogSample
+{
+    ScopeLogSample *next;
+    UAVObject *object;
+    qint32 time;
+    QVarLengthArray<double, 8> values;
+};
+
+ScopeLogWriter::ScopeLogWriter(const QString& fileName, QObject *parent) :
+        QThread(parent),
+        m_file(fileName),
+        m_buffered(0),
+        m_queue(0),
+        m_stopping(0),
+        m_capturing(false)
+{
+}
+
+ScopeLogWriter::~ScopeLogWriter()
+{
+    close(false);
+}
+
+/*!
+  \brief Log element \a element of \a field of \a obj, fields with the same
+  \a name are only logged once.
+  */
+bool ScopeLogWriter::addColumn(UAVObject* obj, UAVObjectField* field, int element, const QString& name)
+{
+    if (m_file.isOpen() || !obj || !field || element < 0 || element >= (int)field->getNumElements())
+        return false;
+    foreach (const Column& column, m_columns) {
+        if (column.name == name)
+            return false;
+    }
+
+    Column column;
+    column.name = name;
+    ObjectColumns& objectColumns = m_objects[obj];
+    objectColumns.columns.append(m_columns.length());
+    objectColumns.fields.append(field);
+    objectColumns.elements.append(element);
+    m_columns.append(column);
+    return true;
+}
+
+/*!
+  \brief Create the file, write the column definitions and start logging
+  */
+bool ScopeLogWriter::open()
+{
+    if (m_file.isOpen())
+        return false;
+    if (!m_file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Unable to open " << m_file.fileName() << " for scope logging: " << m_file.errorString();
+        return false;
+    }
+
+    m_startTime = QDateTime::currentDateTime().toUTC();
+    m_clock.start();
+    qint64 startMSecs = (qint64)m_startTime.toTime_t() * 1000 + m_startTime.time().msec();
+
+    m_stream.setDevice(&m_file);
+    m_stream.setVersion(QDataStream::Qt_4_6);
+    m_stream << (quint32)SCOPELOG_MAGIC << (quint32)SCOPELOG_VERSION << startMSecs;
+    for (int n = 0; n < m_columns.length(); ++n)
+        m_stream << (quint8)SCOPELOG_RECORD_COLUMN << (quint32)n << m_columns[n].name;
+    m_file.flush();
+
+    m_capturing = true;
+    m_stopping.fetchAndStoreOrdered(0);
+    start(QThread::LowPriority);
+
+    // The values are read on the thread that updates the object
+    foreach (UAVObject* obj, m_objects.keys())
+        connect(obj, SIGNAL(objectUpdated(UAVObject*)), this, SLOT(objectUpdated(UAVObject*)), Qt::DirectConnection);
+    return true;
+}
+
+/*!
+  \brief Stop logging, write the remaining samples and close the file.
+  If \a convertToCsv is set a CSV file with the same base name is written
+  in the background, close() does not wait for it.
+  */
+void ScopeLogWriter::close(bool convertToCsv)
+{
+    if (!m_file.isOpen())
+        return;
+
+    foreach (UAVObject* obj, m_objects.keys())
+        disconnect(obj, SIGNAL(objectUpdated(UAVObject*)), this, SLOT(objectUpdated(UAVObject*)));
+    m_captureLock.lockForWrite();
+    m_capturing = false;
+    m_captureLock.unlock();
+
+    m_stopping.fetchAndStoreOrdered(1);
+    m_pending.release();
+    wait();
+
+    m_stream.setDevice(0);
+    m_file.close();
+
+    if (convertToCsv)
+        QtConcurrent::run(&ScopeLogWriter::convertToCsvInBackground, m_file.fileName());
+}
+
+/*!
+  \brief Take a sample of the logged fields of \a obj, called with the object
+  locked on the thread that updated it.
+  */
+void ScopeLogWriter::objectUpdated(UAVObject* obj)
+{
+    QReadLocker locker(&m_captureLock);
+    if (!m_capturing)
+        return;
+    QHash<UAVObject*, ObjectColumns>::const_iterator it = m_objects.constFind(obj);
+    if (it == m_objects.constEnd())
+        return;
+
+    const ObjectColumns& objectColumns = it.value();
+    ScopeLogSample *sample = new ScopeLogSample;
+    sample->object = obj;
+    sample->time = m_clock.elapsed();
+    for (int n = 0; n < objectColumns.fields.length(); ++n)
+        sample->values.append(objectColumns.fields.at(n)->getDouble(objectColumns.elements.at(n)));
+    push(sample);
+}
+
+/*!
+  \brief Push \a sample onto the queue. Only the sample that finds the queue
+  empty wakes the writer, the others are picked up with the same batch.
+  */
+void ScopeLogWriter::push(ScopeLogSample* sample)
+{
+    ScopeLogSample *head;
+    do {
+        head = m_queue;
+        sample->next = head;
+    } while (!m_queue.testAndSetRelease(head, sample));
+
+    if (!head)
+        m_pending.release();
+}
+
+/*!
+  \brief Move the queued samples to the column buffers, returns the number of samples
+  */
+int ScopeLogWriter::takeQueued()
+{
+    // The stack holds the newest sample first
+    ScopeLogSample *sample = m_queue.fetchAndStoreAcquire(0);
+    ScopeLogSample *batch = 0;
+    while (sample) {
+        ScopeLogSample *next = sample->next;
+        sample->next = batch;
+        batch = sample;
+        sample = next;
+    }
+
+    int count = 0;
+    while (batch) {
+        ScopeLogSample *next = batch->next;
+        const ObjectColumns& objectColumns = m_objects.constFind(batch->object).value();
+        for (int n = 0; n < objectColumns.columns.length(); ++n) {
+            Column& column = m_columns[objectColumns.columns.at(n)];
+            column.times.append(batch->time);
+            column.values.append(batch->values[n]);
+        }
+        count += objectColumns.columns.length();
+        delete batch;
+        batch = next;
+    }
+    m_buffered += count;
+    return count;
+}
+
+/*!
+  \brief Write the buffered samples as one compressed block, column by column
+  */
+void ScopeLogWriter::writeBlock()
+{
+    if (m_buffered == 0)
+        return;
+
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+
+    quint32 columnCount = 0;
+    foreach (const Column& column, m_columns) {
+        if (!column.times.isEmpty())
+            ++columnCount;
+    }
+    out << columnCount;
+    for (int n = 0; n < m_columns.length(); ++n) {
+        Column& column = m_columns[n];
+        if (column.times.isEmpty())
+            continue;
+        out << (quint32)n << (quint32)column.times.size();
+        qint32 previous = 0;
+        foreach (qint32 time, column.times) {
+            out << (qint32)(time - previous);
+            previous = time;
+        }
+        foreach (double value, column.values)
+            out << value;
+        column.times.clear();
+        column.values.clear();
+    }
+
+    m_stream << (quint8)SCOPELOG_RECORD_BLOCK << qCompress(payload);
+    m_file.flush();
+    m_buffered = 0;
+}
+
+void ScopeLogWriter::run()
+{
+    QTime lastBlock;
+    lastBlock.start();
+    while (!m_stopping) {
+        m_pending.tryAcquire(1, SCOPELOG_FLUSH_INTERVAL);
+        takeQueued();
+        if (m_buffered >= SCOPELOG_BLOCK_SAMPLES || lastBlock.elapsed() >= SCOPELOG_FLUSH_INTERVAL) {
+            writeBlock();
+            lastBlock.start();
+        }
+    }
+    takeQueued();
+    writeBlock();
+}
+
+namespace {
+struct CsvEvent {
+    qint32 time;
+    int column;
+    double value;
+    bool operator<(const CsvEvent& other) const { return time < other.time; }
+};
+
+void writeCsvHeader(QTextStream& ts, const QStringList& names)
+{
+    ts << "date" << ", " << "Time" << ", " << "Sec since start";
+    foreach (QString name, names)
+        ts << ", " << name;
+    ts << endl;
+}
+}
+
+/*!
+  \brief Convert \a logFileName to a CSV file with the same base name, runs
+  on a thread of the global thread pool.
+  */
+void ScopeLogWriter::convertToCsvInBackground(const QString& logFileName)
+{
+    QFileInfo info(logFileName);
+    QString csvFileName = info.dir().filePath(info.completeBaseName() + ".csv");
+    QString errorString;
+    if (!convertToCsv(logFileName, csvFileName, &errorString))
+        qDebug() << "Unable to convert " << logFileName << " to csv: " << errorString;
+}
+
+/*!
+  \brief Write a log as CSV, one row per sample time. Columns without a
+  sample at that time repeat their last value.
+  */
+bool ScopeLogWriter::convertToCsv(const QString& logFileName, const QString& csvFileName, QString* errorString)
+{
+    QFile logFile(logFileName);
+    if (!logFile.open(QIODevice::ReadOnly)) {
+        *errorString = logFile.errorString();
+        return false;
+    }
+    QDataStream in(&logFile);
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 magic, version;
+    qint64 startMSecs;
+    in >> magic >> version >> startMSecs;
+    if (in.status() != QDataStream::Ok || magic != SCOPELOG_MAGIC) {
+        *errorString = QObject::tr("This file is not a scope log");
+        return false;
+    }
+    if (version != SCOPELOG_VERSION) {
+        *errorString = QObject::tr("Unsupported scope log version %1").arg(version);
+        return false;
+    }
+
+    QFile csvFile(csvFileName);
+    if (!csvFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        *errorString = csvFile.errorString();
+        return false;
+    }
+    QTextStream ts(&csvFile);
+    QDateTime startTime = QDateTime::fromTime_t(startMSecs / 1000).addMSecs(startMSecs % 1000);
+
+    QStringList names;
+    QHash<quint32, int> columnIndex;
+    QVector<double> lastValues;
+    QVector<bool> haveValue;
+    bool headerWritten = false;
+
+    while (!in.atEnd()) {
+        quint8 type;
+        in >> type;
+        if (type == SCOPELOG_RECORD_COLUMN) {
+            quint32 id;
+            QString name;
+            in >> id >> name;
+            columnIndex.insert(id, names.length());
+            names.append(name);
+        } else if (type == SCOPELOG_RECORD_BLOCK) {
+            QByteArray data;
+            in >> data;
+            if (in.status() != QDataStream::Ok)
+                break;
+            if (!headerWritten) {
+                writeCsvHeader(ts, names);
+                lastValues.fill(0, names.length());
+                haveValue.fill(false, names.length());
+                headerWritten = true;
+            }
+
+            // Merge the columns of the block by sample time
+            QByteArray payload = qUncompress(data);
+            QDataStream block(payload);
+            block.setVersion(QDataStream::Qt_4_6);
+            QList<CsvEvent> events;
+            quint32 columnCount;
+            block >> columnCount;
+            for (quint32 c = 0; c < columnCount && block.status() == QDataStream::Ok; ++c) {
+                quint32 id, count;
+                block >> id >> count;
+                int column = columnIndex.value(id, -1);
+                int first = events.length();
+                qint32 time = 0;
+                for (quint32 n = 0; n < count && block.status() == QDataStream::Ok; ++n) {
+                    qint32 delta;
+                    block >> delta;
+                    time += delta;
+                    CsvEvent event;
+                    event.time = time;
+                    event.column = column;
+                    event.value = 0;
+                    events.append(event);
+                }
+                for (int n = first; n < events.length(); ++n)
+                    block >> events[n].value;
+            }
+            if (block.status() != QDataStream::Ok) {
+                *errorString = QObject::tr("The scope log is corrupt");
+                return false;
+            }
+            qStableSort(events.begin(), events.end());
+
+            for (int n = 0; n < events.length(); ++n) {
+                const CsvEvent& event = events.at(n);
+                if (event.column >= 0) {
+                    lastValues[event.column] = event.value;
+                    haveValue[event.column] = true;
+                }
+                if (n + 1 < events.length() && events.at(n + 1).time == event.time)
+                    continue;
+
+                QDateTime time = startTime.addMSecs(event.time);
+                ts << time.toString("yyyy-MM-dd") << ", " << time.toString("hh:mm:ss.zzz") << ", " << event.time / 1000.0;
+                for (int column = 0; column < lastValues.size(); ++column) {
+                    ts << ", ";
+                    if (haveValue[column])
+                        ts << QString().sprintf("%3.10g", lastValues[column]);
+                }
+                ts << endl;
+            }
+        } else {
+            break;
+        }
+    }
+
+    if (!headerWritten)
+        writeCsvHeader(ts, names);
+
+    // A log cut short, e.g. by a crash, is converted up to the last complete block
+    if (in.status() != QDataStream::Ok || !in.atEnd())
+        qDebug() << "Scope log " << logFileName << " ends with an incomplete record";
+
+    csvFile.close();
+    if (csvFile.error() != QFile::NoError) {
+        *errorString = csvFile.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,129 @@
+/**
+ ******************************************************************************
+ *
+ * @file       scopelogwriter.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ScopePlugin Scope Gadget Plugin
+ * @{
+ * @brief Background writer for the scope data logs
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef SCOPELOGWRITER_H
+#define SCOPELOGWRITER_H
+
+#include "uavobject.h"
+#include "uavobjectfield.h"
+
+#include <QThread>
+#include <QFile>
+#include <QDataStream>
+#include <QDateTime>
+#include <QTime>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QSemaphore>
+#include <QReadWriteLock>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+
+struct ScopeLogSample;
+
+/*!
+  \brief Logs the raw values of UAVObject fields to a compressed column file.
+
+  The values are read and timestamped on the thread that unpacks or sets the
+  object, right when objectUpdated() is emitted, and handed to the writer
+  thread through a lock free queue. The writer thread groups the samples by
+  column and appends them to the file in compressed blocks, nothing is
+  formatted on the GUI thread and the replot interval has no effect on the
+  log. On close() the log can be converted to a CSV file with one row per
+  sample time, the conversion runs in the global thread pool.
+
+  File layout, written with QDataStream: magic, version, the start time in
+  msecs since the epoch (UTC), followed by records. Each record starts with
+  its type, a column record holds the column id and name, a block record
+  holds a qCompress()'d payload with, per column, the id, the sample count,
+  the delta coded sample times in msecs since the start and the values.
+  */
+class ScopeLogWriter : public QThread
+{
+    Q_OBJECT
+
+public:
+    ScopeLogWriter(const QString& fileName, QObject *parent = 0);
+    ~ScopeLogWriter();
+
+    QString fileName() const { return m_file.fileName(); }
+
+    // Columns can only be added before open()
+    bool addColumn(UAVObject* obj, UAVObjectField* field, int element, const QString& name);
+    bool open();
+    void close(bool convertToCsv);
+
+    static bool convertToCsv(const QString& logFileName, const QString& csvFileName, QString* errorString);
+
+private slots:
+    void objectUpdated(UAVObject* obj);
+
+protected:
+    void run();
+
+private:
+    // Samples of a column waiting for the next block, only used by the writer thread
+    struct Column {
+        QString name;
+        QVector<qint32> times;
+        QVector<double> values;
+    };
+
+    // The columns of each object, read by the capturing threads, fixed once open
+    struct ObjectColumns {
+        QList<int> columns;
+        QList<UAVObjectField*> fields;
+        QList<int> elements;
+    };
+
+    static void convertToCsvInBackground(const QString& logFileName);
+
+    void push(ScopeLogSample* sample);
+    int takeQueued();
+    void writeBlock();
+
+    QFile m_file;
+    QDataStream m_stream;
+    QDateTime m_startTime;
+    QTime m_clock;
+
+    QList<Column> m_columns;
+    QHash<UAVObject*, ObjectColumns> m_objects;
+    int m_buffered;
+
+    // The telemetry thread pushes onto a lock free stack, the writer takes all of it at once
+    QAtomicPointer<ScopeLogSample> m_queue;
+    QSemaphore m_pending;
+    QAtomicInt m_stopping;
+
+    // Held for reading while a sample is taken, close() waits for the running ones
+    QReadWriteLock m_captureLock;
+    bool m_capturing;
+};
+
+#endif // SCOPELOGWRITER_H
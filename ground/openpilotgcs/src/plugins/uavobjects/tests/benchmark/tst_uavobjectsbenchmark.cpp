@@ -0,0 +1,297 @@
+/**
+ ******************************************************************************
+ *
+ * @file       tst_uavobjectsbenchmark.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief Benchmarks of the UAVObjects and UAVTalk hot paths
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include <QtTest/QtTest>
+#include <QtCore/QIODevice>
+#include "uavobjectmanager.h"
+#include "uavobjectsinit.h"
+#include "uavobjectfield.h"
+#include "uavtalk/uavtalk.h"
+#include "uavtalk/telemetry.h"
+#include "gcstelemetrystats.h"
+#include "manualcontrolcommand.h"
+#include "stabilizationsettings.h"
+
+// Number of times each object is sent in the recorded stream
+#define STREAM_REPEAT 10
+
+/**
+ * In-memory stand-in for the serial port or socket. Bytes passed to feed()
+ * are delivered to the reader right away, everything written is counted
+ * and optionally recorded.
+ */
+class BenchmarkDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    BenchmarkDevice(QObject *parent = 0) : QIODevice(parent), rxPos(0), written(0), recording(false)
+    {
+        open(QIODevice::ReadWrite);
+    }
+
+    bool isSequential() const
+    {
+        return true;
+    }
+
+    qint64 bytesAvailable() const
+    {
+        return rx.size() - rxPos + QIODevice::bytesAvailable();
+    }
+
+    void feed(const QByteArray &data)
+    {
+        rx.append(data);
+        emit readyRead();
+    }
+
+    void setRecording(bool recording)
+    {
+        this->recording = recording;
+    }
+
+    QByteArray takeRecorded()
+    {
+        QByteArray data = recorded;
+        recorded.clear();
+        return data;
+    }
+
+    qint64 bytesWritten() const
+    {
+        return written;
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize)
+    {
+        qint64 size = qMin(maxSize, (qint64)(rx.size() - rxPos));
+        memcpy(data, rx.constData() + rxPos, size);
+        rxPos += size;
+        if (rxPos == rx.size()) {
+            rx.clear();
+            rxPos = 0;
+        }
+        return size;
+    }
+
+    qint64 writeData(const char *data, qint64 size)
+    {
+        written += size;
+        if (recording)
+            recorded.append(data, size);
+        return size;
+    }
+
+private:
+    QByteArray rx;
+    int rxPos;
+    qint64 written;
+    bool recording;
+    QByteArray recorded;
+};
+
+class tst_UAVObjectsBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void pack();
+    void unpack();
+    void fieldGetValue();
+    void fieldSetValue();
+    void fieldGetDouble();
+    void getObjectById();
+    void getObjectByName();
+    void processInputStream();
+    void telemetryUpdates();
+    void telemetryReceive();
+
+private:
+    UAVObjectManager *objMngr;
+    UAVObject *settings;
+    QList<quint32> objIds;
+    QList<QString> objNames;
+    QByteArray stream;
+};
+
+void tst_UAVObjectsBenchmark::initTestCase()
+{
+    objMngr = new UAVObjectManager();
+    UAVObjectsInitialize(objMngr);
+    settings = StabilizationSettings::GetInstance(objMngr);
+    QVERIFY(settings != NULL);
+
+    QList< QList<UAVObject*> > objs = objMngr->getObjects();
+    foreach (QList<UAVObject*> list, objs) {
+        objIds.append(list[0]->getObjID());
+        objNames.append(list[0]->getName());
+    }
+
+    // Record the stream the flight side would send for all data objects
+    BenchmarkDevice recorder;
+    UAVTalk talk(&recorder, objMngr);
+    recorder.setRecording(true);
+    QList< QList<UAVDataObject*> > dataObjs = objMngr->getDataObjects();
+    for (int n = 0; n < STREAM_REPEAT; ++n) {
+        foreach (QList<UAVDataObject*> list, dataObjs)
+            talk.sendObject(list[0], false, false);
+    }
+    stream = recorder.takeRecorded();
+    QVERIFY(!stream.isEmpty());
+}
+
+void tst_UAVObjectsBenchmark::cleanupTestCase()
+{
+    delete objMngr;
+}
+
+void tst_UAVObjectsBenchmark::pack()
+{
+    QByteArray data(settings->getNumBytes(), 0);
+    QBENCHMARK {
+        settings->pack((quint8*)data.data());
+    }
+}
+
+void tst_UAVObjectsBenchmark::unpack()
+{
+    QByteArray data(settings->getNumBytes(), 0);
+    settings->pack((quint8*)data.data());
+    QBENCHMARK {
+        settings->unpack((const quint8*)data.constData());
+    }
+}
+
+void tst_UAVObjectsBenchmark::fieldGetValue()
+{
+    QList<UAVObjectField*> fields = settings->getFields();
+    QBENCHMARK {
+        foreach (UAVObjectField *field, fields) {
+            for (quint32 n = 0; n < field->getNumElements(); ++n)
+                field->getValue(n);
+        }
+    }
+}
+
+void tst_UAVObjectsBenchmark::fieldSetValue()
+{
+    QList<UAVObjectField*> fields = settings->getFields();
+    QList<QVariant> values;
+    foreach (UAVObjectField *field, fields) {
+        for (quint32 n = 0; n < field->getNumElements(); ++n)
+            values.append(field->getValue(n));
+    }
+    QBENCHMARK {
+        int v = 0;
+        foreach (UAVObjectField *field, fields) {
+            for (quint32 n = 0; n < field->getNumElements(); ++n)
+                field->setValue(values[v++], n);
+        }
+    }
+}
+
+void tst_UAVObjectsBenchmark::fieldGetDouble()
+{
+    QList<UAVObjectField*> fields = settings->getFields();
+    QBENCHMARK {
+        foreach (UAVObjectField *field, fields) {
+            if (!field->isNumeric())
+                continue;
+            for (quint32 n = 0; n < field->getNumElements(); ++n)
+                field->getDouble(n);
+        }
+    }
+}
+
+void tst_UAVObjectsBenchmark::getObjectById()
+{
+    QBENCHMARK {
+        foreach (quint32 objId, objIds)
+            objMngr->getObject(objId);
+    }
+}
+
+void tst_UAVObjectsBenchmark::getObjectByName()
+{
+    QBENCHMARK {
+        foreach (const QString &name, objNames)
+            objMngr->getObject(name);
+    }
+}
+
+void tst_UAVObjectsBenchmark::processInputStream()
+{
+    BenchmarkDevice device;
+    UAVTalk talk(&device, objMngr);
+    QBENCHMARK {
+        device.feed(stream);
+    }
+    QCOMPARE(talk.getStats().rxErrors, (quint32)0);
+}
+
+void tst_UAVObjectsBenchmark::telemetryUpdates()
+{
+    // Telemetry only sends updates once the link is up
+    GCSTelemetryStats *gcsStats = GCSTelemetryStats::GetInstance(objMngr);
+    GCSTelemetryStats::DataFields stats = gcsStats->getData();
+    stats.Status = GCSTelemetryStats::STATUS_CONNECTED;
+    gcsStats->setData(stats);
+
+    // Unacked so no transaction is left waiting for a reply
+    ManualControlCommand *mcc = ManualControlCommand::GetInstance(objMngr);
+    UAVObject::Metadata mdata = mcc->getMetadata();
+    UAVObject::SetGcsTelemetryAcked(mdata, 0);
+    mcc->setMetadata(mdata);
+
+    BenchmarkDevice device;
+    UAVTalk talk(&device, objMngr);
+    Telemetry telemetry(&talk, objMngr);
+    qint64 start = device.bytesWritten();
+    QBENCHMARK {
+        mcc->updated();
+    }
+    QVERIFY(device.bytesWritten() > start);
+}
+
+void tst_UAVObjectsBenchmark::telemetryReceive()
+{
+    BenchmarkDevice device;
+    UAVTalk talk(&device, objMngr);
+    Telemetry telemetry(&talk, objMngr);
+    QBENCHMARK {
+        device.feed(stream);
+    }
+    QCOMPARE(talk.getStats().rxErrors, (quint32)0);
+}
+
+QTEST_MAIN(tst_UAVObjectsBenchmark)
+
+#include "tst_uavobjectsbenchmark.moc"
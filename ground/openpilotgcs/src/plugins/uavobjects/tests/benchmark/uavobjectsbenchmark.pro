@@ -0,0 +1,18 @@
+# Benchmarks of the UAVObjects and UAVTalk hot paths. Build it from the GCS
+# build tree after the UAVObjects and UAVTalk plugins, it links against the
+# plugin libraries and runs headless. Use "-xml -o results.xml" to get the
+# results in a form that can be compared between releases.
+QT -= gui
+TARGET = uavobjectsbenchmark
+CONFIG += qtestlib console
+CONFIG -= app_bundle
+TEMPLATE = app
+include(../../../../../openpilotgcs.pri)
+include(../../../uavtalk/uavtalk.pri)
+LIBS += -L$$GCS_PLUGIN_PATH/OpenPilot -L$$GCS_LIBRARY_PATH
+INCLUDEPATH += $$GCS_SOURCE_TREE/src/plugins
+
+# Telemetry is not exported by the plugin
+SOURCES += tst_uavobjectsbenchmark.cpp \
+    ../../../uavtalk/telemetry.cpp
+HEADERS += ../../../uavtalk/telemetry.h
@@ -47,6 +47,51 @@ UAVObjectField::UAVObjectField(const QString& name, const QString& units, FieldT
     constructorInitialize(name, units, type, elementNames, options,limits);
 }
 
+UAVObjectField::UAVObjectField(const Descriptor* descriptor)
+{
+    // Only reference counts are touched here, the element names, options
+    // and limits were parsed once when the descriptor was created
+    this->name = descriptor->name;
+    this->units = descriptor->units;
+    this->type = descriptor->type;
+    this->elementNames = descriptor->elementNames;
+    this->options = descriptor->options;
+    this->numElements = descriptor->numElements;
+    this->numBytesPerElement = descriptor->numBytesPerElement;
+    this->elementLimits = descriptor->elementLimits;
+    this->offset = 0;
+    this->data = NULL;
+    this->obj = NULL;
+}
+
+/**
+ * Parse the definition of a field once. The descriptor is never freed,
+ * it lives as long as the object type it belongs to.
+ */
+const UAVObjectField::Descriptor* UAVObjectField::createDescriptor(const QString& name, const QString& units, FieldType type, quint32 numElements, const QStringList& options, const QString& limits)
+{
+    return newDescriptor(UAVObjectField(name, units, type, numElements, options, limits));
+}
+
+const UAVObjectField::Descriptor* UAVObjectField::createDescriptor(const QString& name, const QString& units, FieldType type, const QStringList& elementNames, const QStringList& options, const QString& limits)
+{
+    return newDescriptor(UAVObjectField(name, units, type, elementNames, options, limits));
+}
+
+const UAVObjectField::Descriptor* UAVObjectField::newDescriptor(const UAVObjectField& field)
+{
+    Descriptor* descriptor = new Descriptor;
+    descriptor->name = field.name;
+    descriptor->units = field.units;
+    descriptor->type = field.type;
+    descriptor->elementNames = field.elementNames;
+    descriptor->options = field.options;
+    descriptor->numElements = field.numElements;
+    descriptor->numBytesPerElement = field.numBytesPerElement;
+    descriptor->elementLimits = field.elementLimits;
+    return descriptor;
+}
+
 void UAVObjectField::constructorInitialize(const QString& name, const QString& units, FieldType type, const QStringList& elementNames, const QStringList& options,const QString &limits)
 {
     // Copy params
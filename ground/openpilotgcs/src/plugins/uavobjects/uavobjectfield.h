@@ -50,9 +50,28 @@ public:
         QList<QVariant> values;
         int board;
     } LimitStruct;
+    /**
+     * Immutable field metadata, created once per field of an object type and
+     * shared by all its instances. The containers are implicitly shared, so a
+     * field constructed from a descriptor only takes references to them.
+     */
+    typedef struct
+    {
+        QString name;
+        QString units;
+        FieldType type;
+        QStringList elementNames;
+        QStringList options;
+        quint32 numElements;
+        quint32 numBytesPerElement;
+        QMap<quint32, QList<LimitStruct> > elementLimits;
+    } Descriptor;
 
     UAVObjectField(const QString& name, const QString& units, FieldType type, quint32 numElements, const QStringList& options,const QString& limits=QString());
     UAVObjectField(const QString& name, const QString& units, FieldType type, const QStringList& elementNames, const QStringList& options,const QString& limits=QString());
+    UAVObjectField(const Descriptor* descriptor);
+    static const Descriptor* createDescriptor(const QString& name, const QString& units, FieldType type, quint32 numElements, const QStringList& options, const QString& limits=QString());
+    static const Descriptor* createDescriptor(const QString& name, const QString& units, FieldType type, const QStringList& elementNames, const QStringList& options, const QString& limits=QString());
     void initialize(quint8* data, quint32 dataOffset, UAVObject* obj);
     UAVObject* getObject();
     FieldType getType();
@@ -96,6 +115,7 @@ protected:
     void clear();
     void constructorInitialize(const QString& name, const QString& units, FieldType type, const QStringList& elementNames, const QStringList& options, const QString &limits);
     void limitsInitialize(const QString &limits);
+    static const Descriptor* newDescriptor(const UAVObjectField& field);
 
 
 };
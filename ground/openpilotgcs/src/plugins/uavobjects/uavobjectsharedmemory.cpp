@@ -0,0 +1,192 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavobjectsharedmemory.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief Publishes the latest state of each UAVObject in shared memory
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation; either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License 
+ * for more details.
+ * 
+ * You should have received a copy of the GNU General Public License along 
+ * with this program; if not, write to the Free Software Foundation, Inc., 
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "uavobjectsharedmemory.h"
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QDir>
+#include <QtAlgorithms>
+#include <QDebug>
+#include <string.h>
+
+static bool objIdLessThan(UAVDataObject* a, UAVDataObject* b)
+{
+    return a->getObjID() < b->getObjID();
+}
+
+UAVObjectSharedMemory::UAVObjectSharedMemory(UAVObjectManager* objMngr, QObject* parent) :
+        QObject(parent),
+        objMngr(objMngr),
+        region(NULL),
+        startTime(0)
+{
+}
+
+UAVObjectSharedMemory::~UAVObjectSharedMemory()
+{
+    close();
+}
+
+/**
+ * The file lives in /dev/shm where that exists so it is never written back to disk
+ */
+QString UAVObjectSharedMemory::defaultFileName()
+{
+    QDir dir("/dev/shm");
+    if (!dir.exists())
+        dir = QDir::temp();
+    return dir.absoluteFilePath("OpenPilotGCS-UAVObjects.shm");
+}
+
+/**
+ * Create the file, map it and publish the current data of all objects.
+ * Only the first instance of each object is published, objects are in
+ * the order of their object ID like in the generated header.
+ */
+bool UAVObjectSharedMemory::open(const QString& fileName)
+{
+    close();
+
+    QList<UAVDataObject*> objects;
+    foreach (QList<UAVDataObject*> list, objMngr->getDataObjects())
+        objects.append(list[0]);
+    qSort(objects.begin(), objects.end(), objIdLessThan);
+
+    // Header and directory, then one slot per object on its own cache line
+    quint32 directoryOffset = sizeof(Header);
+    quint32 size = directoryOffset + objects.length() * sizeof(DirectoryEntry);
+    QList<quint32> slotOffsets;
+    foreach (UAVDataObject* obj, objects) {
+        size = (size + SLOT_ALIGNMENT - 1) & ~(SLOT_ALIGNMENT - 1);
+        slotOffsets.append(size);
+        size += sizeof(SlotHeader) + obj->getNumBytes();
+    }
+
+    file.setFileName(fileName);
+    if (!file.open(QFile::ReadWrite | QFile::Truncate) || !file.resize(size)) {
+        qDebug() << "UAVObjectSharedMemory: can not create" << fileName << file.errorString();
+        file.close();
+        return false;
+    }
+    region = file.map(0, size);
+    if (region == NULL) {
+        qDebug() << "UAVObjectSharedMemory: can not map" << fileName << file.errorString();
+        file.close();
+        return false;
+    }
+    memset(region, 0, size);
+
+    QDateTime now = QDateTime::currentDateTime().toUTC();
+    startTime = (quint64)now.toTime_t() * 1000 + now.time().msec();
+    clock.start();
+
+    DirectoryEntry* directory = (DirectoryEntry*)(region + directoryOffset);
+    for (int n = 0; n < objects.length(); ++n) {
+        UAVDataObject* obj = objects[n];
+        directory[n].objId = obj->getObjID();
+        directory[n].numBytes = obj->getNumBytes();
+        directory[n].slotOffset = slotOffsets[n];
+        qstrncpy(directory[n].name, obj->getName().toLatin1().constData(), NAME_LENGTH);
+
+        uchar* slot = region + slotOffsets[n];
+        slotMap.insert(obj, slot);
+        writeSlot(obj, slot);
+        // Written on the thread that updates the object
+        connect(obj, SIGNAL(objectUpdated(UAVObject*)), this, SLOT(objectUpdated(UAVObject*)), Qt::DirectConnection);
+    }
+
+    // The magic is written last, readers wait for it before using the directory
+    Header* header = (Header*)region;
+    header->version = VERSION;
+    header->size = size;
+    header->numObjects = objects.length();
+    header->directoryOffset = directoryOffset;
+    header->startTime = startTime;
+    reinterpret_cast<QAtomicInt*>(&header->magic)->fetchAndStoreRelease(MAGIC);
+
+    qDebug() << "UAVObjectSharedMemory: publishing" << objects.length() << "objects in" << fileName;
+    return true;
+}
+
+/**
+ * Stop publishing, the magic is cleared so readers know the data is stale
+ */
+void UAVObjectSharedMemory::close()
+{
+    if (region == NULL)
+        return;
+
+    QWriteLocker locker(&mapLock);
+    foreach (UAVObject* obj, slotMap.keys())
+        obj->disconnect(this);
+    slotMap.clear();
+    reinterpret_cast<QAtomicInt*>(&((Header*)region)->magic)->fetchAndStoreRelease(0);
+    file.unmap(region);
+    region = NULL;
+    file.close();
+}
+
+bool UAVObjectSharedMemory::isOpen() const
+{
+    return region != NULL;
+}
+
+QString UAVObjectSharedMemory::fileName() const
+{
+    return file.fileName();
+}
+
+/**
+ * unpack() and setData() emit objectUpdated() with the object locked, but
+ * updated() emits it without the lock. The object lock is always taken
+ * before mapLock so both paths use the same lock order.
+ */
+void UAVObjectSharedMemory::objectUpdated(UAVObject* obj)
+{
+    QMutexLocker objectLocker(obj->getMutex());
+    QReadLocker locker(&mapLock);
+    uchar* slot = slotMap.value(obj);
+    if (slot != NULL)
+        writeSlot(obj, slot);
+}
+
+/**
+ * Seqlock write, the counter is odd while the data is being replaced.
+ * Objects can be updated from several threads, holding the object lock
+ * (a recursive mutex) keeps a single writer per slot.
+ */
+void UAVObjectSharedMemory::writeSlot(UAVObject* obj, uchar* slot)
+{
+    QMutexLocker locker(obj->getMutex());
+    SlotHeader* header = (SlotHeader*)slot;
+    QAtomicInt* sequence = reinterpret_cast<QAtomicInt*>(&header->sequence);
+
+    sequence->fetchAndAddOrdered(1);
+    header->timestamp = startTime + clock.elapsed();
+    obj->pack(slot + sizeof(SlotHeader));
+    sequence->fetchAndAddRelease(1);
+}
@@ -0,0 +1,112 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavobjectsharedmemory.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief Publishes the latest state of each UAVObject in shared memory
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation; either version 3 of the License, or 
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License 
+ * for more details.
+ * 
+ * You should have received a copy of the GNU General Public License along 
+ * with this program; if not, write to the Free Software Foundation, Inc., 
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef UAVOBJECTSHAREDMEMORY_H
+#define UAVOBJECTSHAREDMEMORY_H
+
+#include "uavobjects_global.h"
+#include "uavobjectmanager.h"
+#include <QFile>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QTime>
+
+/**
+ * Publishes the latest data of every UAVObject in a memory mapped file so
+ * local tools can read it without going through a socket or the GUI.
+ *
+ * The file starts with a header and a directory with one entry per object,
+ * each entry points to a fixed slot holding a sequence counter, the time of
+ * the last update and the packed object data. The sequence counter is odd
+ * while the slot is written, a reader copies the data and retries if the
+ * counter was odd or changed meanwhile. The slots are written on the thread
+ * that updated the object, the GUI thread is not involved.
+ *
+ * The layout is described for external tools by uavobjectsshm.h, generated
+ * by "uavobjgenerator -shm" from uavobjectsshmtemplate.h. Keep the structures
+ * below in sync with the template.
+ */
+class UAVOBJECTS_EXPORT UAVObjectSharedMemory: public QObject
+{
+    Q_OBJECT
+
+public:
+    static const quint32 MAGIC = 0x5541564D; // "UAVM"
+    static const quint32 VERSION = 1;
+    static const int NAME_LENGTH = 48;
+    static const int SLOT_ALIGNMENT = 64;
+
+    typedef struct {
+        quint32 magic;
+        quint32 version;
+        quint32 size;
+        quint32 numObjects;
+        quint32 directoryOffset;
+        quint32 reserved;
+        quint64 startTime;
+    } Header;
+
+    typedef struct {
+        quint32 objId;
+        quint32 numBytes;
+        quint32 slotOffset;
+        quint32 reserved;
+        char name[NAME_LENGTH];
+    } DirectoryEntry;
+
+    typedef struct {
+        quint32 sequence;
+        quint32 reserved;
+        quint64 timestamp;
+    } SlotHeader;
+
+    UAVObjectSharedMemory(UAVObjectManager* objMngr, QObject* parent = 0);
+    ~UAVObjectSharedMemory();
+
+    bool open(const QString& fileName);
+    void close();
+    bool isOpen() const;
+    QString fileName() const;
+
+    static QString defaultFileName();
+
+private slots:
+    void objectUpdated(UAVObject* obj);
+
+private:
+    UAVObjectManager* objMngr;
+    QFile file;
+    uchar* region;
+    quint64 startTime;
+    QTime clock;
+    QReadWriteLock mapLock;
+    QHash<UAVObject*, uchar*> slotMap;
+
+    void writeSlot(UAVObject* obj, uchar* slot);
+};
+
+#endif // UAVOBJECTSHAREDMEMORY_H
@@ -27,8 +27,14 @@
  */
 #include "uavobjectsplugin.h"
 #include "uavobjectsinit.h"
+#include "uavobjectsharedmemory.h"
+#include <coreplugin/icore.h>
+#include <coreplugin/generalsettings.h>
+#include <extensionsystem/pluginmanager.h>
 
-UAVObjectsPlugin::UAVObjectsPlugin()
+UAVObjectsPlugin::UAVObjectsPlugin() :
+    objMngr(NULL),
+    sharedMemory(NULL)
 {
 
 }
@@ -46,10 +52,12 @@ void UAVObjectsPlugin::extensionsInitialized()
 bool UAVObjectsPlugin::initialize(const QStringList & arguments, QString * errorString)
 {
     // Create object manager and expose object
-    UAVObjectManager* objMngr = new UAVObjectManager();
+    objMngr = new UAVObjectManager();
     addAutoReleasedObject(objMngr);
     // Initialize UAVObjects
     UAVObjectsInitialize(objMngr);
+    // The general settings are only read once the core is opened
+    connect(Core::ICore::instance(), SIGNAL(coreOpened()), this, SLOT(coreOpened()));
     // Done
     Q_UNUSED(arguments);
     Q_UNUSED(errorString);
@@ -58,7 +66,18 @@ bool UAVObjectsPlugin::initialize(const QStringList & arguments, QString * error
 
 void UAVObjectsPlugin::shutdown()
 {
+    delete sharedMemory;
+    sharedMemory = NULL;
+}
 
+void UAVObjectsPlugin::coreOpened()
+{
+    ExtensionSystem::PluginManager* pm = ExtensionSystem::PluginManager::instance();
+    Core::Internal::GeneralSettings* settings = pm->getObject<Core::Internal::GeneralSettings>();
+    if (settings && settings->useSharedMemoryExport() && !sharedMemory) {
+        sharedMemory = new UAVObjectSharedMemory(objMngr, this);
+        sharedMemory->open(UAVObjectSharedMemory::defaultFileName());
+    }
 }
 
 Q_EXPORT_PLUGIN(UAVObjectsPlugin)
@@ -33,6 +33,8 @@
 #include <QtPlugin>
 #include "uavobjectmanager.h"
 
+class UAVObjectSharedMemory;
+
 class UAVOBJECTS_EXPORT UAVObjectsPlugin:
         public ExtensionSystem::IPlugin
 {
@@ -45,6 +47,13 @@ public:
     void extensionsInitialized();
     bool initialize(const QStringList & arguments, QString * errorString);
     void shutdown();
+
+private slots:
+    void coreOpened();
+
+private:
+    UAVObjectManager* objMngr;
+    UAVObjectSharedMemory* sharedMemory;
 };
 
 #endif // UAVOBJECTSPLUGIN_H
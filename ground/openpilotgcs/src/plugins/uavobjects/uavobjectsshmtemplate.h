@@ -0,0 +1,134 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavobjectsshm.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ *
+ * @note       This is an automatically generated file.
+ *             DO NOT modify manually.
+ *
+ * @brief      Layout of the UAVObject shared memory export of the GCS
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+/*
+ * When "Shared memory export" is enabled in the general options the GCS
+ * publishes the latest data of every UAVObject in the file
+ * /dev/shm/OpenPilotGCS-UAVObjects.shm (OpenPilotGCS-UAVObjects.shm in the
+ * temporary directory where /dev/shm does not exist). Map the whole file
+ * read only and use it as follows:
+ *
+ *  - Wait until header.magic is UAVOBJECTS_SHM_MAGIC, it is cleared again
+ *    when the GCS stops publishing.
+ *  - Find the object in the directory by its object ID. The directory is
+ *    sorted by object ID, the <NAME>_SHMINDEX values below are only valid
+ *    if the GCS was built from the same object definitions.
+ *  - Read the slot with uavobjects_shm_read(), the data has the layout of
+ *    the <NAME>Data structure, little endian and without padding.
+ *
+ * Only the first instance of multi instance objects is published.
+ * Timestamps are milliseconds since 1970-01-01 UTC.
+ */
+#ifndef UAVOBJECTSSHM_H
+#define UAVOBJECTSSHM_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define UAVOBJECTS_SHM_MAGIC    0x5541564D
+#define UAVOBJECTS_SHM_VERSION  1
+#define UAVOBJECTS_SHM_NAME_LENGTH 48
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;              /* size of the file in bytes */
+    uint32_t numObjects;        /* number of directory entries */
+    uint32_t directoryOffset;   /* offset of the first directory entry */
+    uint32_t reserved;
+    uint64_t startTime;         /* time the GCS started publishing */
+} UAVObjectsShmHeader;
+
+typedef struct {
+    uint32_t objId;
+    uint32_t numBytes;          /* size of the object data */
+    uint32_t slotOffset;        /* offset of the slot from the start of the file */
+    uint32_t reserved;
+    char name[UAVOBJECTS_SHM_NAME_LENGTH];
+} UAVObjectsShmEntry;
+
+typedef struct {
+    uint32_t sequence;          /* odd while the GCS writes the slot */
+    uint32_t reserved;
+    uint64_t timestamp;         /* time of the last update */
+    /* numBytes of object data follow */
+} UAVObjectsShmSlot;
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define UAVOBJECTS_SHM_BARRIER() MemoryBarrier()
+#else
+#define UAVOBJECTS_SHM_BARRIER() __sync_synchronize()
+#endif
+
+/**
+ * Find the directory entry of an object, NULL if it is not published
+ */
+static inline const UAVObjectsShmEntry* uavobjects_shm_find(const void* base, uint32_t objId)
+{
+    const UAVObjectsShmHeader* header = (const UAVObjectsShmHeader*)base;
+    const UAVObjectsShmEntry* directory = (const UAVObjectsShmEntry*)((const uint8_t*)base + header->directoryOffset);
+    uint32_t n;
+    for (n = 0; n < header->numObjects; ++n) {
+        if (directory[n].objId == objId)
+            return &directory[n];
+    }
+    return NULL;
+}
+
+/**
+ * Copy a consistent snapshot of the object data, retries while the GCS
+ * writes the slot. Returns the timestamp of the data.
+ */
+static inline uint64_t uavobjects_shm_read(const void* base, const UAVObjectsShmEntry* entry, void* data)
+{
+    const volatile UAVObjectsShmSlot* slot = (const volatile UAVObjectsShmSlot*)((const uint8_t*)base + entry->slotOffset);
+    uint32_t start;
+    uint64_t timestamp;
+    for (;;) {
+        start = slot->sequence;
+        UAVOBJECTS_SHM_BARRIER();
+        if (start & 1)
+            continue;
+        timestamp = slot->timestamp;
+        memcpy(data, (const uint8_t*)slot + sizeof(UAVObjectsShmSlot), entry->numBytes);
+        UAVOBJECTS_SHM_BARRIER();
+        if (slot->sequence == start)
+            return timestamp;
+    }
+}
+
+#pragma pack(push, 1)
+$(OBJECTDEFS)
+#pragma pack(pop)
+
+#endif // UAVOBJECTSSHM_H
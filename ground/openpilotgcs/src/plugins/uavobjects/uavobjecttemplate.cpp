@@ -32,23 +32,37 @@
  */
 #include "$(NAMELC).h"
 #include "uavobjectfield.h"
+#include <string.h>
 
 const QString $(NAME)::NAME = QString("$(NAME)");
 const QString $(NAME)::DESCRIPTION = QString("$(DESCRIPTION)");
 const QString $(NAME)::CATEGORY = QString("$(CATEGORY)");
 
+/**
+ * Parse the field definitions, done once on the first instantiation
+ */
+static QList<const UAVObjectField::Descriptor*> createFieldDescriptors()
+{
+    QList<const UAVObjectField::Descriptor*> descriptors;
+$(FIELDSINIT)
+    return descriptors;
+}
+
 /**
  * Constructor
  */
 $(NAME)::$(NAME)(): UAVDataObject(OBJID, ISSINGLEINST, ISSETTINGS, NAME)
 {
-    // Create fields
+    // Create fields, all instances share the same field descriptors
+    static const QList<const UAVObjectField::Descriptor*> descriptors = createFieldDescriptors();
     QList<UAVObjectField*> fields;
-$(FIELDSINIT)
+    for (int n = 0; n < descriptors.length(); ++n)
+        fields.append( new UAVObjectField(descriptors[n]) );
     // Initialize object
     initializeFields(fields, (quint8*)&data, NUMBYTES);
     // Set the default field values
     setDefaultFieldValues();
+    notifiedData = data;
     // Set the object description
     setDescription(DESCRIPTION);
 
@@ -114,9 +128,23 @@ void $(NAME)::setData(const DataFields& data)
     }
 }
 
+/**
+ * Emit the property notifications for the fields that changed since the
+ * last notification, once per object update
+ */
 void $(NAME)::emitNotifications()
 {
-    $(NOTIFY_PROPERTIES_CHANGED)
+    mutex->lock();
+    if (memcmp(&data, &notifiedData, sizeof(DataFields)) == 0) {
+        mutex->unlock();
+        return;
+    }
+    DataFields current = data;
+    DataFields previous = notifiedData;
+    notifiedData = data;
+    mutex->unlock();
+
+$(NOTIFY_PROPERTIES_CHANGED)
 }
 
 /**
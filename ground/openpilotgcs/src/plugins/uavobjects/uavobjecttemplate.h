@@ -83,6 +83,7 @@ private slots:
 	
 private:
     DataFields data;
+    DataFields notifiedData; /** data as last seen by the property notifications */
 
     void setDefaultFieldValues();
 
@@ -312,7 +312,9 @@ int UAVObjectUtilManager::setHomeLocation(double LLA[3], bool save_to_sdcard)
 {
     double Be[3];
 
-    Q_ASSERT (Utils::HomeLocationUtil().getDetails(LLA, Be) >= 0);
+    int ret = Utils::HomeLocationUtil().getDetails(LLA, Be);
+    Q_ASSERT(ret >= 0);
+    if (ret < 0) return -1;
 
     // ******************
     // save the new settings
@@ -169,7 +169,7 @@ void ConfigTaskWidget::addUAVObjectToWidgetRelation(QString object, QString fiel
         obj = objManager->getObject(QString(object),instID);
         Q_ASSERT(obj);
         objectUpdates.insert(obj,true);
-        connect(obj, SIGNAL(objectUpdated(UAVObject*)),this, SLOT(objectUpdated(UAVObject*)));
+        connect(obj, SIGNAL(objectUpdated(UAVObject*)),this, SLOT(objectUpdated(UAVObject*)), Qt::UniqueConnection);
         connect(obj, SIGNAL(objectUpdated(UAVObject*)), this, SLOT(refreshWidgetsValues(UAVObject*)), Qt::UniqueConnection);
     }
     if(!field.isEmpty() && obj)
@@ -181,7 +181,11 @@ void ConfigTaskWidget::addUAVObjectToWidgetRelation(QString object, QString fiel
     ow->index=index;
     ow->scale=scale;
     ow->isLimited=isLimited;
+    ow->needsRefresh=true;
+    ow->refreshSkipped=true;
     objOfInterest.append(ow);
+    if(obj && _field && widget)
+        objectBindings[obj].append(ow);
     if(obj)
     {
         if(smartsave)
@@ -214,6 +218,8 @@ void ConfigTaskWidget::addUAVObjectToWidgetRelation(QString object, QString fiel
             addWidgetToDefaultReloadGroups(widget,defaultReloadGroups);
         shadowsList.insert(widget,ow);
         loadWidgetLimits(widget,_field,index,isLimited,scale);
+        // catch the widget being shown to catch up on refreshes skipped while hidden
+        widget->installEventFilter(this);
     }
 }
 /**
@@ -326,8 +332,17 @@ void ConfigTaskWidget::refreshWidgetsValues(UAVObject * obj)
     if (!allowWidgetUpdates)
         return;
 
-    bool dirtyBack=dirty;
     emit refreshWidgetsValuesRequested();
+    bool dirtyBack=dirty;
+    if(obj)
+    {
+        // Only the relations of the object, widgets showing the current value are left alone
+        foreach(objectToWidget * ow,objectBindings.value(obj))
+            refreshBinding(ow,false);
+        setDirty(dirtyBack);
+        return;
+    }
+
     foreach(objectToWidget * ow,objOfInterest)
     {
         if(ow->object==NULL || ow->field==NULL || ow->widget==NULL)
@@ -335,15 +350,48 @@ void ConfigTaskWidget::refreshWidgetsValues(UAVObject * obj)
             //do nothing
         }
         else
-        {
-            if(ow->object==obj || obj==NULL)
-                setWidgetFromField(ow->widget,ow->field,ow->index,ow->scale,ow->isLimited);
-        }
-
+            refreshBinding(ow,true);
     }
     setDirty(dirtyBack);
 
 }
+/**
+ * Checks if any of the widgets of a relation can currently be seen
+ */
+bool ConfigTaskWidget::isBindingVisible(objectToWidget *ow)
+{
+    if(ow->widget->isVisible())
+        return true;
+    foreach(shadow * sh,ow->shadowsList)
+    {
+        if(sh->widget && sh->widget->isVisible())
+            return true;
+    }
+    return false;
+}
+/**
+ * Sets the widget of a relation from its field, unless the field value did not change since
+ * the last time or no widget of the relation is visible, in which case it is done once shown.
+ * @param ow relation to refresh
+ * @param force set the widget even if the value did not change or it is hidden
+ */
+void ConfigTaskWidget::refreshBinding(objectToWidget *ow, bool force)
+{
+    if(!force && !isBindingVisible(ow))
+    {
+        ow->needsRefresh=true;
+        ow->refreshSkipped=true;
+        return;
+    }
+    QVariant value=ow->field->getValue(ow->index);
+    if(!force && !ow->needsRefresh && value==ow->displayedValue)
+        return;
+    setWidgetFromField(ow->widget,ow->field,ow->index,ow->scale,ow->isLimited);
+    // widgetsContentsChanged flagged the relation while the widgets were set, this was no user edit
+    ow->displayedValue=value;
+    ow->needsRefresh=false;
+    ow->refreshSkipped=false;
+}
 /**
  * SLOT function used to update the uavobject fields from widgets with relation to
  * object field added to the framework pool
@@ -357,6 +405,10 @@ void ConfigTaskWidget::updateObjectsFromWidgets()
         if(ow->object==NULL || ow->field==NULL)
         {
 
+        }
+        else if(ow->widget && ow->refreshSkipped)
+        {
+            // The widgets are older than the field, which already holds the value to keep
         }
         else
             setFieldFromWidget(ow->widget,ow->field,ow->index,ow->scale);
@@ -426,7 +478,7 @@ void ConfigTaskWidget::enableControls(bool enable)
  */
 void ConfigTaskWidget::forceShadowUpdates()
 {
-    foreach(objectToWidget * oTw,objOfInterest)
+    foreach(objectToWidget * oTw,shadowedBindings)
     {
         foreach (shadow * sh, oTw->shadowsList)
         {
@@ -450,6 +502,9 @@ void ConfigTaskWidget::widgetsContentsChanged()
     objectToWidget * oTw= shadowsList.value((QWidget*)sender(),NULL);
     if(oTw)
     {
+        // the widgets no longer necessarily show the field value, but hold one to save
+        oTw->needsRefresh=true;
+        oTw->refreshSkipped=false;
         if(oTw->widget==(QWidget*)sender())
         {
             scale=oTw->scale;
@@ -607,7 +662,9 @@ void ConfigTaskWidget::save()
  */
 bool ConfigTaskWidget::addShadowWidget(QString object, QString field, QWidget *widget, int index, double scale, bool isLimited,QList<int>* defaultReloadGroups,quint32 instID)
 {
-    foreach(objectToWidget * oTw,objOfInterest)
+    if(object.isEmpty() || field.isEmpty())
+        return false;
+    foreach(objectToWidget * oTw,objectBindings.value(objManager->getObject(object,instID)))
     {
         if(!oTw->object || !oTw->widget || !oTw->field)
             continue;
@@ -644,7 +701,11 @@ bool ConfigTaskWidget::addShadowWidget(QString object, QString field, QWidget *w
                 sh->widget=widget;
             }
             shadowsList.insert(widget,oTw);
+            if(oTw->shadowsList.isEmpty())
+                shadowedBindings.append(oTw);
             oTw->shadowsList.append(sh);
+            oTw->needsRefresh=true;
+            widget->installEventFilter(this);
             connectWidgetUpdatesToSlot(widget,SLOT(widgetsContentsChanged()));
             if(defaultReloadGroups)
                 addWidgetToDefaultReloadGroups(widget,defaultReloadGroups);
@@ -1263,21 +1324,36 @@ void ConfigTaskWidget::disableMouseWheelEvents()
     //Disable mouse wheel events
     foreach( QSpinBox * sp, findChildren<QSpinBox*>() ) {
         sp->installEventFilter( this );
+        wheelFilteredWidgets.append( sp );
     }
     foreach( QDoubleSpinBox * sp, findChildren<QDoubleSpinBox*>() ) {
         sp->installEventFilter( this );
+        wheelFilteredWidgets.append( sp );
     }
     foreach( QSlider * sp, findChildren<QSlider*>() ) {
         sp->installEventFilter( this );
+        wheelFilteredWidgets.append( sp );
     }
     foreach( QComboBox * sp, findChildren<QComboBox*>() ) {
         sp->installEventFilter( this );
+        wheelFilteredWidgets.append( sp );
     }
 }
 
 bool ConfigTaskWidget::eventFilter( QObject * obj, QEvent * evt ) {
-    //Filter all wheel events, and ignore them
-    if ( evt->type() == QEvent::Wheel &&
+    //Catch up on refreshes skipped while the relation was hidden
+    if ( evt->type() == QEvent::Show )
+    {
+        objectToWidget * oTw=shadowsList.value(qobject_cast<QWidget*>(obj),NULL);
+        if(oTw && oTw->needsRefresh && oTw->field && allowWidgetUpdates)
+        {
+            bool dirtyBack=dirty;
+            refreshBinding(oTw,false);
+            setDirty(dirtyBack);
+        }
+    }
+    //Filter the wheel events of the widgets registered by disableMouseWheelEvents, and ignore them
+    if ( evt->type() == QEvent::Wheel && wheelFilteredWidgets.contains( obj ) &&
          (qobject_cast<QAbstractSpinBox*>( obj ) ||
           qobject_cast<QComboBox*>( obj ) ||
           qobject_cast<QAbstractSlider*>( obj ) ))
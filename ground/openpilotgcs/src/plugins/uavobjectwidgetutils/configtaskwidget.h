@@ -68,6 +68,9 @@ public:
         double scale;
         bool isLimited;
         QList<shadow *> shadowsList;
+        QVariant displayedValue; // field value last written to the widgets
+        bool needsRefresh; // widgets may not show the field value
+        bool refreshSkipped; // hidden widgets missed a field update, they do not hold a user value
     };
 
     struct temphelper
@@ -168,6 +171,8 @@ private:
     bool allowWidgetUpdates;
     QStringList objectsList;
     QList <objectToWidget*> objOfInterest;
+    QHash<UAVObject *,QList<objectToWidget*> > objectBindings;
+    QList<objectToWidget*> shadowedBindings;
     ExtensionSystem::PluginManager *pm;
     UAVObjectManager *objManager;
     UAVObjectUtilManager* utilMngr;
@@ -177,6 +182,7 @@ private:
     QMap<QWidget *,objectToWidget*> shadowsList;
     QMap<QPushButton *,QString> helpButtonList;
     QList<QPushButton *> reloadButtonList;
+    QList<QObject *> wheelFilteredWidgets;
     bool dirty;
     bool setFieldFromWidget(QWidget *widget, UAVObjectField *field, int index, double scale);
     bool setWidgetFromField(QWidget *widget, UAVObjectField *field, int index, double scale, bool hasLimits);
@@ -185,6 +191,8 @@ private:
     void connectWidgetUpdatesToSlot(QWidget *widget, const char *function);
     void disconnectWidgetUpdatesToSlot(QWidget *widget, const char *function);
     void loadWidgetLimits(QWidget *widget, UAVObjectField *field, int index, bool hasLimits, double sclale);
+    bool isBindingVisible(objectToWidget *ow);
+    void refreshBinding(objectToWidget *ow, bool force);
     QString outOfLimitsStyle;
     QTimer * timeOut;
 protected slots:
@@ -9,10 +9,12 @@ include(uavsettingsimportexport_dependencies.pri)
 
 HEADERS += uavsettingsimportexport.h \
     importsummary.h \
-    uavsettingsimportexportfactory.h
+    uavsettingsimportexportfactory.h \
+    uavsettingsstream.h
 SOURCES += uavsettingsimportexport.cpp \
     importsummary.cpp \
-    uavsettingsimportexportfactory.cpp
+    uavsettingsimportexportfactory.cpp \
+    uavsettingsstream.cpp
  
 OTHER_FILES += uavsettingsimportexport.pluginspec
 
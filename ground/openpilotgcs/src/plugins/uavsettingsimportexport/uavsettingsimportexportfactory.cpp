@@ -43,8 +43,9 @@
 #include "uavobjectmanager.h"
 #include "extensionsystem/pluginmanager.h"
 
-// for XML object
-#include <QDomDocument>
+// for XML and snapshot files
+#include "uavsettingsstream.h"
+#include <QXmlStreamWriter>
 
 // for file dialog and error messages
 #include <QFileDialog>
@@ -94,241 +95,176 @@ void UAVSettingsImportExportFactory::importUAVSettings()
 {
     // ask for file name
     QString fileName;
-    QString filters = tr("UAVObjects XML files (*.uav);; XML files (*.xml)");
+    QString filters = tr("UAVObjects XML files (*.uav);; XML files (*.xml);; UAVObjects binary snapshots (*.uavb)");
     fileName = QFileDialog::getOpenFileName(0, tr("Import UAV Settings"), "", filters);
     if (fileName.isEmpty()) {
         return;
     }
 
-    // Now open the file
-    QFile file(fileName);
-    QDomDocument doc("UAVObjects");
-    file.open(QFile::ReadOnly|QFile::Text);
-    if (!doc.setContent(file.readAll())) {
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+    UAVSettingsStream stream(objManager);
+    QList<UAVSettingsStream::ObjectStatus> status;
+    QList<UAVDataObject*> imported;
+    QString errorString;
+    bool ok;
+    if (UAVSettingsStream::isSnapshotFile(fileName)) {
+        // A snapshot is parsed as a whole, nothing is touched if it is not valid
+        QFile file(fileName);
+        UAVSettingsStream::Snapshot snapshot;
+        ok = file.open(QFile::ReadOnly);
+        if (!ok)
+            errorString = file.errorString();
+        else
+            ok = UAVSettingsStream::readSnapshot(&file, snapshot, &errorString);
+        if (ok) {
+            emit importAboutToBegin();
+            qDebug()<<"Import about to begin";
+            ok = stream.importSnapshot(snapshot, status, imported, &errorString);
+        }
+    } else {
+        // The XML is read straight into the objects, they are restored if it fails
+        emit importAboutToBegin();
+        qDebug()<<"Import about to begin";
+        ok = stream.importFile(fileName, status, imported, &errorString);
+    }
+    if (!ok) {
         QMessageBox msgBox;
         msgBox.setText(tr("File Parsing Failed."));
-        msgBox.setInformativeText(tr("This file is not a correct XML file"));
+        msgBox.setInformativeText(errorString);
         msgBox.setStandardButtons(QMessageBox::Ok);
         msgBox.exec();
         return;
     }
-    file.close();
 
-    // find the root of settings subtree
-    emit importAboutToBegin();
-    qDebug()<<"Import about to begin";
-
-    QDomElement root = doc.documentElement();
-    if (root.tagName() == "uavobjects") {
-        root = root.firstChildElement("settings");
-    }
-    if (root.isNull() || (root.tagName() != "settings")) {
-        QMessageBox msgBox;
-        msgBox.setText(tr("Wrong file contents"));
-        msgBox.setInformativeText(tr("This file does not contain correct UAVSettings"));
-        msgBox.setStandardButtons(QMessageBox::Ok);
-        msgBox.exec();
-        return;
+    //  - Issue an "updated" command for each object
+    foreach (UAVDataObject *obj, imported) {
+        obj->updated();
     }
 
-    // We are now ok: setup the import summary dialog & update it as we
-    // go along.
+    // Show the import summary
     ImportSummaryDialog swui((QWidget*)Core::ICore::instance()->mainWindow());
-
-    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
-    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
-    swui.show();
-
-    QDomNode node = root.firstChild();
-    while (!node.isNull()) {
-        QDomElement e = node.toElement();
-        if (e.tagName() == "object") {
-
-            //  - Read each object
-            QString uavObjectName  = e.attribute("name");
-            uint uavObjectID = e.attribute("id").toUInt(NULL,16);
-
-            // Sanity Check:
-            UAVObject *obj = objManager->getObject(uavObjectName);
-            if (obj == NULL) {
-                // This object is unknown!
-                qDebug() << "Object unknown:" << uavObjectName << uavObjectID;
-                swui.addLine(uavObjectName, "Error (Object unknown)", false);
-            } else {
-                //  - Update each field
-                //  - Issue and "updated" command
-                bool error = false;
-                bool setError = false;
-                QDomNode field = node.firstChild();
-                while(!field.isNull()) {
-                    QDomElement f = field.toElement();
-                    if (f.tagName() == "field") {
-                        UAVObjectField *uavfield = obj->getField(f.attribute("name"));
-                        if (uavfield) {
-                            QStringList list = f.attribute("values").split(",");
-                            if (list.length() == 1) {
-                                if (false == uavfield->checkValue(f.attribute("values"))) {
-                                    qDebug() << "checkValue returned false on: " << uavObjectName << f.attribute("values");
-                                    setError = true;
-                                } else {
-                                    uavfield->setValue(f.attribute("values"));
-                                }
-                            } else {
-                                // This is an enum:
-                                int i = 0;
-                                QStringList list = f.attribute("values").split(",");
-                                foreach (QString element, list) {
-                                    if (false == uavfield->checkValue(element, i)) {
-                                        qDebug() << "checkValue(list) returned false on: " << uavObjectName << list;
-                                        setError = true;
-                                    } else {
-                            		 uavfield->setValue(element,i);
-                                    }
-                                    i++;
-                                }
-                            }
-                        } else {
-                            error = true;
-                        }
-                    }
-                    field = field.nextSibling();
-                }
-                obj->updated();
-
-                if (error) {
-                    swui.addLine(uavObjectName, "Warning (Object field unknown)", true);
-                } else if (uavObjectID != obj->getObjID()) {
-                    qDebug() << "Mismatch for Object " << uavObjectName << uavObjectID << " - " << obj->getObjID();
-                    swui.addLine(uavObjectName, "Warning (ObjectID mismatch)", true);
-                } else if (setError) {
-                    swui.addLine(uavObjectName, "Warning (Objects field value(s) invalid)", false);
-                } else {
-                    swui.addLine(uavObjectName, "OK", true);
-                }
-            }
-        }
-        node = node.nextSibling();
+    foreach (const UAVSettingsStream::ObjectStatus &s, status) {
+        swui.addLine(s.name, s.text, s.ok);
     }
     qDebug() << "End import";
     swui.exec();
 }
 
-// Create an XML document from UAVObject database
-QString UAVSettingsImportExportFactory::createXMLDocument(const enum storedData what, const bool fullExport)
+// Write an XML document from the UAVObject database
+void UAVSettingsImportExportFactory::writeXMLDocument(QIODevice *device, const enum storedData what, const bool fullExport)
 {
-    // generate an XML first (used for all export formats as a formatted data source)
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
 
+    QXmlStreamWriter xml(device);
+    xml.setAutoFormatting(true);
+    xml.setAutoFormattingIndent(4);
+    xml.writeDTD("<!DOCTYPE UAVObjects>");
+
     // create an XML root
-    QDomDocument doc("UAVObjects");
-    QDomElement root = doc.createElement("uavobjects");
-    doc.appendChild(root);
+    xml.writeStartElement("uavobjects");
 
     // add hardware, firmware and GCS version info
-    QDomElement versionInfo = doc.createElement("version");
-    root.appendChild(versionInfo);
+    xml.writeStartElement("version");
 
     UAVObjectUtilManager *utilMngr = pm->getObject<UAVObjectUtilManager>();
     deviceDescriptorStruct board = utilMngr->getBoardDescriptionStruct();
 
-    QDomElement hw = doc.createElement("hardware");
-    hw.setAttribute("type", QString().setNum(board.boardType, 16));
-    hw.setAttribute("revision", QString().setNum(board.boardRevision, 16));
-    hw.setAttribute("serial", QString(utilMngr->getBoardCPUSerial().toHex()));
-    versionInfo.appendChild(hw);
+    xml.writeEmptyElement("hardware");
+    xml.writeAttribute("type", QString().setNum(board.boardType, 16));
+    xml.writeAttribute("revision", QString().setNum(board.boardRevision, 16));
+    xml.writeAttribute("serial", QString(utilMngr->getBoardCPUSerial().toHex()));
 
-    QDomElement fw = doc.createElement("firmware");
-    fw.setAttribute("date", board.gitDate);
-    fw.setAttribute("hash", board.gitHash);
-    fw.setAttribute("tag", board.gitTag);
-    versionInfo.appendChild(fw);
+    xml.writeEmptyElement("firmware");
+    xml.writeAttribute("date", board.gitDate);
+    xml.writeAttribute("hash", board.gitHash);
+    xml.writeAttribute("tag", board.gitTag);
 
     QString gcsRevision = QString::fromLatin1(Core::Constants::GCS_REVISION_STR);
     QString gcsGitDate = gcsRevision.mid(gcsRevision.indexOf(" ") + 1, 14);
     QString gcsGitHash = gcsRevision.mid(gcsRevision.indexOf(":") + 1, 8);
     QString gcsGitTag = gcsRevision.left(gcsRevision.indexOf(":"));
 
-    QDomElement gcs = doc.createElement("gcs");
-    gcs.setAttribute("date", gcsGitDate);
-    gcs.setAttribute("hash", gcsGitHash);
-    gcs.setAttribute("tag", gcsGitTag);
-    versionInfo.appendChild(gcs);
+    xml.writeEmptyElement("gcs");
+    xml.writeAttribute("date", gcsGitDate);
+    xml.writeAttribute("hash", gcsGitHash);
+    xml.writeAttribute("tag", gcsGitTag);
+
+    xml.writeEndElement();
+
+    // sort the objects into settings and data
+    QList<UAVDataObject*> settings;
+    QList<UAVDataObject*> data;
+    QList< QList<UAVDataObject*> > objList = objManager->getDataObjects();
+    foreach (QList<UAVDataObject*> list, objList) {
+        foreach (UAVDataObject *obj, list) {
+            if (obj->isSettings())
+                settings.append(obj);
+            else
+                data.append(obj);
+        }
+    }
 
     // create settings and/or data elements
-    QDomElement settings = doc.createElement("settings");
-    QDomElement data = doc.createElement("data");
-
-    switch (what)
-    {
-    case Settings:
-        root.appendChild(settings);
-        break;
-    case Data:
-        root.appendChild(data);
-        break;
-    case Both:
-        root.appendChild(data);
-        root.appendChild(settings);
-        break;
+    UAVSettingsStream stream(objManager);
+    if (what == Data || what == Both) {
+        xml.writeStartElement("data");
+        stream.writeObjects(xml, data, fullExport);
+        xml.writeEndElement();
+    }
+    if (what == Settings || what == Both) {
+        xml.writeStartElement("settings");
+        stream.writeObjects(xml, settings, fullExport);
+        xml.writeEndElement();
     }
 
-    // iterate over settings objects
+    xml.writeEndDocument();
+}
+
+// Write a binary snapshot from the UAVObject database
+bool UAVSettingsImportExportFactory::writeSnapshot(QIODevice *device, const enum storedData what)
+{
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+
+    QList<UAVDataObject*> objects;
     QList< QList<UAVDataObject*> > objList = objManager->getDataObjects();
     foreach (QList<UAVDataObject*> list, objList) {
         foreach (UAVDataObject *obj, list) {
             if (((what == Settings) && obj->isSettings()) ||
                 ((what == Data) && !obj->isSettings()) ||
                  (what == Both)) {
-
-                // add each object to the XML
-                QDomElement o = doc.createElement("object");
-                o.setAttribute("name", obj->getName());
-                o.setAttribute("id", QString("0x")+ QString().setNum(obj->getObjID(),16).toUpper());
-                if (fullExport) {
-                    QDomElement d = doc.createElement("description");
-                    QDomText t = doc.createTextNode(obj->getDescription().remove("@Ref ", Qt::CaseInsensitive));
-                    d.appendChild(t);
-                    o.appendChild(d);
-                }
-
-                // iterate over fields
-                QList<UAVObjectField*> fieldList = obj->getFields();
-
-                foreach (UAVObjectField* field, fieldList) {
-                    QDomElement f = doc.createElement("field");
-
-                    // iterate over values
-                    QString vals;
-                    quint32 nelem = field->getNumElements();
-                    for (unsigned int n = 0; n < nelem; ++n) {
-                        vals.append(QString("%1,").arg(field->getValue(n).toString()));
-                    }
-                    vals.chop(1);
-
-                    f.setAttribute("name", field->getName());
-                    f.setAttribute("values", vals);
-                    if (fullExport) {
-                        f.setAttribute("type", field->getTypeAsString());
-                        f.setAttribute("units", field->getUnits());
-                        f.setAttribute("elements", nelem);
-                        if (field->getType() == UAVObjectField::ENUM) {
-                            f.setAttribute("options", field->getOptions().join(","));
-                        }
-                    }
-                    o.appendChild(f);
-                }
-
-                // append to the settings or data element
-                if (obj->isSettings())
-                    settings.appendChild(o);
-                else
-                    data.appendChild(o);
+                objects.append(obj);
             }
         }
     }
 
-    return doc.toString(4);
+    UAVSettingsStream stream(objManager);
+    return UAVSettingsStream::writeSnapshot(device, stream.capture(objects));
+}
+
+// Save the UAVObject database to a file, the format is chosen by the file name
+bool UAVSettingsImportExportFactory::exportToFile(QString fileName, const enum storedData what)
+{
+    // If the filename ends with .xml, we will do a full export, otherwise, a simple export
+    bool fullExport = false;
+    if (fileName.endsWith(".xml")) {
+        fullExport = true;
+    } else if (!fileName.endsWith(".uav") && !UAVSettingsStream::isSnapshotFile(fileName)) {
+        fileName.append(".uav");
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    bool ok = true;
+    if (UAVSettingsStream::isSnapshotFile(fileName))
+        ok = writeSnapshot(&file, what);
+    else
+        writeXMLDocument(&file, what, fullExport);
+    file.close();
+    return ok && (file.error() == QFile::NoError);
 }
 
 // Slot called by the menu manager on user action
@@ -336,30 +272,15 @@ void UAVSettingsImportExportFactory::exportUAVSettings()
 {
     // ask for file name
     QString fileName;
-    QString filters = tr("UAVObjects XML files (*.uav)");
+    QString filters = tr("UAVObjects XML files (*.uav);; UAVObjects binary snapshots (*.uavb)");
 
     fileName = QFileDialog::getSaveFileName(0, tr("Save UAVSettings File As"), "", filters);
     if (fileName.isEmpty()) {
         return;
     }
 
-    // If the filename ends with .xml, we will do a full export, otherwise, a simple export
-    bool fullExport = false;
-    if (fileName.endsWith(".xml")) {
-        fullExport = true;
-    } else if (!fileName.endsWith(".uav")) {
-        fileName.append(".uav");
-    }
-
-    // generate an XML first (used for all export formats as a formatted data source)
-    QString xml = createXMLDocument(Settings, fullExport);
-
     // save file
-    QFile file(fileName);
-    if (file.open(QIODevice::WriteOnly) &&
-            (file.write(xml.toAscii()) != -1)) {
-        file.close();
-    } else {
+    if (!exportToFile(fileName, Settings)) {
         QMessageBox::critical(0,
                               tr("UAV Settings Export"),
                               tr("Unable to save settings: ") + fileName,
@@ -387,30 +308,15 @@ void UAVSettingsImportExportFactory::exportUAVData()
 
     // ask for file name
     QString fileName;
-    QString filters = tr("UAVObjects XML files (*.uav)");
+    QString filters = tr("UAVObjects XML files (*.uav);; UAVObjects binary snapshots (*.uavb)");
 
     fileName = QFileDialog::getSaveFileName(0, tr("Save UAVData File As"), "", filters);
     if (fileName.isEmpty()) {
         return;
     }
 
-    // If the filename ends with .xml, we will do a full export, otherwise, a simple export
-    bool fullExport = false;
-    if (fileName.endsWith(".xml")) {
-        fullExport = true;
-    } else if (!fileName.endsWith(".uav")) {
-        fileName.append(".uav");
-    }
-
-    // generate an XML first (used for all export formats as a formatted data source)
-    QString xml = createXMLDocument(Both, fullExport);
-
     // save file
-    QFile file(fileName);
-    if (file.open(QIODevice::WriteOnly) &&
-            (file.write(xml.toAscii()) != -1)) {
-        file.close();
-    } else {
+    if (!exportToFile(fileName, Both)) {
         QMessageBox::critical(0,
                               tr("UAV Data Export"),
                               tr("Unable to save data: ") + fileName,
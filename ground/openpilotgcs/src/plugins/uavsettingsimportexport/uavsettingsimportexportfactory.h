@@ -39,7 +39,9 @@ public:
 
 private:
    enum storedData { Settings, Data, Both };
-   QString createXMLDocument(const enum storedData, const bool fullExport);
+   void writeXMLDocument(QIODevice *device, const enum storedData, const bool fullExport);
+   bool writeSnapshot(QIODevice *device, const enum storedData);
+   bool exportToFile(QString fileName, const enum storedData);
 
 private slots:
    void importUAVSettings();
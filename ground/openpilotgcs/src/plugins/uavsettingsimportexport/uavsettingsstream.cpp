@@ -0,0 +1,330 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavsettingsstream.cpp
+ * @author     (C) 2012 The OpenPilot Team, http://www.openpilot.org
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVSettingsImportExport UAVSettings Import/Export Plugin
+ * @{
+ * @brief Streaming reader and writer for UAVSettings files
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "uavsettingsstream.h"
+#include "uavobjectfield.h"
+#include <QDataStream>
+#include <QFile>
+#include <QStringList>
+#include <QDebug>
+
+// Binary snapshot header, "UAVS" and the format version
+#define SNAPSHOT_MAGIC 0x55415653
+#define SNAPSHOT_VERSION 2
+
+static void addStatus(QList<UAVSettingsStream::ObjectStatus>* status, const QString& name, const QString& text, bool ok)
+{
+    if (status == NULL)
+        return;
+    UAVSettingsStream::ObjectStatus s;
+    s.name = name;
+    s.text = text;
+    s.ok = ok;
+    status->append(s);
+}
+
+UAVSettingsStream::UAVSettingsStream(UAVObjectManager* objManager)
+{
+    this->objManager = objManager;
+}
+
+bool UAVSettingsStream::isSnapshotFile(const QString& fileName)
+{
+    return fileName.endsWith(".uavb", Qt::CaseInsensitive);
+}
+
+QList<UAVDataObject*> UAVSettingsStream::getSettingsObjects()
+{
+    QList<UAVDataObject*> objects;
+    QList< QList<UAVDataObject*> > objList = objManager->getDataObjects();
+    foreach (QList<UAVDataObject*> list, objList) {
+        foreach (UAVDataObject* obj, list) {
+            if (obj->isSettings())
+                objects.append(obj);
+        }
+    }
+    return objects;
+}
+
+/**
+ * Import a settings file of either format. If the file can not be read, or
+ * a snapshot entry can not be applied, all settings objects are restored to
+ * their state before the import.
+ */
+bool UAVSettingsStream::importFile(const QString& fileName, QList<ObjectStatus>& status, QList<UAVDataObject*>& imported, QString* errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    if (isSnapshotFile(fileName)) {
+        Snapshot snapshot;
+        if (!readSnapshot(&file, snapshot, errorString))
+            return false;
+        return importSnapshot(snapshot, status, imported, errorString);
+    }
+
+    Snapshot previous = capture(getSettingsObjects());
+    if (!readXml(&file, status, imported, errorString)) {
+        applySnapshot(previous, NULL, NULL);
+        status.clear();
+        imported.clear();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Apply a snapshot to the objects, all or nothing. If any entry is unknown
+ * or does not match the size of its object the previous state is restored.
+ */
+bool UAVSettingsStream::importSnapshot(const Snapshot& snapshot, QList<ObjectStatus>& status, QList<UAVDataObject*>& imported, QString* errorString)
+{
+    Snapshot previous = capture(getSettingsObjects());
+    int first = status.length();
+    applySnapshot(snapshot, &status, &imported);
+    for (int n = first; n < status.length(); ++n) {
+        if (!status[n].ok) {
+            *errorString = status[n].name + ": " + status[n].text;
+            applySnapshot(previous, NULL, NULL);
+            status.clear();
+            imported.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Apply the settings subtree of an XML file to the objects
+ */
+bool UAVSettingsStream::readXml(QIODevice* device, QList<ObjectStatus>& status, QList<UAVDataObject*>& imported, QString* errorString)
+{
+    QXmlStreamReader xml(device);
+    bool found = false;
+
+    while (!xml.atEnd()) {
+        if (xml.readNext() != QXmlStreamReader::StartElement)
+            continue;
+        if (xml.name() == "uavobjects") {
+            // Descend into the document root
+            continue;
+        }
+        if (xml.name() == "settings") {
+            found = true;
+            while (xml.readNextStartElement()) {
+                if (xml.name() == "object")
+                    readObject(xml, status, imported);
+                else
+                    xml.skipCurrentElement();
+            }
+        } else {
+            xml.skipCurrentElement();
+        }
+    }
+
+    if (xml.hasError()) {
+        *errorString = xml.errorString();
+        return false;
+    }
+    if (!found) {
+        *errorString = QObject::tr("This file does not contain correct UAVSettings");
+        return false;
+    }
+    return true;
+}
+
+void UAVSettingsStream::readObject(QXmlStreamReader& xml, QList<ObjectStatus>& status, QList<UAVDataObject*>& imported)
+{
+    QXmlStreamAttributes attributes = xml.attributes();
+    QString uavObjectName = attributes.value("name").toString();
+    uint uavObjectID = attributes.value("id").toString().toUInt(NULL, 16);
+
+    // Look the object up by ID, the name is only used if the ID is not known
+    UAVDataObject* obj = dynamic_cast<UAVDataObject*>(objManager->getObject(uavObjectID));
+    if (obj == NULL)
+        obj = dynamic_cast<UAVDataObject*>(objManager->getObject(uavObjectName));
+    if (obj == NULL) {
+        // This object is unknown!
+        qDebug() << "Object unknown:" << uavObjectName << uavObjectID;
+        addStatus(&status, uavObjectName, "Error (Object unknown)", false);
+        xml.skipCurrentElement();
+        return;
+    }
+
+    //  - Update each field
+    bool error = false;
+    bool setError = false;
+    while (xml.readNextStartElement()) {
+        if (xml.name() != "field") {
+            xml.skipCurrentElement();
+            continue;
+        }
+        QXmlStreamAttributes f = xml.attributes();
+        UAVObjectField* uavfield = obj->getField(f.value("name").toString());
+        if (uavfield) {
+            QStringList list = f.value("values").toString().split(",");
+            for (int i = 0; i < list.length(); ++i) {
+                if (false == uavfield->checkValue(list[i], i)) {
+                    qDebug() << "checkValue returned false on: " << uavObjectName << list[i];
+                    setError = true;
+                } else {
+                    uavfield->setValue(list[i], i);
+                }
+            }
+        } else {
+            error = true;
+        }
+        xml.skipCurrentElement();
+    }
+    imported.append(obj);
+
+    if (error) {
+        addStatus(&status, uavObjectName, "Warning (Object field unknown)", true);
+    } else if (uavObjectID != obj->getObjID()) {
+        qDebug() << "Mismatch for Object " << uavObjectName << uavObjectID << " - " << obj->getObjID();
+        addStatus(&status, uavObjectName, "Warning (ObjectID mismatch)", true);
+    } else if (setError) {
+        addStatus(&status, uavObjectName, "Warning (Objects field value(s) invalid)", false);
+    } else {
+        addStatus(&status, uavObjectName, "OK", true);
+    }
+}
+
+/**
+ * Unpack the data of a snapshot into the settings objects, entries of data
+ * objects are skipped so that importing a data snapshot never sends them
+ * to the board
+ */
+void UAVSettingsStream::applySnapshot(const Snapshot& snapshot, QList<ObjectStatus>* status, QList<UAVDataObject*>* imported)
+{
+    Snapshot::const_iterator it;
+    for (it = snapshot.constBegin(); it != snapshot.constEnd(); ++it) {
+        quint32 objId = snapshotObjId(it.key());
+        quint32 instId = snapshotInstId(it.key());
+        UAVDataObject* obj = dynamic_cast<UAVDataObject*>(objManager->getObject(objId, instId));
+        if (obj == NULL) {
+            QString name = QString("0x") + QString().setNum(objId, 16).toUpper();
+            if (instId != 0)
+                name += QString(" [%1]").arg(instId);
+            qDebug() << "Object unknown:" << name;
+            addStatus(status, name, "Error (Object unknown)", false);
+        } else if (!obj->isSettings()) {
+            addStatus(status, obj->getName(), "Warning (Not a settings object, skipped)", true);
+        } else if ((quint32)it.value().size() != obj->getNumBytes()) {
+            addStatus(status, obj->getName(), "Error (Object size mismatch)", false);
+        } else {
+            obj->unpack((const quint8*)it.value().constData());
+            if (imported)
+                imported->append(obj);
+            addStatus(status, obj->getName(), "OK", true);
+        }
+    }
+}
+
+/**
+ * Write an object element for each object
+ */
+void UAVSettingsStream::writeObjects(QXmlStreamWriter& xml, const QList<UAVDataObject*>& objects, bool fullExport)
+{
+    foreach (UAVDataObject* obj, objects) {
+        xml.writeStartElement("object");
+        xml.writeAttribute("name", obj->getName());
+        xml.writeAttribute("id", QString("0x") + QString().setNum(obj->getObjID(), 16).toUpper());
+        if (fullExport)
+            xml.writeTextElement("description", obj->getDescription().remove("@Ref ", Qt::CaseInsensitive));
+
+        foreach (UAVObjectField* field, obj->getFields()) {
+            // iterate over values
+            QString vals;
+            quint32 nelem = field->getNumElements();
+            for (unsigned int n = 0; n < nelem; ++n) {
+                vals.append(field->getValue(n).toString());
+                vals.append(',');
+            }
+            vals.chop(1);
+
+            xml.writeEmptyElement("field");
+            xml.writeAttribute("name", field->getName());
+            xml.writeAttribute("values", vals);
+            if (fullExport) {
+                xml.writeAttribute("type", field->getTypeAsString());
+                xml.writeAttribute("units", field->getUnits());
+                xml.writeAttribute("elements", QString::number(nelem));
+                if (field->getType() == UAVObjectField::ENUM)
+                    xml.writeAttribute("options", field->getOptions().join(","));
+            }
+        }
+        xml.writeEndElement();
+    }
+}
+
+/**
+ * Pack each object instance into a snapshot
+ */
+UAVSettingsStream::Snapshot UAVSettingsStream::capture(const QList<UAVDataObject*>& objects)
+{
+    Snapshot snapshot;
+    foreach (UAVDataObject* obj, objects) {
+        QByteArray data(obj->getNumBytes(), 0);
+        obj->pack((quint8*)data.data());
+        snapshot.insert(snapshotKey(obj->getObjID(), obj->getInstID()), data);
+    }
+    return snapshot;
+}
+
+bool UAVSettingsStream::readSnapshot(QIODevice* device, Snapshot& snapshot, QString* errorString)
+{
+    QDataStream in(device);
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 magic, version;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != SNAPSHOT_MAGIC) {
+        *errorString = QObject::tr("This file is not a UAVSettings snapshot");
+        return false;
+    }
+    if (version != SNAPSHOT_VERSION) {
+        *errorString = QObject::tr("Unsupported UAVSettings snapshot version %1").arg(version);
+        return false;
+    }
+    in >> snapshot;
+    if (in.status() != QDataStream::Ok) {
+        *errorString = QObject::tr("The UAVSettings snapshot is truncated");
+        return false;
+    }
+    return true;
+}
+
+bool UAVSettingsStream::writeSnapshot(QIODevice* device, const Snapshot& snapshot)
+{
+    QDataStream out(device);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint32)SNAPSHOT_MAGIC << (quint32)SNAPSHOT_VERSION << snapshot;
+    return out.status() == QDataStream::Ok;
+}
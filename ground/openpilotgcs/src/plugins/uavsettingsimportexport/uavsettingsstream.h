@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavsettingsstream.h
+ * @author     (C) 2012 The OpenPilot Team, http://www.openpilot.org
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVSettingsImportExport UAVSettings Import/Export Plugin
+ * @{
+ * @brief Streaming reader and writer for UAVSettings files
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef UAVSETTINGSSTREAM_H
+#define UAVSETTINGSSTREAM_H
+#include "uavsettingsimportexport_global.h"
+#include "uavdataobject.h"
+#include "uavobjectmanager.h"
+#include <QIODevice>
+#include <QMap>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+/**
+ * Reads and writes UAVSettings files without building a document in memory.
+ *
+ * Two formats are supported: the XML format of the import/export menu
+ * entries (.uav/.xml) and a binary snapshot (.uavb) holding the packed data
+ * of each object instance keyed by its object and instance ID, see
+ * snapshotKey(). The object ID is a hash of the
+ * object definition, so a snapshot can only be applied to objects with an
+ * identical layout. This class does not depend on the GUI and is shared with
+ * the uavsettingstool batch tool.
+ */
+class UAVSETTINGSIMPORTEXPORT_EXPORT UAVSettingsStream
+{
+public:
+    typedef struct {
+        QString name;
+        QString text;
+        bool ok;
+    } ObjectStatus;
+
+    typedef QMap<quint64, QByteArray> Snapshot;
+
+    static quint64 snapshotKey(quint32 objId, quint32 instId) { return ((quint64)objId << 32) | instId; }
+    static quint32 snapshotObjId(quint64 key) { return (quint32)(key >> 32); }
+    static quint32 snapshotInstId(quint64 key) { return (quint32)key; }
+
+    UAVSettingsStream(UAVObjectManager* objManager);
+
+    static bool isSnapshotFile(const QString& fileName);
+
+    QList<UAVDataObject*> getSettingsObjects();
+
+    // Import, the imported objects are not marked as updated
+    bool importFile(const QString& fileName, QList<ObjectStatus>& status, QList<UAVDataObject*>& imported, QString* errorString);
+    bool importSnapshot(const Snapshot& snapshot, QList<ObjectStatus>& status, QList<UAVDataObject*>& imported, QString* errorString);
+    bool readXml(QIODevice* device, QList<ObjectStatus>& status, QList<UAVDataObject*>& imported, QString* errorString);
+    void applySnapshot(const Snapshot& snapshot, QList<ObjectStatus>* status, QList<UAVDataObject*>* imported);
+
+    // Export
+    void writeObjects(QXmlStreamWriter& xml, const QList<UAVDataObject*>& objects, bool fullExport);
+    Snapshot capture(const QList<UAVDataObject*>& objects);
+
+    static bool readSnapshot(QIODevice* device, Snapshot& snapshot, QString* errorString);
+    static bool writeSnapshot(QIODevice* device, const Snapshot& snapshot);
+
+private:
+    UAVObjectManager* objManager;
+
+    void readObject(QXmlStreamReader& xml, QList<ObjectStatus>& status, QList<UAVDataObject*>& imported);
+};
+
+#endif // UAVSETTINGSSTREAM_H
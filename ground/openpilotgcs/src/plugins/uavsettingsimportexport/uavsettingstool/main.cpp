@@ -0,0 +1,221 @@
+/**
+ ******************************************************************************
+ *
+ * @file       main.cpp
+ * @author     (C) 2012 The OpenPilot Team, http://www.openpilot.org
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVSettingsImportExport UAVSettings Import/Export Plugin
+ * @{
+ * @brief Headless tool to convert, diff and validate UAVSettings files
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include <QtCore/QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTextStream>
+#include "uavobjectsinit.h"
+#include "uavobjectfield.h"
+#include "uavsettingsstream.h"
+
+#define RETURN_OK 0
+#define RETURN_ERR_USAGE 1
+#define RETURN_ERR_FILE 2
+#define RETURN_DIFFERENT 3
+
+static QTextStream out(stdout);
+static QTextStream err(stderr);
+
+static void usage()
+{
+    err << "Usage: uavsettingstool convert <uav|xml|uavb> <output dir> <file>..." << endl;
+    err << "       uavsettingstool diff <file> <file>" << endl;
+    err << "       uavsettingstool validate <file>..." << endl;
+    err << endl;
+    err << "Files ending in .uavb are binary snapshots, all others are XML." << endl;
+    err << "Every file is applied on top of the default settings." << endl;
+}
+
+/**
+ * Reset the settings to their defaults and import a file on top of them
+ */
+static bool load(UAVSettingsStream& stream, const UAVSettingsStream::Snapshot& defaults, const QString& fileName,
+                 QList<UAVSettingsStream::ObjectStatus>& status, QList<UAVDataObject*>& imported)
+{
+    QString errorString;
+    stream.applySnapshot(defaults, NULL, NULL);
+    if (!stream.importFile(fileName, status, imported, &errorString)) {
+        err << fileName << ": " << errorString << endl;
+        return false;
+    }
+    return true;
+}
+
+static int convert(UAVSettingsStream& stream, const UAVSettingsStream::Snapshot& defaults, const QStringList& args)
+{
+    if (args.length() < 3 || !(QStringList() << "uav" << "xml" << "uavb").contains(args[0]))
+        return RETURN_ERR_USAGE;
+    QString format = args[0];
+    QDir outputDir(args[1]);
+    int ret = RETURN_OK;
+
+    for (int n = 2; n < args.length(); ++n) {
+        QList<UAVSettingsStream::ObjectStatus> status;
+        QList<UAVDataObject*> imported;
+        if (!load(stream, defaults, args[n], status, imported)) {
+            ret = RETURN_ERR_FILE;
+            continue;
+        }
+
+        QFile file(outputDir.filePath(QFileInfo(args[n]).completeBaseName() + "." + format));
+        if (!file.open(QFile::WriteOnly)) {
+            err << file.fileName() << ": " << file.errorString() << endl;
+            ret = RETURN_ERR_FILE;
+            continue;
+        }
+        if (format == "uavb") {
+            UAVSettingsStream::writeSnapshot(&file, stream.capture(imported));
+        } else {
+            QXmlStreamWriter xml(&file);
+            xml.setAutoFormatting(true);
+            xml.setAutoFormattingIndent(4);
+            xml.writeDTD("<!DOCTYPE UAVObjects>");
+            xml.writeStartElement("uavobjects");
+            xml.writeStartElement("settings");
+            stream.writeObjects(xml, imported, format == "xml");
+            xml.writeEndDocument();
+        }
+        file.close();
+        if (file.error() != QFile::NoError) {
+            err << file.fileName() << ": " << file.errorString() << endl;
+            ret = RETURN_ERR_FILE;
+        }
+    }
+    return ret;
+}
+
+static QStringList fieldValues(UAVObjectField* field)
+{
+    QStringList values;
+    for (quint32 n = 0; n < field->getNumElements(); ++n)
+        values.append(field->getValue(n).toString());
+    return values;
+}
+
+static int diff(UAVSettingsStream& stream, const UAVSettingsStream::Snapshot& defaults, UAVObjectManager* objManager, const QStringList& args)
+{
+    if (args.length() != 2)
+        return RETURN_ERR_USAGE;
+
+    // Capture both files as complete settings sets
+    UAVSettingsStream::Snapshot snapshots[2];
+    for (int n = 0; n < 2; ++n) {
+        QList<UAVSettingsStream::ObjectStatus> status;
+        QList<UAVDataObject*> imported;
+        if (!load(stream, defaults, args[n], status, imported))
+            return RETURN_ERR_FILE;
+        snapshots[n] = stream.capture(stream.getSettingsObjects());
+    }
+
+    // Only objects whose packed data differs are compared field by field
+    int ret = RETURN_OK;
+    UAVSettingsStream::Snapshot::const_iterator it;
+    for (it = snapshots[0].constBegin(); it != snapshots[0].constEnd(); ++it) {
+        const QByteArray& other = snapshots[1][it.key()];
+        if (it.value() == other)
+            continue;
+        ret = RETURN_DIFFERENT;
+        UAVObject* obj = objManager->getObject(UAVSettingsStream::snapshotObjId(it.key()),
+                                               UAVSettingsStream::snapshotInstId(it.key()));
+        QList<QStringList> values[2];
+        obj->unpack((const quint8*)it.value().constData());
+        foreach (UAVObjectField* field, obj->getFields())
+            values[0].append(fieldValues(field));
+        obj->unpack((const quint8*)other.constData());
+        foreach (UAVObjectField* field, obj->getFields())
+            values[1].append(fieldValues(field));
+        for (int f = 0; f < values[0].length(); ++f) {
+            UAVObjectField* field = obj->getFields().at(f);
+            const QStringList& a = values[0][f];
+            const QStringList& b = values[1][f];
+            for (int n = 0; n < a.length(); ++n) {
+                if (a[n] != b[n]) {
+                    out << obj->getName() << "." << field->getName();
+                    if (a.length() > 1)
+                        out << "[" << field->getElementNames().at(n) << "]";
+                    out << ": " << a[n] << " -> " << b[n] << endl;
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+static int validate(UAVSettingsStream& stream, const UAVSettingsStream::Snapshot& defaults, const QStringList& args)
+{
+    if (args.isEmpty())
+        return RETURN_ERR_USAGE;
+
+    int ret = RETURN_OK;
+    int invalid = 0;
+    foreach (QString fileName, args) {
+        QList<UAVSettingsStream::ObjectStatus> status;
+        QList<UAVDataObject*> imported;
+        bool ok = load(stream, defaults, fileName, status, imported);
+        foreach (const UAVSettingsStream::ObjectStatus& s, status) {
+            if (s.text != "OK")
+                out << fileName << ": " << s.name << ": " << s.text << endl;
+            ok &= s.ok;
+        }
+        if (!ok) {
+            ++invalid;
+            ret = RETURN_ERR_FILE;
+        }
+    }
+    out << args.length() - invalid << " of " << args.length() << " files valid" << endl;
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QStringList args = QCoreApplication::arguments().mid(1);
+    if (args.isEmpty()) {
+        usage();
+        return RETURN_ERR_USAGE;
+    }
+    QString command = args.takeFirst();
+
+    UAVObjectManager* objManager = new UAVObjectManager();
+    UAVObjectsInitialize(objManager);
+    UAVSettingsStream stream(objManager);
+    UAVSettingsStream::Snapshot defaults = stream.capture(stream.getSettingsObjects());
+
+    int ret = RETURN_ERR_USAGE;
+    if (command == "convert")
+        ret = convert(stream, defaults, args);
+    else if (command == "diff")
+        ret = diff(stream, defaults, objManager, args);
+    else if (command == "validate")
+        ret = validate(stream, defaults, args);
+
+    if (ret == RETURN_ERR_USAGE)
+        usage();
+    return ret;
+}
@@ -0,0 +1,16 @@
+# Headless tool to convert, diff and validate UAVSettings files in bulk.
+# Build it from the GCS build tree after the UAVObjects plugin, it links
+# against the plugin library and shares the UAVSettingsStream sources.
+QT -= gui
+TARGET = uavsettingstool
+CONFIG += console
+CONFIG -= app_bundle
+TEMPLATE = app
+include(../../../../openpilotgcs.pri)
+include(../../uavobjects/uavobjects.pri)
+LIBS += -L$$GCS_PLUGIN_PATH/OpenPilot -L$$GCS_LIBRARY_PATH
+DEFINES += UAVSETTINGSIMPORTEXPORT_LIBRARY
+INCLUDEPATH += .. $$GCS_SOURCE_TREE/src/plugins
+SOURCES += main.cpp \
+    ../uavsettingsstream.cpp
+HEADERS += ../uavsettingsstream.h
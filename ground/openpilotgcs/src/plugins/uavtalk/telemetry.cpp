@@ -322,6 +322,19 @@ void Telemetry::processObjectUpdates(UAVObject* obj, EventMask event, bool allIn
     objInfo.allInstances = allInstances;
     if (priority)
     {
+        // An unacked update that is still queued sends the latest data
+        // anyway, so high rate inputs like the joystick do not pile up
+        if ( event == EV_UPDATED && !UAVObject::GetGcsTelemetryAcked(obj->getMetadata()) )
+        {
+            foreach (const ObjectQueueInfo& queued, objPriorityQueue)
+            {
+                if ( queued.obj == obj && queued.event == event && queued.allInstances == allInstances )
+                {
+                    processObjectQueue();
+                    return;
+                }
+            }
+        }
         if ( objPriorityQueue.length() < MAX_QUEUE_SIZE )
         {
             objPriorityQueue.enqueue(objInfo);
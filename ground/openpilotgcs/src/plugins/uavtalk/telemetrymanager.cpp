@@ -29,8 +29,10 @@
 #include <extensionsystem/pluginmanager.h>
 #include <coreplugin/icore.h>
 #include <coreplugin/threadmanager.h>
+#include <coreplugin/generalsettings.h>
 
 TelemetryManager::TelemetryManager() :
+    relay(NULL),
     autopilotConnected(false)
 {
     moveToThread(Core::ICore::instance()->threadManager()->getRealTimeThread());
@@ -60,7 +62,20 @@ void TelemetryManager::start(QIODevice *dev)
 
 void TelemetryManager::onStart()
 {
+    // The relay is created on the telemetry thread and kept across
+    // connections so its clients stay connected, it is dropped once the
+    // option is turned off
+    ExtensionSystem::PluginManager* pm = ExtensionSystem::PluginManager::instance();
+    Core::Internal::GeneralSettings* settings = pm->getObject<Core::Internal::GeneralSettings>();
+    bool useRelay = settings && settings->useUDPMirror();
+    if (useRelay && !relay) {
+        relay = new TelemetryRelay(TelemetryRelay::DEFAULT_PORT, this);
+    } else if (!useRelay && relay) {
+        delete relay;
+        relay = NULL;
+    }
     utalk = new UAVTalk(device, objMngr);
+    utalk->setRelay(relay);
     telemetry = new Telemetry(utalk, objMngr);
     telemetryMon = new TelemetryMonitor(objMngr, telemetry);
     connect(telemetryMon, SIGNAL(connected()), this, SLOT(onConnect()));
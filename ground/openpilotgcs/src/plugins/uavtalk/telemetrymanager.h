@@ -32,6 +32,7 @@
 #include "telemetrymonitor.h"
 #include "telemetry.h"
 #include "uavtalk.h"
+#include "telemetryrelay.h"
 #include "uavobjectmanager.h"
 #include <QIODevice>
 #include <QObject>
@@ -65,6 +66,7 @@ private:
     UAVTalk* utalk;
     Telemetry* telemetry;
     TelemetryMonitor* telemetryMon;
+    TelemetryRelay* relay;
     QIODevice *device;
     bool autopilotConnected;
 };
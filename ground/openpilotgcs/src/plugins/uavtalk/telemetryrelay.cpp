@@ -0,0 +1,295 @@
+/**
+ ******************************************************************************
+ *
+ * @file       telemetryrelay.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVTalkPlugin UAVTalk Plugin
+ * @{
+ * @brief Relays the telemetry link to local clients
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "telemetryrelay.h"
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QtNetwork/QLocalServer>
+#include <QtNetwork/QLocalSocket>
+#include <QtNetwork/QUdpSocket>
+#include <QDebug>
+
+const char *TelemetryRelay::LOCAL_SERVER_NAME = "OpenPilotGCS.telemetry";
+
+TelemetryRelayClient::TelemetryRelayClient(QIODevice *device, QObject *parent) :
+    QObject(parent),
+    device(device),
+    udpSocket(NULL),
+    port(0),
+    dropped(0),
+    seen(0)
+{
+    device->setParent(this);
+    connect(device, SIGNAL(readyRead()), this, SLOT(readCommands()));
+    connect(device, SIGNAL(bytesWritten(qint64)), this, SLOT(flush()));
+    // QTcpSocket and QLocalSocket both have a disconnected() signal
+    connect(device, SIGNAL(disconnected()), this, SIGNAL(disconnected()));
+}
+
+TelemetryRelayClient::TelemetryRelayClient(QUdpSocket *socket, const QHostAddress &address, quint16 port, QObject *parent) :
+    QObject(parent),
+    device(NULL),
+    udpSocket(socket),
+    address(address),
+    port(port),
+    dropped(0),
+    seen(0)
+{
+}
+
+bool TelemetryRelayClient::isSubscribed(quint32 objId) const
+{
+    return minInterval.contains(objId) || minInterval.contains(ALL_OBJECTS);
+}
+
+bool TelemetryRelayClient::subscribesAll() const
+{
+    return minInterval.contains(ALL_OBJECTS);
+}
+
+QList<quint32> TelemetryRelayClient::subscriptions() const
+{
+    return minInterval.keys();
+}
+
+int TelemetryRelayClient::lastSeen() const
+{
+    return seen;
+}
+
+void TelemetryRelayClient::setLastSeen(int time)
+{
+    seen = time;
+}
+
+/**
+ * Queue a packet unless the object was sent too recently for its rate
+ */
+void TelemetryRelayClient::relayFrame(quint32 objId, const QByteArray &frame, int time)
+{
+    int interval = minInterval.value(objId, minInterval.value(ALL_OBJECTS, -1));
+    if (interval < 0)
+        return;
+    if (interval > 0) {
+        QHash<quint32, int>::iterator last = lastSent.find(objId);
+        // The clock wraps after a day, a negative difference is not too recent
+        if (last != lastSent.end() && time - last.value() >= 0 && time - last.value() < interval)
+            return;
+        lastSent.insert(objId, time);
+    }
+
+    if (queue.length() >= QUEUE_LENGTH) {
+        queue.dequeue();
+        if ((++dropped % QUEUE_LENGTH) == 1)
+            qDebug() << "TelemetryRelay: client too slow," << dropped << "packets dropped";
+    }
+    queue.enqueue(frame);
+    flush();
+}
+
+/**
+ * Hand queued packets to the socket while its write buffer is not full
+ */
+void TelemetryRelayClient::flush()
+{
+    if (udpSocket) {
+        while (!queue.isEmpty())
+            udpSocket->writeDatagram(queue.dequeue(), address, port);
+        return;
+    }
+    while (!queue.isEmpty() && device->bytesToWrite() < WRITE_BUFFER_SIZE)
+        device->write(queue.dequeue());
+}
+
+void TelemetryRelayClient::readCommands()
+{
+    while (device->canReadLine())
+        processCommand(device->readLine());
+}
+
+void TelemetryRelayClient::processCommands(const QByteArray &commands)
+{
+    foreach (QByteArray line, commands.split('\n'))
+        processCommand(line);
+}
+
+void TelemetryRelayClient::processCommand(const QByteArray &line)
+{
+    QList<QByteArray> args = line.simplified().split(' ');
+    if (args.length() < 2)
+        return;
+
+    quint32 objId = ALL_OBJECTS;
+    bool ok = true;
+    if (args[1] != "*")
+        objId = args[1].toUInt(&ok, 0);
+    if (!ok || (objId == ALL_OBJECTS && args[1] != "*")) {
+        qDebug() << "TelemetryRelay: invalid object id" << args[1];
+        return;
+    }
+
+    if (args[0] == "SUBSCRIBE") {
+        double rate = (args.length() > 2) ? args[2].toDouble() : 0;
+        minInterval.insert(objId, (rate > 0) ? (int)(1000 / rate) : 0);
+    } else if (args[0] == "UNSUBSCRIBE") {
+        if (objId == ALL_OBJECTS)
+            minInterval.clear();
+        else
+            minInterval.remove(objId);
+        lastSent.remove(objId);
+    } else {
+        qDebug() << "TelemetryRelay: unknown command" << args[0];
+        return;
+    }
+    emit subscriptionsChanged();
+}
+
+TelemetryRelay::TelemetryRelay(quint16 port, QObject *parent) :
+    QObject(parent),
+    subscribedAll(false)
+{
+    clock.start();
+
+    tcpServer = new QTcpServer(this);
+    connect(tcpServer, SIGNAL(newConnection()), this, SLOT(newTcpConnection()));
+    if (!tcpServer->listen(QHostAddress::LocalHost, port))
+        qDebug() << "TelemetryRelay: TCP port" << port << tcpServer->errorString();
+
+    localServer = new QLocalServer(this);
+    connect(localServer, SIGNAL(newConnection()), this, SLOT(newLocalConnection()));
+    // Remove a socket file left over by a crashed instance
+    QLocalServer::removeServer(LOCAL_SERVER_NAME);
+    if (!localServer->listen(LOCAL_SERVER_NAME))
+        qDebug() << "TelemetryRelay: local socket" << LOCAL_SERVER_NAME << localServer->errorString();
+
+    udpSocket = new QUdpSocket(this);
+    connect(udpSocket, SIGNAL(readyRead()), this, SLOT(readDatagrams()));
+    if (!udpSocket->bind(QHostAddress::LocalHost, port))
+        qDebug() << "TelemetryRelay: UDP port" << port << udpSocket->errorString();
+
+    expireTimer.setInterval(DATAGRAM_CLIENT_TIMEOUT / 2);
+    connect(&expireTimer, SIGNAL(timeout()), this, SLOT(expireDatagramClients()));
+    expireTimer.start();
+}
+
+TelemetryRelay::~TelemetryRelay()
+{
+}
+
+/**
+ * Called by UAVTalk for each packet received or sent
+ */
+void TelemetryRelay::relayFrame(quint32 objId, const QByteArray &frame)
+{
+    int time = clock.elapsed();
+    foreach (TelemetryRelayClient *client, clients)
+        client->relayFrame(objId, frame, time);
+}
+
+void TelemetryRelay::addClient(TelemetryRelayClient *client)
+{
+    clients.append(client);
+    connect(client, SIGNAL(subscriptionsChanged()), this, SLOT(updateSubscriptions()));
+    connect(client, SIGNAL(disconnected()), this, SLOT(clientDisconnected()));
+}
+
+void TelemetryRelay::newTcpConnection()
+{
+    while (tcpServer->hasPendingConnections())
+        addClient(new TelemetryRelayClient(tcpServer->nextPendingConnection(), this));
+}
+
+void TelemetryRelay::newLocalConnection()
+{
+    while (localServer->hasPendingConnections())
+        addClient(new TelemetryRelayClient(localServer->nextPendingConnection(), this));
+}
+
+/**
+ * Datagrams carry the commands of UDP clients, the sender address and port
+ * identify the client. Every datagram, even an empty one, keeps it alive.
+ */
+void TelemetryRelay::readDatagrams()
+{
+    QByteArray datagram;
+    QHostAddress address;
+    quint16 port;
+    while (udpSocket->hasPendingDatagrams()) {
+        datagram.resize(udpSocket->pendingDatagramSize());
+        udpSocket->readDatagram(datagram.data(), datagram.size(), &address, &port);
+
+        QString key = address.toString() + ":" + QString::number(port);
+        TelemetryRelayClient *client = datagramClients.value(key);
+        if (!client) {
+            client = new TelemetryRelayClient(udpSocket, address, port, this);
+            datagramClients.insert(key, client);
+            addClient(client);
+        }
+        client->setLastSeen(clock.elapsed());
+        client->processCommands(datagram);
+    }
+}
+
+void TelemetryRelay::expireDatagramClients()
+{
+    int now = clock.elapsed();
+    QHash<QString, TelemetryRelayClient*>::iterator it = datagramClients.begin();
+    while (it != datagramClients.end()) {
+        TelemetryRelayClient *client = it.value();
+        if (now - client->lastSeen() > DATAGRAM_CLIENT_TIMEOUT) {
+            it = datagramClients.erase(it);
+            clients.removeAll(client);
+            client->deleteLater();
+        } else {
+            ++it;
+        }
+    }
+    updateSubscriptions();
+}
+
+void TelemetryRelay::clientDisconnected()
+{
+    TelemetryRelayClient *client = qobject_cast<TelemetryRelayClient*>(sender());
+    if (!client || !clients.removeAll(client))
+        return;
+    client->deleteLater();
+    updateSubscriptions();
+}
+
+/**
+ * Merge the subscriptions of all clients for isSubscribed()
+ */
+void TelemetryRelay::updateSubscriptions()
+{
+    subscribed.clear();
+    subscribedAll = false;
+    foreach (TelemetryRelayClient *client, clients) {
+        subscribedAll |= client->subscribesAll();
+        foreach (quint32 objId, client->subscriptions())
+            subscribed.insert(objId);
+    }
+}
@@ -0,0 +1,149 @@
+/**
+ ******************************************************************************
+ *
+ * @file       telemetryrelay.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVTalkPlugin UAVTalk Plugin
+ * @{
+ * @brief Relays the telemetry link to local clients
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef TELEMETRYRELAY_H
+#define TELEMETRYRELAY_H
+
+#include "uavtalk_global.h"
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QQueue>
+#include <QSet>
+#include <QTime>
+#include <QTimer>
+#include <QtNetwork/QHostAddress>
+
+class QIODevice;
+class QTcpServer;
+class QLocalServer;
+class QUdpSocket;
+
+/**
+ * One subscriber of the relay, either a stream (TCP or local socket) or a
+ * UDP peer. Commands are ASCII lines:
+ *
+ *   SUBSCRIBE <object id|*> [max rate in Hz]
+ *   UNSUBSCRIBE <object id|*>
+ *
+ * The client receives the raw UAVTalk packets of the subscribed objects in
+ * both directions. Packets waiting to be sent are kept in a bounded queue,
+ * when it is full the oldest packet is dropped so a slow client never holds
+ * up the link or the other clients.
+ */
+class TelemetryRelayClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    TelemetryRelayClient(QIODevice *device, QObject *parent);
+    TelemetryRelayClient(QUdpSocket *socket, const QHostAddress &address, quint16 port, QObject *parent);
+
+    bool isSubscribed(quint32 objId) const;
+    bool subscribesAll() const;
+    QList<quint32> subscriptions() const;
+    void relayFrame(quint32 objId, const QByteArray &frame, int time);
+    void processCommands(const QByteArray &commands);
+    int lastSeen() const;
+    void setLastSeen(int time);
+
+signals:
+    void subscriptionsChanged();
+    void disconnected();
+
+private slots:
+    void readCommands();
+    void flush();
+
+private:
+    void processCommand(const QByteArray &line);
+
+    static const int QUEUE_LENGTH = 256;
+    static const int WRITE_BUFFER_SIZE = 8*1024;
+    // Subscription of all objects, overridden by the ones for single objects
+    static const quint32 ALL_OBJECTS = 0;
+
+    QIODevice *device;
+    QUdpSocket *udpSocket;
+    QHostAddress address;
+    quint16 port;
+    // Minimum time between packets of each subscribed object [ms]
+    QHash<quint32, int> minInterval;
+    QHash<quint32, int> lastSent;
+    QQueue<QByteArray> queue;
+    quint32 dropped;
+    int seen;
+};
+
+/**
+ * Serves the telemetry link to local recorders, dashboards and analysis
+ * tools over TCP, UDP and a local socket.
+ *
+ * UAVTalk checks isSubscribed() before building a packet for the relay, so
+ * objects nobody subscribed to cost a set lookup. A packet is a QByteArray
+ * shared by all clients, queueing it for several clients does not copy it.
+ */
+class UAVTALK_EXPORT TelemetryRelay : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const quint16 DEFAULT_PORT = 9000;
+    static const char *LOCAL_SERVER_NAME;
+
+    TelemetryRelay(quint16 port = DEFAULT_PORT, QObject *parent = 0);
+    ~TelemetryRelay();
+
+    bool isSubscribed(quint32 objId) const { return subscribedAll || subscribed.contains(objId); }
+    void relayFrame(quint32 objId, const QByteArray &frame);
+
+private slots:
+    void newTcpConnection();
+    void newLocalConnection();
+    void readDatagrams();
+    void clientDisconnected();
+    void expireDatagramClients();
+    void updateSubscriptions();
+
+private:
+    void addClient(TelemetryRelayClient *client);
+
+    // UDP clients have to send a datagram at least this often [ms]
+    static const int DATAGRAM_CLIENT_TIMEOUT = 10000;
+
+    QTcpServer *tcpServer;
+    QLocalServer *localServer;
+    QUdpSocket *udpSocket;
+    QList<TelemetryRelayClient*> clients;
+    QHash<QString, TelemetryRelayClient*> datagramClients;
+    QSet<quint32> subscribed;
+    bool subscribedAll;
+    QTime clock;
+    QTimer expireTimer;
+};
+
+#endif // TELEMETRYRELAY_H
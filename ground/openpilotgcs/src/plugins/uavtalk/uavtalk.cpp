@@ -25,10 +25,9 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 #include "uavtalk.h"
+#include "telemetryrelay.h"
 #include <QtEndian>
 #include <QDebug>
-#include <extensionsystem/pluginmanager.h>
-#include <coreplugin/generalsettings.h>
 //#define UAVTALK_DEBUG
 #ifdef UAVTALK_DEBUG
   #include "qxtlogger.h"
@@ -75,20 +74,9 @@ UAVTalk::UAVTalk(QIODevice* iodev, UAVObjectManager* objMngr)
 
     memset(&stats, 0, sizeof(ComStats));
 
+    relay = NULL;
+
     connect(io, SIGNAL(readyRead()), this, SLOT(processInputStream()));
-    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
-    Core::Internal::GeneralSettings * settings=pm->getObject<Core::Internal::GeneralSettings>();
-    useUDPMirror=settings->useUDPMirror();
-    qDebug()<<"USE UDP:::::::::::."<<useUDPMirror;
-    if(useUDPMirror)
-    {
-        udpSocketTx=new QUdpSocket(this);
-        udpSocketRx=new QUdpSocket(this);
-        udpSocketTx->bind(9000);
-        udpSocketRx->connectToHost(QHostAddress::LocalHost,9000);
-        connect(udpSocketTx,SIGNAL(readyRead()),this,SLOT(dummyUDPRead()));
-        connect(udpSocketRx,SIGNAL(readyRead()),this,SLOT(dummyUDPRead()));
-    }
 }
 
 UAVTalk::~UAVTalk()
@@ -108,6 +96,15 @@ void UAVTalk::resetStats()
     memset(&stats, 0, sizeof(ComStats));
 }
 
+/**
+ * Pass the received and sent packets to a relay, NULL to stop relaying
+ */
+void UAVTalk::setRelay(TelemetryRelay* relay)
+{
+    QMutexLocker locker(mutex);
+    this->relay = relay;
+}
+
 /**
  * Get the statistics counters
  */
@@ -133,17 +130,6 @@ void UAVTalk::processInputStream()
     }
 }
 
-void UAVTalk::dummyUDPRead()
-{
-    QUdpSocket *socket=qobject_cast<QUdpSocket*>(sender());
-    QByteArray junk;
-    while(socket->hasPendingDatagrams())
-    {
-        junk.resize(socket->pendingDatagramSize());
-        socket->readDatagram(junk.data(),junk.size());
-    }
-}
-
 /**
  * Request an update for the specified object, on success the object data would have been
  * updated by the GCS.
@@ -244,9 +230,6 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
 
     rxPacketLength++;   // update packet byte count
 
-    if(useUDPMirror)
-        rxDataArray.append(rxbyte);
-
     // Receive state machine
     switch (rxState)
     {
@@ -263,12 +246,6 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
 
             rxPacketLength = 1;
 
-            if(useUDPMirror)
-            {
-                rxDataArray.clear();
-                rxDataArray.append(rxbyte);
-            }
-
             rxState = STATE_TYPE;
             UAVTALK_QXTLOG_DEBUG("UAVTalk: Sync->Type");
             break;
@@ -480,9 +457,9 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
 
             mutex->lock();
                 receiveObject(rxType, rxObjId, rxInstId, rxBuffer, rxLength);
-                if(useUDPMirror)
+                if (relay && relay->isSubscribed(rxObjId))
                 {
-                    udpSocketTx->writeDatagram(rxDataArray,QHostAddress::LocalHost,udpSocketRx->localPort());
+                    relay->relayFrame(rxObjId, rxFrame());
                 }
                 stats.rxObjectBytes += rxLength;
                 stats.rxObjects++;
@@ -502,6 +479,26 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
     return true;
 }
 
+/**
+ * Rebuild the packet that was just received from the decoded fields, this
+ * is only done when the relay wants it instead of buffering every byte
+ */
+QByteArray UAVTalk::rxFrame()
+{
+    QByteArray frame(packetSize + CHECKSUM_LENGTH, 0);
+    quint8* data = (quint8*)frame.data();
+    int instanceLength = packetSize - MIN_HEADER_LENGTH - rxLength;
+    data[0] = SYNC_VAL;
+    data[1] = rxType;
+    qToLittleEndian<quint16>(packetSize, &data[2]);
+    qToLittleEndian<quint32>(rxObjId, &data[4]);
+    if (instanceLength == 2)
+        qToLittleEndian<quint16>(rxInstId, &data[MIN_HEADER_LENGTH]);
+    memcpy(&data[MIN_HEADER_LENGTH + instanceLength], rxBuffer, rxLength);
+    data[packetSize] = rxCSPacket;
+    return frame;
+}
+
 /**
  * Receive an object. This function process objects received through the telemetry stream.
  * \param[in] type Type of received message (TYPE_OBJ, TYPE_OBJ_REQ, TYPE_OBJ_ACK, TYPE_ACK, TYPE_NACK)
@@ -779,9 +776,9 @@ bool UAVTalk::transmitNack(quint32 objId)
     if (io && io->isWritable() && io->bytesToWrite() < TX_BUFFER_SIZE )
     {
         io->write((const char*)txBuffer, dataOffset+CHECKSUM_LENGTH);
-        if(useUDPMirror)
+        if (relay && relay->isSubscribed(objId))
         {
-            udpSocketRx->writeDatagram((const char*)txBuffer,dataOffset+CHECKSUM_LENGTH,QHostAddress::LocalHost,udpSocketTx->localPort());
+            relay->relayFrame(objId, QByteArray((const char*)txBuffer, dataOffset+CHECKSUM_LENGTH));
         }
     }
     else
@@ -873,9 +870,9 @@ bool UAVTalk::transmitSingleObject(UAVObject* obj, quint8 type, bool allInstance
     if (!io.isNull() && io->isWritable() && io->bytesToWrite() < TX_BUFFER_SIZE )
     {
         io->write((const char*)txBuffer, dataOffset+length+CHECKSUM_LENGTH);
-        if(useUDPMirror)
+        if (relay && relay->isSubscribed(objId))
         {
-            udpSocketRx->writeDatagram((const char*)txBuffer,dataOffset+length+CHECKSUM_LENGTH,QHostAddress::LocalHost,udpSocketTx->localPort());
+            relay->relayFrame(objId, QByteArray((const char*)txBuffer, dataOffset+length+CHECKSUM_LENGTH));
         }
     }
     else
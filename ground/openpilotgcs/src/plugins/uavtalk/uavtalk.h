@@ -35,7 +35,8 @@
 #include <QSemaphore>
 #include "uavobjectmanager.h"
 #include "uavtalk_global.h"
-#include <QtNetwork/QUdpSocket>
+
+class TelemetryRelay;
 
 class UAVTALK_EXPORT UAVTalk: public QObject
 {
@@ -60,13 +61,13 @@ public:
     void cancelTransaction(UAVObject* obj);
     ComStats getStats();
     void resetStats();
+    void setRelay(TelemetryRelay* relay);
 
 signals:
     void transactionCompleted(UAVObject* obj, bool success);
 
 private slots:
     void processInputStream(void);
-    void dummyUDPRead();
 
 private:
 
@@ -124,14 +125,12 @@ private:
     RxStateType rxState;
     ComStats stats;
 
-    bool useUDPMirror;
-    QUdpSocket * udpSocketTx;
-    QUdpSocket * udpSocketRx;
-    QByteArray rxDataArray;
+    TelemetryRelay* relay;
 
     // Methods
     bool objectTransaction(UAVObject* obj, quint8 type, bool allInstances);
     bool processInputByte(quint8 rxbyte);
+    QByteArray rxFrame();
     bool receiveObject(quint8 type, quint32 objId, quint16 instId, quint8* data, qint32 length);
     UAVObject* updateObject(quint32 objId, quint16 instId, quint8* data);
     void updateAck(UAVObject* obj);
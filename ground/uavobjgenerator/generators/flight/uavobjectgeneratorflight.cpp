@@ -50,10 +50,13 @@ bool UAVObjectGeneratorFlight::generate(UAVObjectParser* parser,QString template
             return false;
         }
 
+    QList<ObjectInfo*> objects = parser->getObjectInfo();
+    QtConcurrent::blockingMap(objects, ObjectGeneratorTask<UAVObjectGeneratorFlight>(this, "flight",
+                              flightCodeTemplate + flightIncludeTemplate));
+
     sizeCalc = 0;
     for (int objidx = 0; objidx < parser->getNumObjects(); ++objidx) {
         ObjectInfo* info=parser->getObjectByIndex(objidx);
-        process_object(info);
         flightObjInit.append("#ifdef UAVOBJ_INIT_" + info->namelc +"\r\n");
         flightObjInit.append("    " + info->name + "Initialize();\r\n");
         flightObjInit.append("#endif\r\n");
@@ -98,6 +101,16 @@ bool UAVObjectGeneratorFlight::generate(UAVObjectParser* parser,QString template
 }
 
 
+/**
+ * The files process_object() writes for an object
+ */
+QStringList UAVObjectGeneratorFlight::object_outputs(ObjectInfo* info)
+{
+    return QStringList()
+        << flightOutputPath.absolutePath() + "/" + info->namelc + ".c"
+        << flightOutputPath.absolutePath() + "/" + info->namelc + ".h";
+}
+
 /**
  * Generate the Flight object files
 **/
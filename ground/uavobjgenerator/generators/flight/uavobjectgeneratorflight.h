@@ -39,7 +39,9 @@ public:
     QDir flightOutputPath;
 
 private:
+    friend class ObjectGeneratorTask<UAVObjectGeneratorFlight>;
     bool process_object(ObjectInfo* info);
+    QStringList object_outputs(ObjectInfo* info);
 
 };
 
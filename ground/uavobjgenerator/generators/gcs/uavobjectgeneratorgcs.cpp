@@ -51,9 +51,12 @@ bool UAVObjectGeneratorGCS::generate(UAVObjectParser* parser,QString templatepat
     QString objInc;
     QString gcsObjInit;
 
+    QList<ObjectInfo*> objects = parser->getObjectInfo();
+    QtConcurrent::blockingMap(objects, ObjectGeneratorTask<UAVObjectGeneratorGCS>(this, "gcs",
+                              gcsCodeTemplate + gcsIncludeTemplate));
+
     for (int objidx = 0; objidx < parser->getNumObjects(); ++objidx) {
         ObjectInfo* info=parser->getObjectByIndex(objidx);
-        process_object(info);
 
         gcsObjInit.append("    objMngr->registerObject( new " + info->name + "() );\n");
         objInc.append("#include \"" + info->namelc + ".h\"\n");
@@ -71,6 +74,16 @@ bool UAVObjectGeneratorGCS::generate(UAVObjectParser* parser,QString templatepat
     return true; // if we come here everything should be fine
 }
 
+/**
+ * The files process_object() writes for an object
+ */
+QStringList UAVObjectGeneratorGCS::object_outputs(ObjectInfo* info)
+{
+    return QStringList()
+        << gcsOutputPath.absolutePath() + "/" + info->namelc + ".cpp"
+        << gcsOutputPath.absolutePath() + "/" + info->namelc + ".h";
+}
+
 /**
  * Generate the GCS object files
  */
@@ -149,6 +162,7 @@ bool UAVObjectGeneratorGCS::process_object(ObjectInfo* info)
                             "   mutex->lock();\n"
                             "   bool changed = data.%2[index] != value;\n"
                             "   data.%2[index] = value;\n"
+                            "   notifiedData.%2[index] = value;\n"
                             "   mutex->unlock();\n"
                             "   if (changed) emit %2Changed(index,value);\n"
                             "}\n\n")
@@ -156,6 +170,11 @@ bool UAVObjectGeneratorGCS::process_object(ObjectInfo* info)
             propertyNotifications +=
                     QString("    void %1Changed(quint32 index, %2 value);\n")
                     .arg(field->name).arg(type);
+            propertyNotificationsImpl +=
+                    QString("    for (quint32 n = 0; n < %2; ++n)\n"
+                            "        if (current.%1[n] != previous.%1[n])\n"
+                            "            emit %1Changed(n, current.%1[n]);\n")
+                    .arg(field->name).arg(field->numElements);
         } else {
             properties += QString("    Q_PROPERTY(%1 %2 READ get%2 WRITE set%2 NOTIFY %2Changed);\n")
                     .arg(type).arg(field->name);
@@ -178,6 +197,7 @@ bool UAVObjectGeneratorGCS::process_object(ObjectInfo* info)
                             "   mutex->lock();\n"
                             "   bool changed = data.%2 != value;\n"
                             "   data.%2 = value;\n"
+                            "   notifiedData.%2 = value;\n"
                             "   mutex->unlock();\n"
                             "   if (changed) emit %2Changed(value);\n"
                             "}\n\n")
@@ -186,8 +206,8 @@ bool UAVObjectGeneratorGCS::process_object(ObjectInfo* info)
                     QString("    void %1Changed(%2 value);\n")
                     .arg(field->name).arg(type);
             propertyNotificationsImpl +=
-                    QString("        //if (data.%1 != oldData.%1)\n"
-                            "            emit %1Changed(data.%1);\n")
+                    QString("    if (current.%1 != previous.%1)\n"
+                            "        emit %1Changed(current.%1);\n")
                     .arg(field->name);
         }
     }
@@ -224,7 +244,7 @@ bool UAVObjectGeneratorGCS::process_object(ObjectInfo* info)
                               .arg(varOptionName)
                               .arg(options[m]) );
             }
-            finit.append( QString("    fields.append( new UAVObjectField(QString(\"%1\"), QString(\"%2\"), UAVObjectField::ENUM, %3, %4, QString(\"%5\")));\n")
+            finit.append( QString("    descriptors.append( UAVObjectField::createDescriptor(QString(\"%1\"), QString(\"%2\"), UAVObjectField::ENUM, %3, %4, QString(\"%5\")));\n")
                           .arg(info->fields[n]->name)
                           .arg(info->fields[n]->units)
                           .arg(varElemName)
@@ -233,7 +253,7 @@ bool UAVObjectGeneratorGCS::process_object(ObjectInfo* info)
         }
         // For all other types
         else {
-            finit.append( QString("    fields.append( new UAVObjectField(QString(\"%1\"), QString(\"%2\"), UAVObjectField::%3, %4, QStringList(), QString(\"%5\")));\n")
+            finit.append( QString("    descriptors.append( UAVObjectField::createDescriptor(QString(\"%1\"), QString(\"%2\"), UAVObjectField::%3, %4, QStringList(), QString(\"%5\")));\n")
                           .arg(info->fields[n]->name)
                           .arg(info->fields[n]->units)
                           .arg(fieldTypeStrCPPClass[info->fields[n]->type])
@@ -37,7 +37,9 @@ public:
     bool generate(UAVObjectParser* gen,QString templatepath,QString outputpath);
 
 private:
+    friend class ObjectGeneratorTask<UAVObjectGeneratorGCS>;
     bool process_object(ObjectInfo* info);
+    QStringList object_outputs(ObjectInfo* info);
 
     QString gcsCodeTemplate,gcsIncludeTemplate;
     QStringList fieldTypeStrCPP,fieldTypeStrCPPClass;
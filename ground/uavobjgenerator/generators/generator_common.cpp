@@ -24,6 +24,9 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 #include "generator_common.h"
+#include <QCryptographicHash>
+#include <QHash>
+#include <QMutex>
 
 void replaceCommonTags(QString& out) 
 {
@@ -125,3 +128,99 @@ QString boolToTRUEFALSEString(bool value)
     return QString("FALSE");
 }
 
+
+/**
+ * Hashes of the last generated version of every object, keyed by language and
+ * object name. Shared by the generator threads.
+ */
+static QHash<QString, QByteArray> generatorCache;
+static QMutex generatorCacheLock;
+static QString generatorCacheName;
+static QByteArray generatorCacheSalt;
+
+/**
+ * Load the hashes written by the last run. The cache is dropped if salt (a
+ * hash of the generator binary) differs, as different generator code
+ * produces different output, or if force is set.
+ */
+bool loadGeneratorCache(QString name, QByteArray salt, bool force)
+{
+    generatorCacheName = name;
+    generatorCacheSalt = salt.toHex();
+    generatorCache.clear();
+
+    if (force)
+        return false;
+
+    QFile file(name);
+    if (!file.open(QFile::ReadOnly | QFile::Text))
+        return false;
+
+    if (file.readLine().trimmed() != generatorCacheSalt)
+        return false;
+
+    while (!file.atEnd()) {
+        QList<QByteArray> entry = file.readLine().trimmed().split(' ');
+        if (entry.length() == 2)
+            generatorCache.insert(QString(entry[0]), entry[1]);
+    }
+    return true;
+}
+
+/**
+ * Write the hashes back for the next run
+ */
+bool saveGeneratorCache()
+{
+    if (generatorCacheName.isEmpty())
+        return true;
+
+    QFile file(generatorCacheName);
+    if (!file.open(QFile::WriteOnly | QFile::Text))
+        return false;
+
+    file.write(generatorCacheSalt + "\n");
+    QHash<QString, QByteArray>::const_iterator it;
+    for (it = generatorCache.constBegin(); it != generatorCache.constEnd(); ++it)
+        file.write(it.key().toAscii() + " " + it.value() + "\n");
+    return true;
+}
+
+/**
+ * Hash everything the generated code of an object depends on
+ */
+QByteArray objectHash(ObjectInfo* info, const QString& language, const QString& templates)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(info->hash);
+    hash.addData(language.toUtf8());
+    hash.addData(templates.toUtf8());
+    return hash.result().toHex();
+}
+
+/**
+ * Check if the generated code of an object is up to date, the output files
+ * may have been removed without the cache
+ */
+bool isObjectCurrent(ObjectInfo* info, const QString& language, const QByteArray& hash, const QStringList& outputs)
+{
+    {
+        QMutexLocker locker(&generatorCacheLock);
+        if (generatorCache.value(language + "/" + info->namelc) != hash)
+            return false;
+    }
+    foreach (const QString& output, outputs) {
+        if (!QFile::exists(output))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Record that the generated code of an object is up to date
+ */
+void setObjectCurrent(ObjectInfo* info, const QString& language, const QByteArray& hash)
+{
+    QMutexLocker locker(&generatorCacheLock);
+    generatorCache.insert(language + "/" + info->namelc, hash);
+}
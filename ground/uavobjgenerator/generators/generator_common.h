@@ -29,6 +29,7 @@
 
 #include "../uavobjectparser.h"
 #include "generator_io.h"
+#include <QtConcurrentMap>
 
 // These special chars (regexp) will be removed from C/java identifiers
 #define ENUM_SPECIAL_CHARS "[\\.\\-\\s\\+/\\(\\)]"
@@ -38,4 +39,42 @@ void replaceCommonTags(QString& out);
 QString boolTo01String(bool value);
 QString boolToTRUEFALSEString(bool value);
 
+// Incremental generation, see generator_common.cpp
+bool loadGeneratorCache(QString name, QByteArray salt, bool force);
+bool saveGeneratorCache();
+QByteArray objectHash(ObjectInfo* info, const QString& language, const QString& templates);
+bool isObjectCurrent(ObjectInfo* info, const QString& language, const QByteArray& hash, const QStringList& outputs);
+void setObjectCurrent(ObjectInfo* info, const QString& language, const QByteArray& hash);
+
+/**
+ * Runs Generator::process_object() for one object, unless the object, the
+ * templates and the generator itself are unchanged since the last run and
+ * the files listed by Generator::object_outputs() still exist.
+ * Used with QtConcurrent::blockingMap() to generate all objects on all cores,
+ * so process_object() must not modify the generator.
+ */
+template <class Generator>
+class ObjectGeneratorTask
+{
+public:
+    typedef void result_type;
+
+    ObjectGeneratorTask(Generator* generator, QString language, QString templates) :
+        generator(generator), language(language), templates(templates) {}
+
+    void operator()(ObjectInfo* info)
+    {
+        QByteArray hash = objectHash(info, language, templates);
+        if (isObjectCurrent(info, language, hash, generator->object_outputs(info)))
+            return;
+        if (generator->process_object(info))
+            setObjectCurrent(info, language, hash);
+    }
+
+private:
+    Generator* generator;
+    QString language;
+    QString templates;
+};
+
 #endif
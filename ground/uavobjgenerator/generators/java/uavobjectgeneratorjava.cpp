@@ -50,9 +50,12 @@ bool UAVObjectGeneratorJava::generate(UAVObjectParser* parser,QString templatepa
     QString objInc;
     QString javaObjInit;
 
+    QList<ObjectInfo*> objects = parser->getObjectInfo();
+    QtConcurrent::blockingMap(objects, ObjectGeneratorTask<UAVObjectGeneratorJava>(this, "java",
+                              javaCodeTemplate + javaIncludeTemplate));
+
     for (int objidx = 0; objidx < parser->getNumObjects(); ++objidx) {
         ObjectInfo* info=parser->getObjectByIndex(objidx);
-        process_object(info);
 
         javaObjInit.append("\t\t\tobjMngr.registerObject( new " + info->name + "() );\n");
         objInc.append("#include \"" + info->namelc + ".h\"\n");
@@ -71,6 +74,14 @@ bool UAVObjectGeneratorJava::generate(UAVObjectParser* parser,QString templatepa
 }
 
 
+/**
+ * The files process_object() writes for an object
+ */
+QStringList UAVObjectGeneratorJava::object_outputs(ObjectInfo* info)
+{
+    return QStringList() << javaOutputPath.absolutePath() + "/" + info->name + ".java";
+}
+
 /**
  * Generate the java object files
  */
@@ -38,7 +38,9 @@ public:
     bool generate(UAVObjectParser* gen,QString templatepath,QString outputpath);
 
 private:
+    friend class ObjectGeneratorTask<UAVObjectGeneratorJava>;
     bool process_object(ObjectInfo* info);
+    QStringList object_outputs(ObjectInfo* info);
 
     QString javaCodeTemplate, javaIncludeTemplate;
     QStringList fieldTypeStrCPP,fieldTypeStrCPPClass;
@@ -39,14 +39,21 @@ bool UAVObjectGeneratorPython::generate(UAVObjectParser* parser,QString template
     }
 
     // Process each object
-    for (int objidx = 0; objidx < parser->getNumObjects(); ++objidx) {
-        ObjectInfo* info=parser->getObjectByIndex(objidx);
-        process_object(info);
-    }
+    QList<ObjectInfo*> objects = parser->getObjectInfo();
+    QtConcurrent::blockingMap(objects, ObjectGeneratorTask<UAVObjectGeneratorPython>(this, "python",
+                              pythonCodeTemplate));
 
     return true; // if we come here everything should be fine
 }
 
+/**
+ * The files process_object() writes for an object
+ */
+QStringList UAVObjectGeneratorPython::object_outputs(ObjectInfo* info)
+{
+    return QStringList() << pythonOutputPath.absolutePath() + "/" + info->namelc + ".py";
+}
+
 /**
  * Generate the python object files
  */
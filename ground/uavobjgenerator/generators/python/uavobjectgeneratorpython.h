@@ -35,7 +35,9 @@ public:
     bool generate(UAVObjectParser* gen,QString templatepath,QString outputpath);
 
 private:
+    friend class ObjectGeneratorTask<UAVObjectGeneratorPython>;
     bool process_object(ObjectInfo* info);
+    QStringList object_outputs(ObjectInfo* info);
 
     QString pythonCodeTemplate;
     QDir pythonCodePath;
@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavobjectgeneratorshm.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      produce the header describing the GCS shared memory export
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "uavobjectgeneratorshm.h"
+#include <QPair>
+#include <QtAlgorithms>
+
+using namespace std;
+
+static bool objectIdLessThan(const QPair<quint32, int>& a, const QPair<quint32, int>& b)
+{
+    return a.first < b.first;
+}
+
+bool UAVObjectGeneratorShm::generate(UAVObjectParser* parser,QString templatepath,QString outputpath) {
+
+    fieldTypeStrC << "int8_t" << "int16_t" << "int32_t" <<"uint8_t"
+            <<"uint16_t" << "uint32_t" << "float" << "uint8_t";
+
+    QDir shmTemplatePath = QDir( templatepath + QString("ground/openpilotgcs/src/plugins/uavobjects"));
+    QDir shmOutputPath = QDir( outputpath + QString("shm") );
+    shmOutputPath.mkpath(shmOutputPath.absolutePath());
+
+    QString shmTemplate = readFile( shmTemplatePath.absoluteFilePath("uavobjectsshmtemplate.h") );
+
+    if (shmTemplate.isEmpty()) {
+        cerr << "Error: Could not open shared memory template file." << endl;
+        return false;
+    }
+
+    // The GCS lays out the slots in the order of the object IDs
+    QList< QPair<quint32, int> > order;
+    for (int objidx = 0; objidx < parser->getNumObjects(); ++objidx)
+        order.append(qMakePair(parser->getObjectID(objidx), objidx));
+    qSort(order.begin(), order.end(), objectIdLessThan);
+
+    QString objectDefs;
+    for (int n = 0; n < order.length(); ++n) {
+        int objidx = order[n].second;
+        objectDefs.append(process_object(parser->getObjectByIndex(objidx), parser->getNumBytes(objidx), n));
+    }
+
+    shmTemplate.replace(QString("$(OBJECTDEFS)"), objectDefs);
+
+    bool res = writeFileIfDiffrent( shmOutputPath.absolutePath() + "/uavobjectsshm.h", shmTemplate );
+    if (!res) {
+        cout << "Error: Could not write shared memory header" << endl;
+        return false;
+    }
+
+    return true; // if we come here everything should be fine
+}
+
+/**
+ * Generate the definitions of one object
+ */
+QString UAVObjectGeneratorShm::process_object(ObjectInfo* info, int numBytes, int index)
+{
+    QString nameuc = info->name.toUpper();
+    QString out;
+
+    out.append(QString("\r\n/* %1 */\r\n").arg(info->name));
+    out.append(QString("#define %1_OBJID 0x%2\r\n").arg(nameuc).arg(QString().setNum(info->id, 16).toUpper()));
+    out.append(QString("#define %1_NUMBYTES %2\r\n").arg(nameuc).arg(numBytes));
+    out.append(QString("#define %1_SHMINDEX %2\r\n").arg(nameuc).arg(index));
+
+    out.append("typedef struct {\r\n");
+    for (int n = 0; n < info->fields.length(); ++n) {
+        QString type = fieldTypeStrC[info->fields[n]->type];
+        if ( info->fields[n]->numElements > 1 )
+        {
+            out.append( QString("    %1 %2[%3];\r\n").arg(type)
+                        .arg(info->fields[n]->name).arg(info->fields[n]->numElements) );
+        }
+        else
+        {
+            out.append( QString("    %1 %2;\r\n").arg(type).arg(info->fields[n]->name) );
+        }
+    }
+    out.append(QString("} %1Data;\r\n").arg(info->name));
+
+    return out;
+}
@@ -71,7 +71,7 @@ bool UAVObjectGeneratorWireshark::generate(UAVObjectParser* parser,QString templ
     }
 
     /* Copy static files for op-uavobjects dissector into output directory */
-    QDir uavobjectsOutputPath = QDir( outputpath + QString("wireshark/op-uavobjects") );
+    uavobjectsOutputPath = QDir( outputpath + QString("wireshark/op-uavobjects") );
     uavobjectsOutputPath.mkpath(uavobjectsOutputPath.absolutePath());
     QStringList uavostaticfiles;
     uavostaticfiles << "AUTHORS" << "COPYING" << "ChangeLog";
@@ -85,9 +85,11 @@ bool UAVObjectGeneratorWireshark::generate(UAVObjectParser* parser,QString templ
 
     /* Generate the per-object files from the templates, and keep track of the list of generated filenames */
     QString objFileNames;
+    QList<ObjectInfo*> objects = parser->getObjectInfo();
+    QtConcurrent::blockingMap(objects, ObjectGeneratorTask<UAVObjectGeneratorWireshark>(this, "wireshark",
+                              wiresharkCodeTemplate));
     for (int objidx = 0; objidx < parser->getNumObjects(); ++objidx) {
       ObjectInfo* info = parser->getObjectByIndex(objidx);
-      process_object(info, uavobjectsOutputPath);
       objFileNames.append(" packet-op-uavobjects-" + info->namelc + ".c");
     }
 
@@ -104,10 +106,18 @@ bool UAVObjectGeneratorWireshark::generate(UAVObjectParser* parser,QString templ
 }
 
 
+/**
+ * The files process_object() writes for an object
+ */
+QStringList UAVObjectGeneratorWireshark::object_outputs(ObjectInfo* info)
+{
+    return QStringList() << uavobjectsOutputPath.absolutePath() + "/packet-op-uavobjects-" + info->namelc + ".c";
+}
+
 /**
  * Generate the Flight object files
 **/
-bool UAVObjectGeneratorWireshark::process_object(ObjectInfo* info, QDir outputpath)
+bool UAVObjectGeneratorWireshark::process_object(ObjectInfo* info)
 {
     if (info == NULL)
         return false;
@@ -278,7 +288,7 @@ bool UAVObjectGeneratorWireshark::process_object(ObjectInfo* info, QDir outputpa
     outCode.replace(QString("$(HEADERFIELDS)"), headerfields);
 
     // Write the flight code
-    bool res = writeFileIfDiffrent( outputpath.absolutePath() + "/packet-op-uavobjects-" + info->namelc + ".c", outCode );
+    bool res = writeFileIfDiffrent( uavobjectsOutputPath.absolutePath() + "/packet-op-uavobjects-" + info->namelc + ".c", outCode );
     if (!res) {
         cout << "Error: Could not write wireshark code files" << endl;
         return false;
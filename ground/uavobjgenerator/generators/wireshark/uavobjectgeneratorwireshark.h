@@ -38,9 +38,12 @@ public:
     QString wiresharkCodeTemplate, wiresharkMakeTemplate;
     QDir wiresharkCodePath;
     QDir wiresharkOutputPath;
+    QDir uavobjectsOutputPath;
 
 private:
-    bool process_object(ObjectInfo* info, QDir outputpath);
+    friend class ObjectGeneratorTask<UAVObjectGeneratorWireshark>;
+    bool process_object(ObjectInfo* info);
+    QStringList object_outputs(ObjectInfo* info);
 
 };
 
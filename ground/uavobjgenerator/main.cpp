@@ -27,6 +27,8 @@
 #include <QFile>
 #include <QString>
 #include <QStringList>
+#include <QCryptographicHash>
+#include <QtConcurrentMap>
 #include <iostream>
 
 #include "generators/java/uavobjectgeneratorjava.h"
@@ -35,6 +37,7 @@
 #include "generators/matlab/uavobjectgeneratormatlab.h"
 #include "generators/python/uavobjectgeneratorpython.h"
 #include "generators/wireshark/uavobjectgeneratorwireshark.h"
+#include "generators/shm/uavobjectgeneratorshm.h"
 
 #define RETURN_ERR_USAGE 1
 #define RETURN_ERR_XML 2
@@ -46,7 +49,7 @@ using namespace std;
  * print usage info
  */
 void usage() {
-    cout << "Usage: uavobjectgenerator [-gcs] [-flight] [-java] [-python] [-matlab] [-wireshark] [-none] [-v] xml_path template_base [UAVObj1] ... [UAVObjN]" << endl;
+    cout << "Usage: uavobjectgenerator [-gcs] [-flight] [-java] [-python] [-matlab] [-wireshark] [-shm] [-none] [-v] xml_path template_base [UAVObj1] ... [UAVObjN]" << endl;
     cout << "Languages: "<< endl;
     cout << "\t-gcs           build groundstation code" << endl;
     cout << "\t-flight        build flight code" << endl;
@@ -54,9 +57,11 @@ void usage() {
     cout << "\t-python        build python code" << endl;
     cout << "\t-matlab        build matlab code" << endl;
     cout << "\t-wireshark     build wireshark plugin" << endl;
+    cout << "\t-shm           build the GCS shared memory export header" << endl;
     cout << "\tIf no language is specified ( and not -none ) -> all are built." << endl;
     cout << "Misc: "<< endl;
     cout << "\t-none          build no language - just parse xml's" << endl;
+    cout << "\t-f             regenerate all objects, ignoring the cache of the last run" << endl;
     cout << "\t-h             this help" << endl;
     cout << "\t-v             verbose" << endl;
     cout << "\tinput_path     path to UAVObject definition (.xml) files." << endl;
@@ -66,6 +71,31 @@ void usage() {
     cout << "\tIf no UAVObject is specified -> all are built." << endl;
 }
 
+/**
+ * Parses one XML file into a parser of its own, so that all files can be
+ * parsed in parallel and merged afterwards
+ */
+struct ParseResult {
+    UAVObjectParser* parser;
+    QString error;
+};
+
+struct ParseXMLFile
+{
+    typedef ParseResult result_type;
+
+    ParseResult operator()(const QFileInfo& fileinfo)
+    {
+        ParseResult result;
+        QString filename = fileinfo.fileName();
+        QString xmlstr = readFile(fileinfo.absoluteFilePath());
+
+        result.parser = new UAVObjectParser();
+        result.error = result.parser->parseXML(xmlstr, filename);
+        return result;
+    }
+};
+
 /**
  * inform user of invalid usage
  */
@@ -106,9 +136,11 @@ int main(int argc, char *argv[])
     bool do_python=(arguments_stringlist.removeAll("-python")>0);
     bool do_matlab=(arguments_stringlist.removeAll("-matlab")>0);
     bool do_wireshark=(arguments_stringlist.removeAll("-wireshark")>0);
+    bool do_shm=(arguments_stringlist.removeAll("-shm")>0);
     bool do_none=(arguments_stringlist.removeAll("-none")>0); //
+    bool do_force=(arguments_stringlist.removeAll("-f")>0);
 
-    bool do_all=((do_gcs||do_flight||do_java||do_python||do_matlab)==false);
+    bool do_all=((do_gcs||do_flight||do_java||do_python||do_matlab||do_wireshark||do_shm)==false);
     bool do_allObjects=true;
 
     if (arguments_stringlist.length() >= 2) {
@@ -143,7 +175,7 @@ int main(int argc, char *argv[])
     QFileInfoList xmlList = xmlPath.entryInfoList();
 
     // Read in each XML file and parse object(s) in them
-    
+    QFileInfoList parseList;
     for (int n = 0; n < xmlList.length(); ++n) {
         QFileInfo fileinfo = xmlList[n];
         if (!do_allObjects) {
@@ -153,12 +185,18 @@ int main(int argc, char *argv[])
                continue;
             }
         }
+        parseList << fileinfo;
+    }
+
+    // The files are independent, parse them on all cores and merge the results in file order
+    QList<ParseResult> parsed = QtConcurrent::blockingMapped<QList<ParseResult> >(parseList, ParseXMLFile());
+
+    for (int n = 0; n < parsed.length(); ++n) {
+        QFileInfo fileinfo = parseList[n];
         if (verbose)
           cout << "Parsing XML file: " << fileinfo.fileName().toStdString() << endl;
-        QString filename = fileinfo.fileName();
-        QString xmlstr = readFile(fileinfo.absoluteFilePath());
 
-        QString res = parser->parseXML(xmlstr, filename);
+        QString res = parsed[n].error;
 
         if (!res.isNull()) {
 	    if (!verbose) {
@@ -167,6 +205,9 @@ int main(int argc, char *argv[])
             cout << "Error parsing " << res.toStdString() << endl;
             return RETURN_ERR_XML;
         }
+
+        parser->addObjects(parsed[n].parser);
+        delete parsed[n].parser;
     }
 
     if (objects_stringlist.length() > 0) {
@@ -201,6 +242,25 @@ int main(int argc, char *argv[])
     if (do_none)
       return RETURN_OK;     
 
+    // Objects are only regenerated if their definition, the templates or
+    // this generator changed since the last run. The Makefile runs one
+    // generator per language in parallel, so each language set gets its own cache.
+    QFile generatorBinary(QCoreApplication::applicationFilePath());
+    generatorBinary.open(QFile::ReadOnly);
+    QByteArray generatorHash = QCryptographicHash::hash(generatorBinary.readAll(), QCryptographicHash::Md5);
+    generatorBinary.close();
+    QString cachename("uavobjgenerator");
+    if (!do_all) {
+        if (do_flight) cachename.append("-flight");
+        if (do_gcs) cachename.append("-gcs");
+        if (do_java) cachename.append("-java");
+        if (do_python) cachename.append("-python");
+        if (do_matlab) cachename.append("-matlab");
+        if (do_wireshark) cachename.append("-wireshark");
+        if (do_shm) cachename.append("-shm");
+    }
+    loadGeneratorCache(outputpath + cachename + ".cache", generatorHash, do_force);
+
     // generate flight code if wanted
     if (do_flight|do_all) {
         cout << "generating flight code" << endl ;
@@ -243,6 +303,16 @@ int main(int argc, char *argv[])
         wiresharkgen.generate(parser,templatepath,outputpath);
     }
 
+    // generate the shared memory export header if wanted
+    if (do_shm|do_all) {
+        cout << "generating shared memory header" << endl ;
+        UAVObjectGeneratorShm shmgen;
+        shmgen.generate(parser,templatepath,outputpath);
+    }
+
+    if (!saveGeneratorCache())
+        cout << "Warning: Could not write the generator cache" << endl;
+
     return RETURN_OK;
 }
 
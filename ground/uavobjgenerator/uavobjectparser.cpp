@@ -25,6 +25,7 @@
  */
 
 #include "uavobjectparser.h"
+#include <QCryptographicHash>
 
 /**
  * Constructor
@@ -111,6 +112,18 @@ int UAVObjectParser::getNumBytes(int objIndex)
     }
 }
 
+/**
+ * Take over the objects of another parser, used to merge the results of
+ * parsing several XML files in parallel
+ */
+void UAVObjectParser::addObjects(UAVObjectParser* parser)
+{
+    objInfo.append(parser->objInfo);
+    parser->objInfo.clear();
+    all_units.append(parser->all_units);
+    all_units.removeDuplicates();
+}
+
 bool fieldTypeLessThan(const FieldInfo* f1, const FieldInfo* f2)
 {
     return f1->numBytes > f2->numBytes;
@@ -129,6 +142,8 @@ QString UAVObjectParser::parseXML(QString& xml, QString& filename)
     bool parsed = doc.setContent(xml);
     if (!parsed) return QString("Improperly formated XML file");
 
+    QByteArray hash = QCryptographicHash::hash(xml.toUtf8(), QCryptographicHash::Md5);
+
     // Read all objects contained in the XML file, creating an new ObjectInfo for each
     QDomElement docElement = doc.documentElement();
     QDomNode node = docElement.firstChild();
@@ -137,6 +152,7 @@ QString UAVObjectParser::parseXML(QString& xml, QString& filename)
         ObjectInfo* info = new ObjectInfo;
 
         info->filename=filename;
+        info->hash=hash;
         // Process object attributes
         QString status = processObjectAttributes(node, info);
         if (!status.isNull())
@@ -97,6 +97,7 @@ typedef struct  {
     QList<FieldInfo*> fields; /** The data fields for the object **/
     QString description; /** Description used for Doxygen **/
     QString category; /** Description used for Doxygen **/
+    QByteArray hash; /** Hash of the xml definition, used for incremental generation **/
 } ObjectInfo;
 
 class UAVObjectParser
@@ -106,6 +107,7 @@ public:
     // Functions
     UAVObjectParser();
     QString parseXML(QString& xml, QString& filename);
+    void addObjects(UAVObjectParser* parser);
     int getNumObjects();
     QList<ObjectInfo*> getObjectInfo();
     QString getObjectName(int objIndex);
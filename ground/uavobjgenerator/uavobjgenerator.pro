@@ -16,6 +16,7 @@ SOURCES += main.cpp \
     generators/matlab/uavobjectgeneratormatlab.cpp \
     generators/python/uavobjectgeneratorpython.cpp \
     generators/wireshark/uavobjectgeneratorwireshark.cpp \
+    generators/shm/uavobjectgeneratorshm.cpp \
     generators/generator_common.cpp
 HEADERS += uavobjectparser.h \
     generators/generator_io.h \
@@ -24,4 +25,5 @@ HEADERS += uavobjectparser.h \
     generators/matlab/uavobjectgeneratormatlab.h \
     generators/python/uavobjectgeneratorpython.h \
     generators/wireshark/uavobjectgeneratorwireshark.h \
+    generators/shm/uavobjectgeneratorshm.h \
     generators/generator_common.h